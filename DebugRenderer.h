@@ -5,14 +5,19 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
+#include "ShaderProgram.h"
+
 #include <vector>
 
+class ShaderCache;
+
 class DebugRenderer {
 public:
     DebugRenderer();
     ~DebugRenderer();
 
-    void init();
+    //programul e cerut din cache; se poate desena dupa shaders.finish()
+    void init(ShaderCache& shaders);
     void cleanup();
 
     void drawFloorBoundary(const std::vector<glm::vec2>& polygon, float y,
@@ -43,8 +48,18 @@ private:
     GLuint vao;
     GLuint vbo;
     GLuint shaderProgram;
+    //reflectat la primul desen, dupa ce ShaderCache::finish a legat programul
+    ShaderProgram program;
+    Uniform<glm::mat4> projectionUniform;
+    Uniform<glm::mat4> viewUniform;
+    Uniform<glm::mat4> modelUniform;
+    Uniform<glm::vec3> colorUniform;
+    Uniform<float> alphaUniform;
 
-    void createShader();
+    void createShader(ShaderCache& shaders);
+    //urca varfurile (xyz) si le deseneaza cu programul de debug
+    void submit(const std::vector<float>& vertices, GLenum mode, const glm::mat4& projection,
+                const glm::mat4& view, const glm::vec3& color, float alpha, float lineWidth);
 };
 
 #endif
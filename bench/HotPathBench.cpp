@@ -0,0 +1,338 @@
+//microbenchmark-uri pentru functiile fierbinti ale proiectului, fara OpenGL:
+//coliziunile din bucla de fizica, parsarea OBJ, stbi_load pe texturile scenei si
+//construirea varfurilor pentru DebugRenderer
+//fiecare caz: calibrare (un esantion dureaza cel putin --min-sample-ms), incalzire, apoi
+//esantioane repetate; se raporteaza mediana si MAD (deviatia absoluta mediana) pe operatie
+//rulare din radacina proiectului:
+//  hot_path_bench [--out hot_path_bench.json] [--baseline old.json] [--filter text] [--samples N]
+//rezultatele sunt JSON, un caz pe linie, ca sa poata fi comparate intre commit-uri (--baseline)
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+#include "Collision.h"
+#include "DebugGeometry.h"
+#include "MeshData.h"
+#include "ObjParser.h"
+#include "Scene.h"
+#include "SceneCompiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct BenchOptions {
+    std::string outPath = "hot_path_bench.json";
+    std::string baselinePath;
+    std::string filter;
+    int samples = 31;
+    int warmupSamples = 5;
+    double minSampleMs = 5.0;
+};
+
+struct BenchResult {
+    std::string name;
+    uint64_t batch;         //operatii pe esantion
+    int samples;
+    double medianNs;        //pe operatie
+    double madNs;
+    double minNs;
+};
+
+//rezultatele trec prin sink ca optimizatorul sa nu elimine apelurile
+volatile uint64_t sink = 0;
+
+double median(std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    size_t n = values.size();
+    return n % 2 ? values[n / 2] : 0.5 * (values[n / 2 - 1] + values[n / 2]);
+}
+
+//op ruleaza o operatie; intoarce ceva derivat din rezultat
+class BenchRunner {
+public:
+    explicit BenchRunner(const BenchOptions& options) : options(options) {}
+
+    void run(const std::string& name, const std::function<uint64_t()>& op) {
+        if (!options.filter.empty() && name.find(options.filter) == std::string::npos) return;
+        //batch-ul creste pana cand un esantion e destul de lung pentru ceas
+        uint64_t batch = 1;
+        while (sampleMs(op, batch) < options.minSampleMs && batch < (1ull << 30)) batch *= 2;
+        for (int i = 0; i < options.warmupSamples; i++) sampleMs(op, batch);
+
+        std::vector<double> perOp;
+        for (int i = 0; i < options.samples; i++) {
+            perOp.push_back(sampleMs(op, batch) * 1.0e6 / (double)batch);
+        }
+        BenchResult result;
+        result.name = name;
+        result.batch = batch;
+        result.samples = options.samples;
+        result.medianNs = median(perOp);
+        std::vector<double> deviations;
+        for (double t : perOp) deviations.push_back(std::fabs(t - result.medianNs));
+        result.madNs = median(deviations);
+        result.minNs = *std::min_element(perOp.begin(), perOp.end());
+        results.push_back(result);
+
+        std::printf("%-56s %14.1f ns  +- %10.1f ns (MAD %5.1f%%)  x%llu\n", name.c_str(), result.medianNs,
+                    result.madNs, result.medianNs > 0.0 ? 100.0 * result.madNs / result.medianNs : 0.0,
+                    (unsigned long long)batch);
+    }
+
+    const std::vector<BenchResult>& all() const { return results; }
+
+private:
+    double sampleMs(const std::function<uint64_t()>& op, uint64_t batch) {
+        uint64_t acc = 0;
+        Clock::time_point start = Clock::now();
+        for (uint64_t i = 0; i < batch; i++) acc += op();
+        double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        sink = sink + acc;
+        return ms;
+    }
+
+    const BenchOptions& options;
+    std::vector<BenchResult> results;
+};
+
+bool parseArgs(int argc, char** argv, BenchOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--out" && hasValue) options.outPath = argv[++i];
+        else if (arg == "--baseline" && hasValue) options.baselinePath = argv[++i];
+        else if (arg == "--filter" && hasValue) options.filter = argv[++i];
+        else if (arg == "--samples" && hasValue) options.samples = std::max(3, std::atoi(argv[++i]));
+        else if (arg == "--min-sample-ms" && hasValue) options.minSampleMs = std::atof(argv[++i]);
+        else {
+            std::cerr << "Unknown argument: " << arg << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+bool writeResults(const std::string& path, const std::vector<BenchResult>& results) {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "Cannot write benchmark results: " << path << "\n";
+        return false;
+    }
+    out << "{\"benchmarks\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& r = results[i];
+        out << "  {\"name\": \"" << r.name << "\", \"median_ns\": " << r.medianNs << ", \"mad_ns\": " << r.madNs
+            << ", \"min_ns\": " << r.minNs << ", \"samples\": " << r.samples << ", \"batch\": " << r.batch << "}"
+            << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "]}\n";
+    return true;
+}
+
+//citeste doar fisierele scrise de writeResults (un caz pe linie)
+std::map<std::string, BenchResult> readResults(const std::string& path) {
+    std::map<std::string, BenchResult> results;
+    std::ifstream in(path);
+    std::string line;
+    while (std::getline(in, line)) {
+        size_t nameStart = line.find("\"name\": \"");
+        if (nameStart == std::string::npos) continue;
+        nameStart += 9;
+        size_t nameEnd = line.find('"', nameStart);
+        BenchResult r = {};
+        r.name = line.substr(nameStart, nameEnd - nameStart);
+        size_t median = line.find("\"median_ns\": ");
+        size_t mad = line.find("\"mad_ns\": ");
+        if (median == std::string::npos || mad == std::string::npos) continue;
+        r.medianNs = std::atof(line.c_str() + median + 13);
+        r.madNs = std::atof(line.c_str() + mad + 10);
+        results[r.name] = r;
+    }
+    return results;
+}
+
+//diferenta mai mica decat 3 MAD (din oricare rulare) e zgomot
+void compareWithBaseline(const std::string& path, const std::vector<BenchResult>& results) {
+    std::map<std::string, BenchResult> baseline = readResults(path);
+    if (baseline.empty()) {
+        std::cerr << "No results in baseline: " << path << "\n";
+        return;
+    }
+    std::printf("\nvs %s\n", path.c_str());
+    for (const BenchResult& r : results) {
+        auto it = baseline.find(r.name);
+        if (it == baseline.end()) {
+            std::printf("%-56s (new)\n", r.name.c_str());
+            continue;
+        }
+        const BenchResult& old = it->second;
+        double delta = r.medianNs - old.medianNs;
+        double noise = 3.0 * std::max(r.madNs, old.madNs);
+        const char* verdict = std::fabs(delta) <= noise ? "~" : (delta < 0.0 ? "faster" : "SLOWER");
+        std::printf("%-56s %+7.1f%%  %s\n", r.name.c_str(), old.medianNs > 0.0 ? 100.0 * delta / old.medianNs : 0.0,
+                    verdict);
+    }
+}
+
+std::string directoryOf(const std::string& path) {
+    size_t slash = path.find_last_of("/\\");
+    return slash == std::string::npos ? "." : path.substr(0, slash + 1);
+}
+
+std::string fileName(const std::string& path) {
+    size_t slash = path.find_last_of("/\\");
+    return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    if (!parseArgs(argc, argv, options)) return 1;
+
+    const char* scenePath = "resources/house.scene";
+    SceneView scene;
+    if (!openSceneCache(scenePath, scene) && !(cookScene(scenePath) && openSceneCache(scenePath, scene))) {
+        std::cerr << "Cannot load scene: " << scenePath << "\n";
+        return 1;
+    }
+
+    //pozitii fixe (seed constant) in jurul casei, la inaltimea ochilor si putin peste
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> xz(-8.0f, 8.0f);
+    std::uniform_real_distribution<float> height(0.5f, 2.5f);
+    std::vector<glm::vec3> positions(1024);
+    for (glm::vec3& p : positions) p = glm::vec3(xz(rng), height(rng), xz(rng));
+    size_t cursor = 0;
+    auto nextPosition = [&]() -> const glm::vec3& { return positions[cursor++ & (positions.size() - 1)]; };
+
+    BenchRunner bench(options);
+
+    //coliziuni, pe datele din house.scene
+    const SceneFloor& houseFloor = scene.floors[0];
+    bench.run("pointInPolygon/house_floor", [&] {
+        const glm::vec3& p = nextPosition();
+        return (uint64_t)pointInPolygon(glm::vec2(p.x, p.z), scene.points + houseFloor.firstPoint, houseFloor.pointCount);
+    });
+    const SceneSlope& slope = scene.slopes[0];
+    bench.run("getSlopeHeight", [&] {
+        const glm::vec3& p = nextPosition();
+        return (uint64_t)(getSlopeHeight(glm::vec2(p.x, p.z), slope.plane) * 1000.0f);
+    });
+    bench.run("checkSlopeCollision/all_slopes", [&] {
+        const glm::vec3& p = nextPosition();
+        glm::vec3 corrected = p;
+        uint64_t hits = 0;
+        for (uint32_t i = 0; i < scene.slopeCount; i++) {
+            const SceneSlope& s = scene.slopes[i];
+            hits += checkSlopeCollision(p, corrected, scene.points + s.firstPoint, s.pointCount, s.plane, 1.5f);
+        }
+        return hits;
+    });
+    bench.run("checkWallQuadCollision", [&] {
+        return (uint64_t)checkWallQuadCollision(nextPosition(), scene.walls[0].corners);
+    });
+    bench.run("checkInteriorWallsCollision", [&] {
+        return (uint64_t)checkInteriorWallsCollision(nextPosition(), scene);
+    });
+    const SceneInteractable* door = nullptr;
+    for (uint32_t i = 0; i < scene.interactableCount && !door; i++) {
+        if (scene.interactables[i].kind == SceneInteractableKind::Door) door = &scene.interactables[i];
+    }
+    if (door) {
+        float angle = 0.0f;
+        bench.run("checkDoorCollision", [&] {
+            angle = angle > 40.0f ? 0.0f : angle + 0.5f;
+            return (uint64_t)checkDoorCollision(nextPosition(), door->corners, angle);
+        });
+    }
+
+    //geometria pentru modul debug, ca intr-un cadru cu P apasat
+    std::vector<float> vertices;
+    std::vector<glm::vec2> floorPolygon(scene.points + houseFloor.firstPoint,
+                                        scene.points + houseFloor.firstPoint + houseFloor.pointCount);
+    bench.run("DebugGeometry/floor_boundary", [&] {
+        vertices.clear();
+        buildFloorBoundaryLines(floorPolygon, houseFloor.y, vertices);
+        return (uint64_t)vertices.size();
+    });
+    bench.run("DebugGeometry/floor_fan", [&] {
+        vertices.clear();
+        buildFloorFan(floorPolygon, houseFloor.y, vertices);
+        return (uint64_t)vertices.size();
+    });
+    bench.run("DebugGeometry/all_walls", [&] {
+        vertices.clear();
+        for (uint32_t i = 0; i < scene.wallCount; i++) buildQuadLines(scene.walls[i].corners, vertices);
+        return (uint64_t)vertices.size();
+    });
+    if (door) {
+        bench.run("DebugGeometry/door_quad", [&] {
+            vertices.clear();
+            buildDoorQuadLines(door->corners, 35.0f, vertices);
+            return (uint64_t)vertices.size();
+        });
+    }
+    bench.run("DebugGeometry/slope", [&] {
+        vertices.clear();
+        buildSlopeLines(slope.plane.points, vertices);
+        return (uint64_t)vertices.size();
+    });
+
+    //parsarea OBJ din ObjModel::load (fara cache, sudare si upload); fisierele lipsa se sar
+    for (uint32_t i = 0; i < scene.meshCount; i++) {
+        std::string path = scene.string(scene.meshes[i].path);
+        if (!std::filesystem::exists(path)) {
+            std::cout << "skipping missing mesh: " << path << "\n";
+            continue;
+        }
+        std::string baseDir = directoryOf(path);
+        bench.run("parseObj/" + fileName(path), [&] {
+            ObjParseResult obj;
+            MeshData mesh;
+            std::string err;
+            if (!parseObjFile(path, baseDir, obj, err)) return (uint64_t)0;
+            buildMeshData(obj, mesh);
+            return (uint64_t)mesh.vertices.size();
+        });
+    }
+
+    //stbi_load pe texturile referite de scena, o singura data fiecare
+    std::vector<std::string> textures;
+    for (uint32_t i = 0; i < scene.meshCount; i++) {
+        if (scene.meshes[i].texture == kSceneNoString) continue;
+        std::string path = scene.string(scene.meshes[i].texture);
+        if (std::find(textures.begin(), textures.end(), path) == textures.end()) textures.push_back(path);
+    }
+    for (const std::string& path : textures) {
+        if (!std::filesystem::exists(path)) {
+            std::cout << "skipping missing texture: " << path << "\n";
+            continue;
+        }
+        bench.run("stbi_load/" + fileName(path), [&] {
+            int width = 0, height = 0, channels = 0;
+            unsigned char* data = stbi_load(path.c_str(), &width, &height, &channels, 0);
+            if (!data) return (uint64_t)0;
+            stbi_image_free(data);
+            return (uint64_t)(width * height);
+        });
+    }
+
+    if (!writeResults(options.outPath, bench.all())) return 1;
+    std::cout << "results: " << options.outPath << "\n";
+    if (!options.baselinePath.empty()) compareWithBaseline(options.baselinePath, bench.all());
+    return 0;
+}
@@ -0,0 +1,172 @@
+//compara parserul OBJ propriu cu tinyobj::LoadObj pe modelele mari din scena
+//verifica si ca vectorul final de varfuri e identic, inclusiv la incarcarea in flux
+//rulare din radacina proiectului: obj_parser_bench [fisier.obj ...]
+#include "ObjParser.h"
+
+#include <tiny_obj_loader.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+static glm::vec3 calcNormal(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c) {
+    return glm::normalize(glm::cross(b - a, c - a));
+}
+
+//vechiul drum din ObjModel::load, pastrat ca referinta
+static bool loadWithTinyObj(const std::string& path, const std::string& baseDir, MeshData& mesh) {
+    tinyobj::attrib_t attrib;
+    std::vector<tinyobj::shape_t> shapes;
+    std::vector<tinyobj::material_t> materials;
+    std::string warn, err;
+    if (!tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &err, path.c_str(), baseDir.c_str(), true))
+        return false;
+
+    std::map<int, std::vector<ObjVertex>> materialVertices;
+    for (const auto& shape : shapes) {
+        size_t idxOffset = 0;
+        for (size_t f = 0; f < shape.mesh.num_face_vertices.size(); f++) {
+            int fv = shape.mesh.num_face_vertices[f];
+            if (fv != 3) {
+                idxOffset += fv;
+                continue;
+            }
+            ObjVertex v[3];
+            bool hasNormals = true;
+            for (int k = 0; k < 3; k++) {
+                tinyobj::index_t idx = shape.mesh.indices[idxOffset + k];
+                v[k].pos = glm::vec3(attrib.vertices[3 * idx.vertex_index + 0],
+                                     attrib.vertices[3 * idx.vertex_index + 1],
+                                     attrib.vertices[3 * idx.vertex_index + 2]);
+                if (idx.normal_index >= 0) {
+                    v[k].normal = glm::vec3(attrib.normals[3 * idx.normal_index + 0],
+                                            attrib.normals[3 * idx.normal_index + 1],
+                                            attrib.normals[3 * idx.normal_index + 2]);
+                } else {
+                    hasNormals = false;
+                    v[k].normal = glm::vec3(0, 1, 0);
+                }
+                if (idx.texcoord_index >= 0) {
+                    v[k].uv = glm::vec2(attrib.texcoords[2 * idx.texcoord_index + 0],
+                                        attrib.texcoords[2 * idx.texcoord_index + 1]);
+                } else {
+                    v[k].uv = glm::vec2(0.0f);
+                }
+            }
+            if (!hasNormals) {
+                glm::vec3 n = calcNormal(v[0].pos, v[1].pos, v[2].pos);
+                v[0].normal = v[1].normal = v[2].normal = n;
+            }
+            auto& bucket = materialVertices[shape.mesh.material_ids[f]];
+            bucket.push_back(v[0]);
+            bucket.push_back(v[1]);
+            bucket.push_back(v[2]);
+            idxOffset += 3;
+        }
+    }
+    mesh.vertices.clear();
+    mesh.groups.clear();
+    for (auto& pair : materialVertices) {
+        MeshGroupData group;
+        group.baseVertex = (uint32_t)mesh.vertices.size();
+        group.vertexCount = (uint32_t)pair.second.size();
+        if (pair.first >= 0 && pair.first < (int)materials.size())
+            group.diffuseTexture = materials[pair.first].diffuse_texname;
+        mesh.groups.push_back(group);
+        mesh.vertices.insert(mesh.vertices.end(), pair.second.begin(), pair.second.end());
+    }
+    return true;
+}
+
+static bool loadWithObjParser(const std::string& path, const std::string& baseDir, MeshData& mesh, unsigned threads) {
+    ObjParseResult obj;
+    std::string err;
+    if (!parseObjFile(path, baseDir, obj, err, threads)) return false;
+    buildMeshData(obj, mesh);
+    return true;
+}
+
+//incarcarea in flux scrie direct in vectorul final, ca intr-un buffer mapat
+static bool loadWithStreamReader(const std::string& path, const std::string& baseDir, MeshData& mesh) {
+    ObjStreamReader reader;
+    Arena arena;
+    std::string err;
+    if (!reader.open(path, baseDir, err)) return false;
+    mesh.groups = reader.groups();
+    mesh.vertices.resize(reader.vertexCount());
+    return reader.read(mesh.vertices.data(), arena, err);
+}
+
+static bool sameMesh(const MeshData& a, const MeshData& b) {
+    if (a.vertices.size() != b.vertices.size() || a.groups.size() != b.groups.size()) return false;
+    for (size_t i = 0; i < a.groups.size(); i++) {
+        if (a.groups[i].baseVertex != b.groups[i].baseVertex ||
+            a.groups[i].vertexCount != b.groups[i].vertexCount ||
+            a.groups[i].diffuseTexture != b.groups[i].diffuseTexture) return false;
+    }
+    return std::memcmp(a.vertices.data(), b.vertices.data(), a.vertices.size() * sizeof(ObjVertex)) == 0;
+}
+
+template <typename Fn>
+static double medianMs(int runs, Fn fn) {
+    std::vector<double> times;
+    for (int i = 0; i < runs; i++) {
+        auto t0 = Clock::now();
+        fn();
+        times.push_back(std::chrono::duration<double, std::milli>(Clock::now() - t0).count());
+    }
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+int main(int argc, char** argv) {
+    std::vector<std::string> files;
+    for (int i = 1; i < argc; i++) files.push_back(argv[i]);
+    if (files.empty()) {
+        files = {
+            "resources/models/ground/10450_Rectangular_Grass_Patch_v1_iterations-2.obj",
+            "resources/models/furniture/lamp.obj",
+        };
+    }
+
+    const int runs = 9;
+    bool allIdentical = true;
+    for (const auto& path : files) {
+        std::string baseDir = ".";
+        auto slash = path.find_last_of("/\\");
+        if (slash != std::string::npos) baseDir = path.substr(0, slash + 1);
+
+        MeshData reference, parsed, parsedSingle, streamed;
+        if (!loadWithTinyObj(path, baseDir, reference) ||
+            !loadWithObjParser(path, baseDir, parsed, 0) ||
+            !loadWithObjParser(path, baseDir, parsedSingle, 1) ||
+            !loadWithStreamReader(path, baseDir, streamed)) {
+            std::cerr << "Failed to load: " << path << "\n";
+            return 1;
+        }
+        bool identical = sameMesh(reference, parsed) && sameMesh(reference, parsedSingle) &&
+                         sameMesh(reference, streamed);
+        allIdentical = allIdentical && identical;
+
+        MeshData scratch;
+        double tTiny = medianMs(runs, [&] { loadWithTinyObj(path, baseDir, scratch); });
+        double tSingle = medianMs(runs, [&] { loadWithObjParser(path, baseDir, scratch, 1); });
+        double tMulti = medianMs(runs, [&] { loadWithObjParser(path, baseDir, scratch, 0); });
+        double tStream = medianMs(runs, [&] { loadWithStreamReader(path, baseDir, scratch); });
+
+        std::cout << path << "\n"
+                  << "  verts=" << reference.vertices.size() << " groups=" << reference.groups.size()
+                  << " identical=" << (identical ? "yes" : "NO") << "\n"
+                  << "  tinyobj:          " << tTiny << " ms\n"
+                  << "  ObjParser 1 thr:  " << tSingle << " ms\n"
+                  << "  ObjParser auto:   " << tMulti << " ms (x" << tTiny / tMulti << ")\n"
+                  << "  ObjStreamReader:  " << tStream << " ms\n";
+    }
+    return allIdentical ? 0 : 1;
+}
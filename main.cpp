@@ -6,28 +6,46 @@
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/matrix_inverse.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
 #include <iostream>
+#include <limits>
 #include <fstream>
+#include <memory>
 #include <sstream>
 #include <string>
+#include <vector>
 
+#include "AssetLoader.h"
+#include "AssetPack.h"
+#include "AssetRegistry.h"
+#include "Benchmark.h"
+#include "Collision.h"
 #include "ObjModel.h"
 #include "DebugRenderer.h"
-//declararea obiectelor
-ObjModel groundObj;
-ObjModel houseObj;
-ObjModel interiorObj;
-ObjModel floorObj;
-ObjModel roofObj;
-ObjModel doorNewObj;
-ObjModel doorNew2Obj;
-ObjModel sofaObj;
-ObjModel lampObj;
-ObjModel tableObj;
-ObjModel treeObj;
+#include "GpuProfiler.h"
+#include "Profiler.h"
+#include "Hash.h"
+#include "InputLog.h"
+#include "MaterialArrays.h"
+#include "RenderQueue.h"
+#include "RenderStats.h"
+#include "Scene.h"
+#include "SceneCompiler.h"
+#include "ShaderCache.h"
+#include "ShaderProgram.h"
+#include "TextureStreamer.h"
+#include "UniformRing.h"
 
 static std::string readFile(const char* path) {
+    PackBlob blob;
+    //un shader editat dupa gatire se citeste de langa pack
+    if (assetPack().readFresh(packEntryName(path), { path }, blob)) {
+        return std::string(reinterpret_cast<const char*>(blob.data), blob.size);
+    }
     std::ifstream f(path);
     if (!f.is_open()) {
         std::cerr << "Cannot open file: " << path << "\n";
@@ -37,78 +55,10 @@ static std::string readFile(const char* path) {
     ss << f.rdbuf();
     return ss.str();
 }
-//compilare shader
-static GLuint compileShader(GLenum type, const char* src) {
-    GLuint sh = glCreateShader(type);
-    glShaderSource(sh, 1, &src, nullptr);
-    glCompileShader(sh);
-    //daca nu a mers compilarea afiseaza eroarea
-    GLint ok;
-    glGetShaderiv(sh, GL_COMPILE_STATUS, &ok);
-    if (!ok) {
-        char log[1024];
-        glGetShaderInfoLog(sh, 1024, nullptr, log);
-        std::cerr << "Shader compile error:\n" << log << "\n";
-    }
-    return sh;
-}
-//creare program shader
-static GLuint createProgram(const char* vp, const char* fp) {
-    std::string vStr = readFile(vp);
-    std::string fStr = readFile(fp);
-    //compilare vertex si fragment shader
-    GLuint vs = compileShader(GL_VERTEX_SHADER, vStr.c_str());
-    GLuint fs = compileShader(GL_FRAGMENT_SHADER, fStr.c_str());
-
-    GLuint prog = glCreateProgram();
-    glAttachShader(prog, vs);
-    glAttachShader(prog, fs);
-    glLinkProgram(prog);
-
-    GLint ok;
-    glGetProgramiv(prog, GL_LINK_STATUS, &ok);
-    if (!ok) {
-        char log[1024];
-        glGetProgramInfoLog(prog, 1024, nullptr, log);
-        std::cerr << "Program link error:\n" << log << "\n";
-    }
-    //sterge shaderele dupa linkare
-    glDeleteShader(vs);
-    glDeleteShader(fs);
-    return prog;
+//creare program shader; binarul vine din cache daca sursele si driverul nu s-au schimbat
+static GLuint createProgram(ShaderCache& shaders, const char* name, const char* vp, const char* fp) {
+    return shaders.request(name, readFile(vp), readFile(fp));
 }
-//incarcare textura din fisier
-static GLuint loadTexture(const std::string& path) {
-    //incarca imaginea folosind stb_image
-    int width, height, channels;
-    stbi_set_flip_vertically_on_load(true);
-    //cititm textura prin bytes si configuram width, height, channels pentru openGL
-    unsigned char* data = stbi_load(path.c_str(), &width, &height, &channels, 0);
-
-    if (!data) {
-        std::cerr << "Failed to load texture: " << path << "\n";
-        return 0;
-    }
-    //determinare format textura
-    GLenum format = (channels == 4) ? GL_RGBA : GL_RGB;
-    //genereaza si configureaza textura OpenGL
-    GLuint textureID;
-    glGenTextures(1, &textureID);
-    glBindTexture(GL_TEXTURE_2D, textureID);
-
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-    glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-    glGenerateMipmap(GL_TEXTURE_2D);
-    //dam free la memoria imaginii
-    stbi_image_free(data);
-    std::cout << "Loaded texture: " << path << " (" << width << "x" << height << ", " << channels << " channels)\n";
-    return textureID;
-}
-//varfurile cubului pentru skybox
 static float skyboxVertices[] = {
     -1.0f,  1.0f, -1.0f,  -1.0f, -1.0f, -1.0f,   1.0f, -1.0f, -1.0f,
      1.0f, -1.0f, -1.0f,   1.0f,  1.0f, -1.0f,  -1.0f,  1.0f, -1.0f,
@@ -146,79 +96,48 @@ static float lastX = 640, lastY = 360;
 //pt framerui sa fie limitat
 static float deltaTime = 0.0f;
 static float lastFrame = 0.0f;
-//variabile pentru usi
-static bool door1Open = false;
-static bool door2Open = false;
+//variabile pentru usi (unghiul maxim si distanta vin din scena)
 static bool doorTogglePressed = false;
-static float door1Angle = 0.0f;
-static float door2Angle = 0.0f;
-static float door1TargetAngle = 0.0f;
-static float door2TargetAngle = 0.0f;
-static const float maxDoorAngle = 70.0f;
 static const float doorSpeed = 120.0f;
-static const float doorProximity = 2.0f;
 //variabile pentru fizica
 static float verticalVel = 0.0f;
 static const float gravity = -9.81f;
 static const float eyeHeight = 1.5f;
-static float floorY = 0.5f;
 static bool physicsEnabled = false;
 static bool jumpPressed = false;
-//variabile pentru lampa
-static bool lampLightOn = false;
+//variabile pentru lumini si ceata
 static bool fogEnabled = false;
 static bool fPressed = false;
 static bool lampTogglePressed = false;
-static const float lampProximity = 3.0f;
-static const glm::vec3 lampPosition(1.5f, 0.5f, 0.0f);
-//variabile pentru canapea
-static bool sofaEditMode = false;
+//variabile pentru obiectele mutabile (canapea)
+static bool editMode = false;
 static bool mPressed = false;
-static glm::vec3 sofaPosition(3.0f, 0.0f, 1.0f);
-static float sofaRotation = 180.0f;
-static float sofaMovementSpeed = 0.1f;
+static float editRotation = 0.0f;   //grade de la rotita, aplicate in cadrul urmator
+static float editMovementSpeed = 0.1f;
+//LOD: eroarea maxima acceptata pe ecran, in pixeli; umbra tolereaza mai mult
+static const float lodPixelError = 1.0f;
+static const float shadowLodPixelError = 4.0f;
+//texturile mai mari (ex. cele de 4k) se micsoreaza la incarcare; 0 = rezolutia sursei
+static const int maxTextureDimension = 2048;
+//construit de asset_cooker (cu aceeasi limita de textura); daca lipseste, totul vine din resources/
+static const char* assetPackPath = "resources.pack";
+//memoria video pentru nivelurile mari de mip ale texturilor comprimate, in MB
+static const size_t textureBudgetMB = 192;
+//--benchmark: pas fix de simulare si cadrele de la inceput care nu intra in statistici
+static const float benchmarkTimeStep = 1.0f / 60.0f;
+static const int benchmarkWarmupFrames = 30;
 
 static bool debugMode = false;
-//poligoanele pentru podea si panta, de exemplu floor si stairs
-static const std::vector<glm::vec2> floorPoly = {
-    { -0.81f,  6.7f },
-    { -0.80f,  4.4f },
-    {  5.70f,  4.4f },
-    {  5.70f, -6.0f },
-    { -5.40f, -6.0f },
-    { -5.40f,  6.7f }
+//starea de la rulare a instantelor dinamice; scena mapata ramane neschimbata
+struct InstanceState {
+    glm::vec3 offset = glm::vec3(0.0f);
+    float yaw = 0.0f;   //grade, in jurul pivotului
 };
 
-static const std::vector<glm::vec2> floorPoly25 = {
-    { -15.0f, -15.0f },
-    {  15.0f, -15.0f },
-    {  15.0f,  15.0f },
-    { -15.0f,  15.0f }
-};
-static float floorY25 = 0.0f;
-static const std::vector<glm::vec3> slopePoints3D = {
-    { -0.8f, 0.4f, 6.7f },  // point 1 (higher)
-    { -0.3f, 0.0f, 6.7f },  // point 2 (lower)
-    { -0.3f, 0.0f, 4.4f },  // point 3 (lower)
-    { -0.8f, 0.4f, 4.5f }   // point 4 (higher)
-};
-static const std::vector<glm::vec2> slopePoly = {
-    { -0.8f, 6.7f },
-    { -2.1f, 6.7f },
-    { -0.3f, 4.5f },
-    { -0.8f, 4.5f }
-};
-static const std::vector<glm::vec3> slopePoints3D2 = {
-    {  1.8f, 0.5f, -6.0f },  // point 1 (higher)
-    {  1.8f, 0.0f, -6.9f },  // point 2 (lower)
-    { -1.4f, 0.0f, -6.9f },  // point 3 (lower)
-    { -1.4f, 0.5f, -6.0f }   // point 4 (higher)
-};
-static const std::vector<glm::vec2> slopePoly2 = {
-    {  1.8f, -6.0f },
-    {  1.8f, -6.9f },
-    { -1.4f, -6.9f },
-    { -1.4f, -6.0f }
+struct DoorState {
+    bool open = false;
+    float angle = 0.0f;
+    float targetAngle = 0.0f;
 };
 //calculam noile directii ale camerei in functie de yaw si pitch
 static void updateCameraVectors() {
@@ -233,18 +152,25 @@ static void updateCameraVectors() {
 static void framebuffer_size_callback(GLFWwindow*, int w, int h) {
     glViewport(0, 0, w, h);
 }
-//callback pentru miscare mouse
-static void mouse_callback(GLFWwindow*, double xpos, double ypos) {
+//intrarea cadrului curent (citita la inceputul cadrului sau luata din log) si evenimentele
+//venite de la glfwPollEvents de atunci; callback-urile doar le pun in coada
+static InputFrame frameInput;
+static InputFrame pendingInput;
+static bool keyDown(int key) {
+    return frameInput.keyDown(key);
+}
+//miscare mouse
+static void applyCursor(float xpos, float ypos) {
     if (firstMouse) {
-        lastX = (float)xpos;
-        lastY = (float)ypos;
+        lastX = xpos;
+        lastY = ypos;
         firstMouse = false;
     }
 
-    float xoff = (float)xpos - lastX;
-    float yoff = lastY - (float)ypos;
-    lastX = (float)xpos;
-    lastY = (float)ypos;
+    float xoff = xpos - lastX;
+    float yoff = lastY - ypos;
+    lastX = xpos;
+    lastY = ypos;
 
     float sens = 0.10f;
     xoff *= sens;
@@ -258,240 +184,212 @@ static void mouse_callback(GLFWwindow*, double xpos, double ypos) {
 
     updateCameraVectors();
 }
-//verifica daca un punct este in interiorul unui poligon 2D, pt  colizuni, sa nu cadem prin podea
-//
-static bool pointInPolygon(const glm::vec2& p, const std::vector<glm::vec2>& poly) {
-    bool inside = false;
-    for (size_t i = 0, j = poly.size() - 1; i < poly.size(); j = i++) {
-        const glm::vec2& a = poly[i];
-        const glm::vec2& b = poly[j];
-        //verifica daca linia dintre punct si infinit intersecteaza latura poligonului
-        bool intersect =
-            ((a.y > p.y) != (b.y > p.y)) &&
-            (p.x < (b.x - a.x) * (p.y - a.y) / (b.y - a.y) + a.x);
-        if (intersect) inside = !inside;
-    }
-    return inside;
+//matricea unei instante; cele dinamice se rotesc/muta in jurul pivotului
+static glm::mat4 instanceMatrix(const SceneInstance& instance, const InstanceState& state) {
+    if (!(instance.flags & SceneInstanceDynamic)) return instance.world;
+    glm::mat4 M = glm::translate(glm::mat4(1.0f), instance.pivot + state.offset);
+    M = glm::rotate(M, glm::radians(state.yaw), glm::vec3(0, 1, 0));
+    M = glm::translate(M, -instance.pivot);
+    return M * instance.world;
 }
-//calculeaza inaltimea pe panta la o pozitie XZ data
-static float getSlopeHeight(const glm::vec2& posXZ, const std::vector<glm::vec3>& slopePoints) {
-    if (slopePoints.size() != 4) return 0.0f;
-    //verificam inaltimea folosind primii 3 puncte pentru a defini planul pantei
-    glm::vec3 p0 = slopePoints[0];
-    glm::vec3 p1 = slopePoints[1];
-    glm::vec3 p2 = slopePoints[2];
-
-    glm::vec3 v1 = p1 - p0;
-    glm::vec3 v2 = p2 - p0;
-    glm::vec3 normal = glm::cross(v1, v2);
-    float d = -glm::dot(normal, p0);
-
-    if (fabs(normal.y) < 0.001f) return 0.0f;
-
-    float heightOnSlope = -(normal.x * posXZ.x + normal.z * posXZ.y + d) / normal.y;
-    return heightOnSlope;
+//DebugRenderer lucreaza cu vectori; in modul debug copiem punctele din scena
+static std::vector<glm::vec2> scenePolygon(const SceneView& scene, uint32_t firstPoint, uint32_t pointCount) {
+    return std::vector<glm::vec2>(scene.points + firstPoint, scene.points + firstPoint + pointCount);
 }
-//verifica coliziunea cu panta si corecteaza pozitia daca este necesar
-static bool checkSlopeCollision(const glm::vec3& pos, glm::vec3& correctedPos,
-                               const std::vector<glm::vec2>& slopePoly,
-                               const std::vector<glm::vec3>& slopePoints) {
-    glm::vec2 posXZ(pos.x, pos.z);
-    if (!pointInPolygon(posXZ, slopePoly)) {
-        return false;
-    }
-    //daca suntem in interiorul poligonului pantei, calculam inaltimea pantei la pozitia XZ
-    //daca picioarele sunt sub inaltimea pantei, corectam pozitia pe Y
-    float slopeHeight = getSlopeHeight(posXZ, slopePoints);
-    float feetY = pos.y - eyeHeight;
-    float tolerance = 1.0f;
-    //aici verificam daca picioarele sunt sub inaltimea pantei plus o toleranta
-    if (feetY < slopeHeight + tolerance) {
-        correctedPos = pos;
-        correctedPos.y = slopeHeight + eyeHeight;
-        return true;
+//scroll mouse (zoom sau rotire obiect mutabil)
+static void applyScroll(float yoff) {
+    if (editMode) {
+        editRotation += yoff * 5.0f;
+    } else {
+        fov -= yoff;
+        if (fov < 20.0f) fov = 20.0f;
+        if (fov > 80.0f) fov = 80.0f;
     }
-
-    return false;
+}
+//callback pentru miscare mouse
+static void mouse_callback(GLFWwindow*, double xpos, double ypos) {
+    pendingInput.cursor.push_back(glm::vec2((float)xpos, (float)ypos));
+}
+//callback pentru scroll mouse
+static void scroll_callback(GLFWwindow*, double, double yoff) {
+    pendingInput.scroll.push_back((float)yoff);
 }
 
-//verifica coliziunea cu un perete definit prin 4 colturi
-static bool checkWallQuadCollision(const glm::vec3& pos, const std::vector<glm::vec3>& wallCorners, float thickness = 0.15f) {
-    if (wallCorners.size() != 4) return false;
-    //daca pozitia este in interiorul axelor AABB extinse cu grosimea peretelui, atunci este coliziune
-    float minX = std::min({wallCorners[0].x, wallCorners[1].x, wallCorners[2].x, wallCorners[3].x});
-    float maxX = std::max({wallCorners[0].x, wallCorners[1].x, wallCorners[2].x, wallCorners[3].x});
-    float minY = std::min({wallCorners[0].y, wallCorners[1].y, wallCorners[2].y, wallCorners[3].y});
-    float maxY = std::max({wallCorners[0].y, wallCorners[1].y, wallCorners[2].y, wallCorners[3].y});
-    float minZ = std::min({wallCorners[0].z, wallCorners[1].z, wallCorners[2].z, wallCorners[3].z});
-    float maxZ = std::max({wallCorners[0].z, wallCorners[1].z, wallCorners[2].z, wallCorners[3].z});
-
-    return (pos.x >= minX - thickness && pos.x <= maxX + thickness &&
-            pos.y >= minY - thickness && pos.y <= maxY + thickness &&
-            pos.z >= minZ - thickness && pos.z <= maxZ + thickness);
+//datele unei instante pentru shadere; cuantizarea vine de la mesh (identitate cat timp nu e urcat)
+static InstanceData makeInstanceData(const ObjModel& obj, const glm::mat4& M) {
+    InstanceData data;
+    data.model = M;
+    data.normalMatrix = glm::inverseTranspose(M);
+    data.quantScale = glm::vec4(1.0f, 1.0f, 1.0f, 0.0f);
+    data.quantOffset = glm::vec4(0.0f);
+    if (const MeshAsset* mesh = obj.meshAsset()) {
+        data.quantScale = glm::vec4(mesh->quantization.scale, mesh->vertexFormat == VertexFormat::Packed ? 1.0f : 0.0f);
+        data.quantOffset = glm::vec4(mesh->quantization.offset, 0.0f);
+    }
+    return data;
 }
-//verifica coliziunea cu peretii interiori ai casei
-static bool checkInteriorWallsCollision(const glm::vec3& pos,
-                                       const std::vector<glm::vec3>& door1Corners,
-                                       const std::vector<glm::vec3>& door2Corners) {
-    //peretele interioare si exterioare ale casei
-    std::vector<std::vector<glm::vec3>> walls = {
-        {
-            glm::vec3(-0.21f, 0.0f, 6.7f),
-            glm::vec3(-5.4f, 0.0f, 6.7f),
-            glm::vec3(-5.4f, 3.0f, 6.7f),
-            glm::vec3(-2.3f, 3.0f, 6.7f)
-        },
-        {
-            glm::vec3(-2.3f, 0.0f, 4.4f),
-            glm::vec3(-2.3f, 0.0f, 6.7f),
-            glm::vec3(-2.3f, 0.5f, 6.7f),
-            glm::vec3(-2.3f, 0.5f, 4.4f)
-        },
-        {
-            glm::vec3(-2.3f, 0.5f, 5.6f),
-            glm::vec3(-2.3f, 0.5f, 6.7f),
-            glm::vec3(-2.3f, 3.0f, 6.7f),
-            glm::vec3(-2.3f, 3.0f, 5.6f)
-        },
-        {
-            glm::vec3(-2.3f, 0.5f, 4.4f),
-            glm::vec3(-2.3f, 0.5f, 4.8f),
-            glm::vec3(-2.3f, 3.0f, 4.8f),
-            glm::vec3(-2.3f, 3.0f, 4.4f)
-        },
-        {
-            glm::vec3(-2.3f, 2.29f, 4.8f),
-            glm::vec3(-2.3f, 2.29f, 5.6f),
-            glm::vec3(-2.3f, 3.0f, 5.6f),
-            glm::vec3(-2.3f, 3.0f, 4.8f)
-        },
-        {
-            glm::vec3(-2.3f, 3.0f, 4.4f),
-            glm::vec3(-2.3f, 0.5f, 4.4f),
-            glm::vec3(5.7f, 0.5f, 4.4f),
-            glm::vec3(5.7f, 3.0f, 4.4f)
-        },
-        {
-            glm::vec3(5.7f, 3.0f, 4.4f),
-            glm::vec3(5.7f, 0.5f, 4.4f),
-            glm::vec3(5.7f, 0.5f, -6.0f),
-            glm::vec3(5.7f, 3.0f, -3.7f)
-        },
-        {
-            glm::vec3(5.7f, 0.5f, -3.7f),
-            glm::vec3(1.0f, 0.5f, -3.7f),
-            glm::vec3(1.0f, 3.0f, -3.7f),
-            glm::vec3(5.7f, 3.0f, -3.7f)
-        },
-        {
-            glm::vec3(0.2f, 0.5f, -3.7f),
-            glm::vec3(-5.4f, 0.5f, -3.7f),
-            glm::vec3(-5.4f, 3.0f, -3.7f),
-            glm::vec3(0.2f, 3.0f, -3.7f)
-        },
-        {
-            glm::vec3(0.2f, 2.28f, -3.7f),
-            glm::vec3(1.0f, 2.28f, -3.7f),
-            glm::vec3(1.0f, 3.0f, -3.7f),
-            glm::vec3(0.2f, 3.0f, -3.7f)
-        },
-        {
-            glm::vec3(5.7f, 0.5f, -6.0f),
-            glm::vec3(1.8f, 0.5f, -6.0f),
-            glm::vec3(1.8f, 3.0f, -6.0f),
-            glm::vec3(5.7f, 3.0f, -6.0f)
-        },
-        {
-            glm::vec3(-1.4f, 0.5f, -6.0f),
-            glm::vec3(-5.4f, 0.5f, -6.0f),
-            glm::vec3(-5.4f, 3.0f, -6.0f),
-            glm::vec3(-1.4f, 3.0f, -6.0f)
-        },
-        {
-            glm::vec3(-5.4f, 0.5f, -6.0f),
-            glm::vec3(-5.4f, 0.5f, 6.7f),
-            glm::vec3(-5.4f, 3.0f, 6.7f),
-            glm::vec3(-5.4f, 3.0f, -6.0f)
-        },
-        {
-            glm::vec3(-4.8f, 0.5f, 6.4f),
-            glm::vec3(-4.8f, 0.5f, -3.4f),
-            glm::vec3(-4.8f, 3.0f, -3.4f),
-            glm::vec3(-4.8f, 3.0f, 6.4f)
-        }
-    };
-    //adauga colturile usilor pentru coliziune
-    for (size_t i = 0; i < walls.size(); ++i) {
-        if (checkWallQuadCollision(pos, walls[i])) {
-            static int debugCounter = 0;
-            if (debugCounter++ % 30 == 0) {
-                std::cout << "Wall collision: Wall #" << i << " at pos ("
-                          << pos.x << ", " << pos.y << ", " << pos.z << ")\n";
-            }
-            return true;
-        }
+//vederile texelFetch peste ring, citite de basic.vert si depth.vert
+static void bindInstanceTexels(const UniformRing& uniformRing) {
+    glActiveTexture(GL_TEXTURE0 + kInstanceDataUnit);
+    glBindTexture(GL_TEXTURE_BUFFER, uniformRing.floatTexels());
+    glActiveTexture(GL_TEXTURE0 + kDrawRecordUnit);
+    glBindTexture(GL_TEXTURE_BUFFER, uniformRing.uintTexels());
+    glActiveTexture(GL_TEXTURE0);
+}
+
+//un cadru nevazut cu fiecare combinatie program/stare din bucla, ca driverul sa termine compilarile
+//amanate (formatul varfurilor, blending, framebuffer-ul tinta) inainte de primul cadru real
+//scissor-ul 1x1 face desenarea aproape gratuita
+static void warmUpDraws(ShaderProgram& basicProgram, ShaderProgram& depthProgram, ShaderProgram& skyboxProgram,
+                        UniformRing& uniformRing, GLuint depthMapFBO, GLuint skyboxVAO, DebugRenderer& debugRenderer,
+                        const std::vector<ObjModel>& models, const SceneView& scene) {
+    glm::mat4 identity(1.0f);
+    glEnable(GL_SCISSOR_TEST);
+    glScissor(0, 0, 1, 1);
+    //ObjModel::draw foloseste prima desenare, deci prima instanta
+    uniformRing.beginFrame();
+    FrameConstants frame{};
+    frame.projection = frame.view = frame.lightSpaceMatrix = identity;
+    InstanceData instance{ identity, identity, glm::vec4(1.0f, 1.0f, 1.0f, 0.0f), glm::vec4(0.0f) };
+    frame.drawParams.x = (int)(uniformRing.push(instance) / 16);
+    frame.drawParams.y = (int)(uniformRing.push(DrawRecord{ 0, kNoMaterialLayer, { 0, 0 } }) / 16);
+    uniformRing.bind<FrameConstants>(kFrameBlockBinding, uniformRing.push(frame));
+    bindInstanceTexels(uniformRing);
+    //umbrele si trecerea principala
+    ShaderProgram* passShaders[] = { &depthProgram, &basicProgram };
+    const GLuint passTargets[] = { depthMapFBO, 0 };
+    for (int pass = 0; pass < 2; pass++) {
+        ShaderProgram& shader = *passShaders[pass];
+        glBindFramebuffer(GL_FRAMEBUFFER, passTargets[pass]);
+        shader.use();
+        for (const ObjModel& model : models) model.draw();
     }
 
-    return false;
-}
-//verifica coliziunea cu o usa care se poate roti
-static bool checkDoorCollision(const glm::vec3& pos, const std::vector<glm::vec3>& baseCorners, float doorAngle) {
-    if (fabs(doorAngle) > 45.0f) return false;
-    //dupa 45 de grade nu mai exista coliziunea usii
-    glm::vec3 hingePos = baseCorners[0];
-    hingePos.y = (baseCorners[0].y + baseCorners[1].y) / 2.0f;
-    //calculeaza pozitiile colturilor usii dupa rotatie
-    std::vector<glm::vec3> rotatedCorners;
-    float angleRad = glm::radians(doorAngle);
-    glm::mat4 rotation = glm::rotate(glm::mat4(1.0f), angleRad, glm::vec3(0, 1, 0));
-
-    for (const auto& corner : baseCorners) {
-        glm::vec3 localPos = corner - hingePos;
-        glm::vec4 rotated = rotation * glm::vec4(localPos, 1.0f);
-        glm::vec3 worldPos = glm::vec3(rotated) + hingePos;
-        rotatedCorners.push_back(worldPos);
+    glDepthFunc(GL_LEQUAL);
+    skyboxProgram.use();
+    glBindVertexArray(skyboxVAO);
+    glDrawArrays(GL_TRIANGLES, 0, 36);
+    glBindVertexArray(0);
+    glDepthFunc(GL_LESS);
+
+    //liniile si poligonul transparent din modul debug
+    if (scene.floorCount > 0) {
+        const SceneFloor& floor = scene.floors[0];
+        std::vector<glm::vec2> poly = scenePolygon(scene, floor.firstPoint, floor.pointCount);
+        debugRenderer.drawFloorPolygonFilled(poly, floor.y, identity, identity);
+        debugRenderer.drawFloorBoundary(poly, floor.y, identity, identity);
     }
 
-    float minY = rotatedCorners[0].y;
-    float maxY = rotatedCorners[1].y;
-    if (pos.y < minY || pos.y > maxY) return false;
+    uniformRing.endFrame();
+    glDisable(GL_SCISSOR_TEST);
+    glFinish();
+}
 
-    float minX = std::min({rotatedCorners[0].x, rotatedCorners[1].x, rotatedCorners[2].x, rotatedCorners[3].x});
-    float maxX = std::max({rotatedCorners[0].x, rotatedCorners[1].x, rotatedCorners[2].x, rotatedCorners[3].x});
-    float minZ = std::min({rotatedCorners[0].z, rotatedCorners[1].z, rotatedCorners[2].z, rotatedCorners[3].z});
-    float maxZ = std::max({rotatedCorners[0].z, rotatedCorners[1].z, rotatedCorners[2].z, rotatedCorners[3].z});
+//uniformele ramase in afara blocurilor (doar sampler-ele), cautate o singura data dupa link
+struct BasicUniforms {
+    explicit BasicUniforms(const ShaderProgram& p)
+        : textureSampler(p.uniform<int>("textureSampler")), materialArray(p.uniform<int>("materialArray")),
+          shadowMap(p.uniform<int>("shadowMap")), instanceData(p.uniform<int>("instanceData")),
+          drawRecords(p.uniform<int>("drawRecords")) {}
 
-    float thickness = 0.2f;
-    return (pos.x >= minX - thickness && pos.x <= maxX + thickness &&
-            pos.z >= minZ - thickness && pos.z <= maxZ + thickness);
-}
-//callback pentru scroll mouse (zoom sau rotire canapea)
-static void scroll_callback(GLFWwindow*, double, double yoff) {
-    if (sofaEditMode) {
-        sofaRotation += (float)yoff * 5.0f;
-    } else {
-        fov -= (float)yoff;
-        if (fov < 20.0f) fov = 20.0f;
-        if (fov > 80.0f) fov = 80.0f;
+    Uniform<int> textureSampler, materialArray, shadowMap, instanceData, drawRecords;
+};
+
+struct DepthUniforms {
+    explicit DepthUniforms(const ShaderProgram& p)
+        : textureSampler(p.uniform<int>("textureSampler")), materialArray(p.uniform<int>("materialArray")),
+          instanceData(p.uniform<int>("instanceData")), drawRecords(p.uniform<int>("drawRecords")) {}
+
+    Uniform<int> textureSampler, materialArray, instanceData, drawRecords;
+};
+
+struct SkyboxUniforms {
+    explicit SkyboxUniforms(const ShaderProgram& p) : skybox(p.uniform<int>("skybox")) {}
+
+    Uniform<int> skybox;
+};
+
+//optiunile din linia de comanda
+//lab2 [--benchmark] [--benchmark-out benchmark] [--size 1920x1080] [--record session.inp | --replay session.inp]
+//     [--gpu-profile gpu.csv [--gpu-profile-draws]] [--trace trace.json] [--scene resources/house.scene]
+struct AppOptions {
+    //fereastra ascunsa, fara vsync, camera pe traseul fix; scrie <benchmarkOut>.csv/.json
+    //impreuna cu --replay, camera vine din sesiunea inregistrata in loc de traseu
+    bool benchmark = false;
+    std::string benchmarkOut = "benchmark";
+    int width = 1920;
+    int height = 1080;
+    //intrarea si deltaTime-ul fiecarui cadru, scrise sau citite dintr-un log binar
+    std::string recordPath;
+    std::string replayPath;
+    //timpii GPU pe pase (si statistici de pipeline, daca exista), cate o linie pe zona in fiecare cadru
+    std::string gpuProfilePath;
+    bool gpuProfileDraws = false;  //si cate o zona pentru fiecare ObjModel::draw
+    //zonele CPU de la pornire si din fiecare cadru, in formatul Chrome trace
+    std::string tracePath;
+    //modelele, instantele, luminile, podelele si peretii; compilata in <scena>.scenebin
+    std::string scenePath = "resources/house.scene";
+};
+
+static bool parseArgs(int argc, char** argv, AppOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--benchmark") options.benchmark = true;
+        else if (arg == "--benchmark-out" && hasValue) options.benchmarkOut = argv[++i];
+        else if (arg == "--record" && hasValue) options.recordPath = argv[++i];
+        else if (arg == "--replay" && hasValue) options.replayPath = argv[++i];
+        else if (arg == "--gpu-profile" && hasValue) options.gpuProfilePath = argv[++i];
+        else if (arg == "--gpu-profile-draws") options.gpuProfileDraws = true;
+        else if (arg == "--trace" && hasValue) options.tracePath = argv[++i];
+        else if (arg == "--scene" && hasValue) options.scenePath = argv[++i];
+        else if (arg == "--size" && hasValue) {
+            if (std::sscanf(argv[++i], "%dx%d", &options.width, &options.height) != 2 ||
+                options.width <= 0 || options.height <= 0) {
+                std::cerr << "Invalid size: " << argv[i] << "\n";
+                return false;
+            }
+        } else {
+            std::cerr << "Unknown argument: " << arg << "\n";
+            return false;
+        }
+    }
+    //traseul benchmark-ului muta camera pe langa intrare, deci nu s-ar putea rejuca
+    if (!options.recordPath.empty() && (options.benchmark || !options.replayPath.empty())) {
+        std::cerr << "--record cannot be combined with --benchmark or --replay\n";
+        return false;
+    }
+    //zonele per desenare se scriu in CSV-ul lui --gpu-profile
+    if (options.gpuProfileDraws && options.gpuProfilePath.empty()) {
+        std::cerr << "--gpu-profile-draws requires --gpu-profile <file.csv>\n";
+        return false;
     }
+    return true;
 }
 
-int main() {
+int main(int argc, char** argv) {
+    AppOptions options;
+    if (!parseArgs(argc, argv, options)) return -1;
+    profilerSetThreadName("main");
+    if (!options.tracePath.empty()) profilerSetEnabled(true);
+    ProfileZone startupZone("startup");
     if (!glfwInit()) return -1;
     //initializare fereastra
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    //benchmark-ul nu are nevoie de fereastra vizibila (merge si pe llvmpipe, fara GPU)
+    if (options.benchmark) glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
     //initializare fereastra
-    GLFWwindow* window = glfwCreateWindow(1920,  1080, "House Project", nullptr, nullptr);
+    GLFWwindow* window = glfwCreateWindow(options.width, options.height, "House Project", nullptr, nullptr);
     if (!window) return -1;
     //framebuffer si input callbacks
     glfwMakeContextCurrent(window);
-    glfwSwapInterval(1); // vsync
+    glfwSwapInterval(options.benchmark ? 0 : 1); // vsync, oprit cand masuram
     glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
     glfwSetCursorPosCallback(window, mouse_callback);
     glfwSetScrollCallback(window, scroll_callback);
-    glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+    if (!options.benchmark) glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
     //initializare GLEW
     glewExperimental = GL_TRUE;
     if (glewInit() != GLEW_OK) {
@@ -501,24 +399,45 @@ int main() {
 
     glEnable(GL_DEPTH_TEST);
 
+    //programele se compileaza in paralel cu incarcarea modelelor, finish() le asteapta
+    ShaderCache shaders;
     DebugRenderer debugRenderer;
-    debugRenderer.init();
+    debugRenderer.init(shaders);
+    if (assetPack().open(assetPackPath)) {
+        std::cout << "Mounted asset pack: " << assetPackPath << " (" << assetPack().entries().size()
+                  << " entries)\n";
+    }
+    //scena vine din pack sau din <scena>.scenebin; daca sursa s-a schimbat se recompileaza
+    SceneView scene;
+    ProfileZone sceneZone("load scene");
+    const std::string& scenePath = options.scenePath;
+    if (!openSceneCache(scenePath, scene) && !(cookScene(scenePath) && openSceneCache(scenePath, scene))) {
+        std::cerr << "Cannot load scene: " << scenePath << "\n";
+        return -1;
+    }
+    sceneZone.end();
+    //texturile si modelele se decodeaza pe worker-i, aici ramane doar upload-ul
+    AssetLoader assets;
+    assets.setMaxTextureDimension(maxTextureDimension);
+    //texturile mari pornesc cu mip-urile mici, restul vin dupa distanta pe ecran
+    TextureStreamer streamer(assets, textureBudgetMB * 1024 * 1024);
+    assets.setTextureStreamer(&streamer);
     //creare shadere si programe
-    GLuint program = createProgram(
+    GLuint basicProgramId = createProgram(shaders, "basic",
         "resources/shaders/basic.vert",
         "resources/shaders/basic.frag"
     );
     //shadere pentru skybox
-    GLuint skyboxProgram = createProgram(
+    GLuint skyboxProgramId = createProgram(shaders, "skybox",
         "resources/shaders/skybox.vert",
         "resources/shaders/skybox.frag"
     );
     //incarcare textura skybox
-    GLuint skyboxTexture = loadTexture("resources/models/sky/citrus_orchard_puresky.jpg");
+    TextureHandle skyboxTexture = assets.loadTexture("resources/models/sky/citrus_orchard_puresky.jpg");
     GLuint skyboxVAO, skyboxVBO;
     createSkyboxCube(skyboxVAO, skyboxVBO);
     //shadere pentru shadow mapping
-    GLuint depthShader = createProgram(
+    GLuint depthProgramId = createProgram(shaders, "depth",
         "resources/shaders/depth.vert",
         "resources/shaders/depth.frag"
     );
@@ -543,61 +462,179 @@ int main() {
     glDrawBuffer(GL_NONE);
     glReadBuffer(GL_NONE);
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
-    //incarcare modele
-    GLuint groundTexture = loadTexture("resources/models/ground/10450_Rectangular_Grass_Patch_v1_Diffuse.jpg");
-    GLuint houseTexture = loadTexture("resources/models/house/Cottage_Clean_Base_Color.png");
-    GLuint interiorTexture = loadTexture("resources/models/interior/grey_plaster_03_diff_4k.jpg");
-    GLuint floorTexture = loadTexture("resources/models/floor/wood_cabinet_worn_long_diff_4k.jpg");
-    GLuint roofTexture = loadTexture("resources/models/ceiling/grey_plaster_03_diff_4k.jpg");
-
-    if (!groundObj.load("resources/models/ground/10450_Rectangular_Grass_Patch_v1_iterations-2.obj")) return -1;
-    groundObj.setTexture(groundTexture);
-
-    if (!houseObj.load("resources/models/house/housewwindows.obj")) return -1;
-    houseObj.setTexture(houseTexture);
-
-    if (!doorNewObj.load("resources/models/furniture/DoorGoodPos1.obj")) return -1;
-    doorNewObj.setTexture(houseTexture);
-
-    if (!doorNew2Obj.load("resources/models/furniture/DoorGoodPos2.obj")) return -1;
-    doorNew2Obj.setTexture(houseTexture);
-
-    if (!interiorObj.load("resources/models/interior/wallsFixed.obj")) return -1;
-    interiorObj.setTexture(interiorTexture);
-
-    if (!floorObj.load("resources/models/floor/floorFixed.obj")) return -1;
-    floorObj.setTexture(floorTexture);
-
-    if (!roofObj.load("resources/models/ceiling/roofFixed.obj")) return -1;
-    roofObj.setTexture(roofTexture);
-
-    if (!sofaObj.load("resources/models/furniture/sofa.obj")) return -1;
-    sofaObj.setTexture(houseTexture);
-
-    if (!lampObj.load("resources/models/furniture/lamp.obj")) return -1;
-
-    if (!tableObj.load("resources/models/furniture/table.obj")) return -1;
+    //incarcare modele din scena
+    //modelele mari folosesc varfuri cuantizate (16 bytes in loc de 32)
+    //cele marcate stream (ex. resources/stream.scene) se parseaza in doua treceri direct in buffer-e mapate,
+    //cu memorie de varf mica
+    std::vector<ObjModel> models(scene.meshCount);
+    for (uint32_t i = 0; i < scene.meshCount; i++) {
+        const SceneMesh& mesh = scene.meshes[i];
+        VertexFormat format = (mesh.flags & SceneMeshPacked) ? VertexFormat::Packed : VertexFormat::Float;
+        if (mesh.flags & SceneMeshStream) models[i].loadStreaming(assets, scene.string(mesh.path));
+        else models[i].loadAsync(assets, scene.string(mesh.path), format);
+        if (mesh.texture != kSceneNoString) {
+            models[i].setTexture(assets.loadTexture(scene.string(mesh.texture)));
+        }
+    }
 
-    if (!treeObj.load("resources/models/ground/Hazelnut.obj")) return -1;
+    //asteptam toate incarcarile, urcand pe GPU ce termina worker-ii intre timp
+    {
+        PROFILE_ZONE("wait for assets");
+        assets.waitIdle();
+    }
+    for (const ObjModel& model : models) {
+        if (model.hasFailed()) return -1;
+    }
+    //texturile de aceeasi marime si format devin straturi in array-uri comune, ca RenderQueue sa le deseneze
+    //in acelasi lot; inainte de primul cadru, cat streamer-ul nu a urcat inca niveluri mari
+    MaterialArrays materialArrays;
+    {
+        PROFILE_ZONE("material arrays");
+        std::vector<TextureHandle> textures;
+        for (const ObjModel& model : models) model.materialTextures(textures);
+        materialArrays.build(textures);
+    }
+    assetRegistry().report(std::cout);
+    {
+        PROFILE_ZONE("finish shaders");
+        shaders.finish();
+    }
+    //uniformele se enumera dupa link; de aici incolo programele se folosesc doar prin ShaderProgram
+    ShaderProgram basicProgram(basicProgramId);
+    ShaderProgram depthProgram(depthProgramId);
+    ShaderProgram skyboxProgram(skyboxProgramId);
+    const BasicUniforms basicUniforms(basicProgram);
+    const DepthUniforms depthUniforms(depthProgram);
+    const SkyboxUniforms skyboxUniforms(skyboxProgram);
+    //constantele cadrului ajung in shadere printr-un bloc std140 comun
+    for (ShaderProgram* shader : { &basicProgram, &depthProgram, &skyboxProgram }) {
+        shader->bindBlock("FrameConstants", kFrameBlockBinding);
+    }
+    //sampler-ele nu se schimba niciodata; programele tin valorile dupa link
+    basicProgram.use();
+    basicProgram.set(basicUniforms.textureSampler, 0);
+    basicProgram.set(basicUniforms.materialArray, (int)kMaterialArrayUnit);
+    basicProgram.set(basicUniforms.shadowMap, 1);
+    basicProgram.set(basicUniforms.instanceData, (int)kInstanceDataUnit);
+    basicProgram.set(basicUniforms.drawRecords, (int)kDrawRecordUnit);
+    depthProgram.use();
+    depthProgram.set(depthUniforms.textureSampler, 0);
+    depthProgram.set(depthUniforms.materialArray, (int)kMaterialArrayUnit);
+    depthProgram.set(depthUniforms.instanceData, (int)kInstanceDataUnit);
+    depthProgram.set(depthUniforms.drawRecords, (int)kDrawRecordUnit);
+    //pe cadru: blocul cadrului, datele tuturor instantelor, apoi cate o inregistrare si o comanda indirecta
+    //pentru fiecare grup desenat, in ambele pase
+    size_t maxDraws = 0;
+    for (uint32_t i = 0; i < scene.instanceCount; i++) {
+        const ObjModel& obj = models[scene.instances[i].mesh];
+        if (obj.meshAsset()) maxDraws += obj.lodLevel(0).groups.size() * kRenderPassCount;
+    }
+    size_t ringBytes = sizeof(FrameConstants) + scene.instanceCount * sizeof(InstanceData) +
+                       maxDraws * (sizeof(DrawRecord) + sizeof(DrawElementsIndirectCommand));
+    UniformRing uniformRing;
+    if (!uniformRing.init(ringBytes, 4)) {
+        return -1;
+    }
+    std::vector<InstanceData> instanceData(scene.instanceCount);
+    //ambele pase se genereaza dintr-o singura trimitere a scenei, sortata dupa starea GL
+    RenderQueue renderQueue;
+    {
+        PROFILE_ZONE("warm up draws");
+        warmUpDraws(basicProgram, depthProgram, skyboxProgram, uniformRing, depthMapFBO, skyboxVAO, debugRenderer,
+                    models, scene);
+    }
 
     bool wireframe = false;
     bool wirePressed = false;
-    //definire colturilor usilor pentru coliziuni
-    std::vector<glm::vec3> door1Corners = {
-        glm::vec3(-2.4f, 0.501f, 4.8f),
-        glm::vec3(-2.4f, 2.29f,  4.8f),
-        glm::vec3(-2.4f, 2.29f,  5.69f),
-        glm::vec3(-2.4f, 0.501f, 5.69f)
+    std::vector<InstanceState> instanceStates(scene.instanceCount);
+    std::vector<glm::mat4> instanceWorld(scene.instanceCount);
+    std::vector<DoorState> doorStates(scene.interactableCount);
+    //shaderul are o lumina directionala (soarele, da si umbra) si una punctiforma (lampa)
+    std::vector<bool> lightOn(scene.lightCount);
+    int sunLight = -1;
+    int lampLight = -1;
+    for (uint32_t i = 0; i < scene.lightCount; i++) {
+        const SceneLight& light = scene.lights[i];
+        lightOn[i] = !(light.flags & SceneLightStartsOff);
+        if (light.type == SceneLightType::Directional && sunLight < 0) sunLight = (int)i;
+        if (light.type == SceneLightType::Point && lampLight < 0) lampLight = (int)i;
+    }
+    //usile din scena si peretii
+    auto blockedAt = [&](const glm::vec3& pos) {
+        PROFILE_ZONE("collision");
+        for (uint32_t i = 0; i < scene.interactableCount; i++) {
+            const SceneInteractable& door = scene.interactables[i];
+            if (door.kind == SceneInteractableKind::Door &&
+                checkDoorCollision(pos, door.corners, doorStates[i].angle)) return true;
+        }
+        uint32_t wall = 0;
+        if (!checkInteriorWallsCollision(pos, scene, &wall)) return false;
+        static int debugCounter = 0;
+        if (debugCounter++ % 30 == 0) {
+            std::cout << "Wall collision: Wall #" << wall << " at pos ("
+                      << pos.x << ", " << pos.y << ", " << pos.z << ")\n";
+        }
+        return true;
     };
-
-    std::vector<glm::vec3> door2Corners = {
-        glm::vec3(0.2f, 0.5f,  -3.6f),
-        glm::vec3(0.2f, 2.28f, -3.6f),
-        glm::vec3(1.0f, 2.28f, -3.6f),
-        glm::vec3(1.0f, 0.5f,  -3.6f)
+    //tot ce poate schimba simularea; la replay trebuie sa iasa la fel in fiecare cadru
+    auto simulationHash = [&]() {
+        uint64_t h = hashBytes(&camPos, sizeof(camPos));
+        h = hashBytes(&camFront, sizeof(camFront), h);
+        const float scalars[] = { yaw, pitch, fov, verticalVel };
+        h = hashBytes(scalars, sizeof(scalars), h);
+        const uint8_t flags[] = { physicsEnabled, editMode, fogEnabled, debugMode };
+        h = hashBytes(flags, sizeof(flags), h);
+        for (const InstanceState& state : instanceStates) {
+            h = hashBytes(&state.offset, sizeof(state.offset), h);
+            h = hashBytes(&state.yaw, sizeof(state.yaw), h);
+        }
+        for (const DoorState& state : doorStates) {
+            const float angles[] = { state.angle, state.targetAngle };
+            h = hashBytes(angles, sizeof(angles), h);
+        }
+        for (bool on : lightOn) {
+            uint8_t value = on;
+            h = hashBytes(&value, 1, h);
+        }
+        return h;
     };
+
+    std::unique_ptr<InputRecorder> inputRecorder;
+    std::unique_ptr<InputPlayer> replay;
+    bool replayDiverged = false;
+    if (!options.recordPath.empty()) {
+        inputRecorder = std::make_unique<InputRecorder>();
+        if (!inputRecorder->open(options.recordPath)) return -1;
+    }
+    if (!options.replayPath.empty()) {
+        replay = std::make_unique<InputPlayer>();
+        if (!replay->open(options.replayPath)) return -1;
+    }
+    std::unique_ptr<GpuProfiler> gpuProfiler;
+    if (!options.gpuProfilePath.empty()) {
+        gpuProfiler = std::make_unique<GpuProfiler>();
+        if (!gpuProfiler->openLog(options.gpuProfilePath)) return -1;
+        if (!gpuProfiler->statisticsSupported()) {
+            std::cout << "GL_ARB_pipeline_statistics_query not available, GPU profile has timings only\n";
+        }
+    }
+    //zonele pe draw-uri folosesc caile din scena ca nume (memoria scenei traieste cat bucla)
+    GpuProfiler* drawProfiler = options.gpuProfileDraws ? gpuProfiler.get() : nullptr;
+    std::unique_ptr<BenchmarkRecorder> benchmark;
+    float benchmarkTime = 0.0f;
+    if (options.benchmark) {
+        benchmark = std::make_unique<BenchmarkRecorder>(benchmarkWarmupFrames);
+        //traseul trece prin usi, deci le deschidem de la inceput
+        for (uint32_t i = 0; i < scene.interactableCount && !replay; i++) {
+            const SceneInteractable& door = scene.interactables[i];
+            if (door.kind != SceneInteractableKind::Door) continue;
+            doorStates[i] = { true, door.maxAngle, door.maxAngle };
+        }
+    }
+    startupZone.end();
     //bucle principal
     while (!glfwWindowShouldClose(window)) {
+        PROFILE_ZONE("frame");
         float now = (float)glfwGetTime();
         deltaTime = now - lastFrame;
         lastFrame = now;
@@ -606,11 +643,52 @@ int main() {
         if (deltaTime > maxFrameTime) {
             deltaTime = maxFrameTime;
         }
+        if (benchmark && !replay) {
+            //pas fix, ca fiecare rulare sa deseneze exact aceleasi cadre
+            if (benchmarkTime > benchmarkPathDuration()) break;
+            deltaTime = benchmarkTimeStep;
+        }
+        //intrarea cadrului: din log la replay, altfel tastele de acum si evenimentele din coada
+        ProfileZone inputZone("input");
+        if (replay) {
+            if (!replay->next(frameInput)) break;
+            deltaTime = frameInput.deltaTime;
+        } else {
+            frameInput.deltaTime = deltaTime;
+            frameInput.keys = 0;
+            for (int i = 0; i < kInputKeyCount; i++) {
+                frameInput.setKey(kInputKeys[i], glfwGetKey(window, kInputKeys[i]) == GLFW_PRESS);
+            }
+            frameInput.cursor.swap(pendingInput.cursor);
+            frameInput.scroll.swap(pendingInput.scroll);
+        }
+        pendingInput.cursor.clear();
+        pendingInput.scroll.clear();
+        for (const glm::vec2& cursor : frameInput.cursor) applyCursor(cursor.x, cursor.y);
+        for (float yoff : frameInput.scroll) applyScroll(yoff);
+        inputZone.end();
+
+        if (benchmark && !replay) {
+            CameraPose pose = sampleBenchmarkPath(benchmarkTime);
+            benchmarkTime += deltaTime;
+            camPos = pose.position;
+            yaw = pose.yaw;
+            pitch = pose.pitch;
+            updateCameraVectors();
+        }
+        if (benchmark) benchmark->beginFrame();
+        if (gpuProfiler) gpuProfiler->beginFrame();
+        renderStats() = RenderStats();
+        //ce au mai terminat worker-ii se urca treptat, fara sa blocam cadrul
+        {
+            PROFILE_ZONE("asset uploads");
+            assets.processUploads();
+        }
 
-        if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+        if (keyDown(GLFW_KEY_ESCAPE))
             glfwSetWindowShouldClose(window, true);
         //toggle wireframe
-        bool f2 = glfwGetKey(window, GLFW_KEY_F2) == GLFW_PRESS;
+        bool f2 = keyDown(GLFW_KEY_F2);
         if (f2 && !wirePressed) {
             wireframe = !wireframe;
             wirePressed = true;
@@ -619,7 +697,7 @@ int main() {
         if (!f2) wirePressed = false;
         //toggle fizica
         static bool gPressed = false;
-        bool gKey = glfwGetKey(window, GLFW_KEY_G) == GLFW_PRESS;
+        bool gKey = keyDown(GLFW_KEY_G);
         if (gKey && !gPressed) {
             physicsEnabled = !physicsEnabled;
             gPressed = true;
@@ -631,7 +709,7 @@ int main() {
         if (!gKey) gPressed = false;
         //toggle debug mode
         static bool pPressed = false;
-        bool pKey = glfwGetKey(window, GLFW_KEY_P) == GLFW_PRESS;
+        bool pKey = keyDown(GLFW_KEY_P);
         if (pKey && !pPressed) {
             debugMode = !debugMode;
             pPressed = true;
@@ -639,29 +717,28 @@ int main() {
         }
         if (!pKey) pPressed = false;
         //miscare camera
+        ProfileZone physicsZone("physics");
         float speed = 4.0f * deltaTime;
         glm::vec3 right = glm::normalize(glm::cross(camFront, camUp));
         //fizica activata
         if (physicsEnabled) {
             glm::vec3 moveDelta(0.0f);
-            if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS) moveDelta += camFront * speed;
-            if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS) moveDelta -= camFront * speed;
-            if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS) moveDelta -= right * speed;
-            if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS) moveDelta += right * speed;
+            if (keyDown(GLFW_KEY_W)) moveDelta += camFront * speed;
+            if (keyDown(GLFW_KEY_S)) moveDelta -= camFront * speed;
+            if (keyDown(GLFW_KEY_A)) moveDelta -= right * speed;
+            if (keyDown(GLFW_KEY_D)) moveDelta += right * speed;
 
             moveDelta.y = 0.0f;
             glm::vec3 newPos = camPos + moveDelta;
             glm::vec2 newXZ(newPos.x, newPos.z);
 
-            bool insideFloorL = pointInPolygon(newXZ, floorPoly);
-            bool insideFloor25 = pointInPolygon(newXZ, floorPoly25);
-            bool insideAnyFloor = insideFloorL || insideFloor25;
-
-            bool doorCollision = checkDoorCollision(newPos, door1Corners, door1Angle) ||
-                                checkDoorCollision(newPos, door2Corners, door2Angle);
-            bool wallCollision = checkInteriorWallsCollision(newPos, door1Corners, door2Corners);
+            bool insideAnyFloor = false;
+            for (uint32_t i = 0; i < scene.floorCount && !insideAnyFloor; i++) {
+                const SceneFloor& floor = scene.floors[i];
+                insideAnyFloor = pointInPolygon(newXZ, scene.points + floor.firstPoint, floor.pointCount);
+            }
 
-            if (insideAnyFloor && !doorCollision && !wallCollision) {
+            if (insideAnyFloor && !blockedAt(newPos)) {
                 camPos.x = newPos.x;
                 camPos.z = newPos.z;
             }
@@ -674,10 +751,17 @@ int main() {
             bool hasSupport = false;
             float supportMinY = -1e9f;
 
+            ProfileZone slopeZone("slope collision");
             glm::vec3 slopeCorrected = camPos;
-            bool onSlope1 = checkSlopeCollision(camPos, slopeCorrected, slopePoly, slopePoints3D);
-            bool onSlope2 = checkSlopeCollision(camPos, slopeCorrected, slopePoly2, slopePoints3D2);
-            bool onAnySlope = onSlope1 || onSlope2;
+            bool onAnySlope = false;
+            for (uint32_t i = 0; i < scene.slopeCount; i++) {
+                const SceneSlope& slope = scene.slopes[i];
+                if (checkSlopeCollision(camPos, slopeCorrected, scene.points + slope.firstPoint,
+                                        slope.pointCount, slope.plane, eyeHeight)) {
+                    onAnySlope = true;
+                }
+            }
+            slopeZone.end();
 
             if (onAnySlope) {
                 camPos = slopeCorrected;
@@ -688,21 +772,13 @@ int main() {
 
             if (!onAnySlope) {
                 glm::vec2 curXZ(camPos.x, camPos.z);
-                bool inL  = pointInPolygon(curXZ, floorPoly);
-                bool in25 = pointInPolygon(curXZ, floorPoly25);
                 float feetY = camPos.y - eyeHeight;
-
-                if (inL) {
-                    float y = floorY + eyeHeight;
-                    if (feetY >= floorY - 0.2f) {
-                        hasSupport = true;
-                        supportMinY = y;
-                    }
-                }
-
-                if (in25) {
-                    float y = floorY25 + eyeHeight;
-                    if (feetY >= floorY25 - 0.2f) {
+                //sprijinul e cea mai inalta podea de sub picioare
+                for (uint32_t i = 0; i < scene.floorCount; i++) {
+                    const SceneFloor& floor = scene.floors[i];
+                    if (!pointInPolygon(curXZ, scene.points + floor.firstPoint, floor.pointCount)) continue;
+                    float y = floor.y + eyeHeight;
+                    if (feetY >= floor.y - 0.2f) {
                         if (!hasSupport || y > supportMinY) {
                             hasSupport = true;
                             supportMinY = y;
@@ -716,7 +792,7 @@ int main() {
                 }
             }
 
-            bool space = glfwGetKey(window, GLFW_KEY_SPACE) == GLFW_PRESS;
+            bool space = keyDown(GLFW_KEY_SPACE);
             if (space && !jumpPressed) {
                 if (hasSupport && fabs(camPos.y - supportMinY) < 0.1f) {
                     verticalVel = 3.5f;
@@ -729,24 +805,21 @@ int main() {
             //fizica dezactivata
             glm::vec3 newPos = camPos;
 
-            if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS) newPos += camFront * speed;
-            if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS) newPos -= camFront * speed;
-            if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS) newPos -= right * speed;
-            if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS) newPos += right * speed;
-            if (glfwGetKey(window, GLFW_KEY_Q) == GLFW_PRESS) newPos -= camUp * speed;
-            if (glfwGetKey(window, GLFW_KEY_SPACE) == GLFW_PRESS) newPos += camUp * speed;
+            if (keyDown(GLFW_KEY_W)) newPos += camFront * speed;
+            if (keyDown(GLFW_KEY_S)) newPos -= camFront * speed;
+            if (keyDown(GLFW_KEY_A)) newPos -= right * speed;
+            if (keyDown(GLFW_KEY_D)) newPos += right * speed;
+            if (keyDown(GLFW_KEY_Q)) newPos -= camUp * speed;
+            if (keyDown(GLFW_KEY_SPACE)) newPos += camUp * speed;
 
-            bool doorCollision = checkDoorCollision(newPos, door1Corners, door1Angle) ||
-                                checkDoorCollision(newPos, door2Corners, door2Angle);
-            bool wallCollision = checkInteriorWallsCollision(newPos, door1Corners, door2Corners);
-
-            if (!doorCollision && !wallCollision) {
+            if (!blockedAt(newPos)) {
                 camPos = newPos;
             }
         }
+        physicsZone.end();
         //afisare pozitie camera pentru debugging
         static bool kPressed = false;
-        if (glfwGetKey(window, GLFW_KEY_K) == GLFW_PRESS && !kPressed) {
+        if (keyDown(GLFW_KEY_K) && !kPressed) {
             kPressed = true;
             std::cout << "=== CURRENT POSITION ===\n";
             std::cout << "Camera Position: (" << camPos.x << ", " << camPos.y << ", " << camPos.z << ")\n";
@@ -754,108 +827,116 @@ int main() {
             std::cout << "Yaw: " << yaw << ", Pitch: " << pitch << "\n";
             std::cout << "========================\n";
         }
-        if (glfwGetKey(window, GLFW_KEY_K) == GLFW_RELEASE) kPressed = false;
-        //interactiuni cu usi, lampa, mod editare canapea, ceata
-        glm::vec3 door1Pos(-2.41f, 1.41f, 4.89f);
-        glm::vec3 door2Pos(0.2f, 1.41f, -3.67f);
-        glm::vec3 door1Normal(0.0f, 0.0f, -1.0f);
-        glm::vec3 door2Normal(0.0f, 0.0f, 1.0f);
-        //pozitia  usii este aproximata ca punctul de mijloc al usii
-        float distToDoor1 = glm::length(camPos - door1Pos);
-        float distToDoor2 = glm::length(camPos - door2Pos);
-        //verifica apasare tasta E pentru deschiderea/inchiderea usii
-        bool eKey = glfwGetKey(window, GLFW_KEY_E) == GLFW_PRESS;
+        if (!keyDown(GLFW_KEY_K)) kPressed = false;
+        //interactiuni cu usi, lumini, mod editare obiecte mutabile, ceata
+        //verifica apasare tasta E pentru deschiderea/inchiderea primei usi din apropiere
+        ProfileZone doorsZone("doors");
+        bool eKey = keyDown(GLFW_KEY_E);
         if (eKey && !doorTogglePressed) {
-            if (distToDoor1 < doorProximity) {
-                door1Open = !door1Open;
+            for (uint32_t i = 0; i < scene.interactableCount; i++) {
+                const SceneInteractable& door = scene.interactables[i];
+                //pozitia  usii este aproximata ca punctul de mijloc al usii
+                if (door.kind != SceneInteractableKind::Door) continue;
+                if (glm::length(camPos - door.position) >= door.proximity) continue;
+                DoorState& state = doorStates[i];
+                state.open = !state.open;
                 doorTogglePressed = true;
 
-                glm::vec3 doorToPlayer = camPos - door1Pos;
-                float side = glm::dot(doorToPlayer, door1Normal);
+                glm::vec3 doorToPlayer = camPos - door.position;
+                float side = glm::dot(doorToPlayer, door.normal);
 
-                if (door1Open) {
-                    door1TargetAngle = (side > 0.0f) ? maxDoorAngle : -maxDoorAngle;
+                if (state.open) {
+                    state.targetAngle = (side > 0.0f) ? door.maxAngle : -door.maxAngle;
                 } else {
-                    door1TargetAngle = 0.0f;
+                    state.targetAngle = 0.0f;
                 }
 
-                std::cout << "Door 1 toggled! Now " << (door1Open ? "OPEN" : "CLOSED")
+                std::cout << "Door " << scene.string(scene.instances[door.target].name) << " toggled! Now "
+                          << (state.open ? "OPEN" : "CLOSED")
                           << " (side: " << (side > 0 ? "inside" : "outside")
-                          << ", angle: " << door1TargetAngle << "°)\n";
-
-            } else if (distToDoor2 < doorProximity) {
-                door2Open = !door2Open;
-                doorTogglePressed = true;
-
-                glm::vec3 doorToPlayer = camPos - door2Pos;
-                float side = glm::dot(doorToPlayer, door2Normal);
-
-                if (door2Open) {
-                    door2TargetAngle = (side > 0.0f) ? maxDoorAngle : -maxDoorAngle;
-                } else {
-                    door2TargetAngle = 0.0f;
-                }
-
-                std::cout << "Door 2 toggled! Now " << (door2Open ? "OPEN" : "CLOSED")
-                          << " (side: " << (side > 0 ? "inside" : "outside")
-                          << ", angle: " << door2TargetAngle << "°)\n";
+                          << ", angle: " << state.targetAngle << "°)\n";
+                break;
             }
         }
         if (!eKey) doorTogglePressed = false;
-        //animatie deschidere/inchidere usi
-        if (door1Angle < door1TargetAngle) {
-            door1Angle += doorSpeed * deltaTime;
-            if (door1Angle > door1TargetAngle) door1Angle = door1TargetAngle;
-        } else if (door1Angle > door1TargetAngle) {
-            door1Angle -= doorSpeed * deltaTime;
-            if (door1Angle < door1TargetAngle) door1Angle = door1TargetAngle;
-        }
-
-        if (door2Angle < door2TargetAngle) {
-            door2Angle += doorSpeed * deltaTime;
-            if (door2Angle > door2TargetAngle) door2Angle = door2TargetAngle;
-        } else if (door2Angle > door2TargetAngle) {
-            door2Angle -= doorSpeed * deltaTime;
-            if (door2Angle < door2TargetAngle) door2Angle = door2TargetAngle;
+        //animatie deschidere/inchidere usi, usa se roteste in jurul pivotului instantei
+        for (uint32_t i = 0; i < scene.interactableCount; i++) {
+            const SceneInteractable& door = scene.interactables[i];
+            if (door.kind != SceneInteractableKind::Door) continue;
+            DoorState& state = doorStates[i];
+            if (state.angle < state.targetAngle) {
+                state.angle += doorSpeed * deltaTime;
+                if (state.angle > state.targetAngle) state.angle = state.targetAngle;
+            } else if (state.angle > state.targetAngle) {
+                state.angle -= doorSpeed * deltaTime;
+                if (state.angle < state.targetAngle) state.angle = state.targetAngle;
+            }
+            instanceStates[door.target].yaw = state.angle;
         }
-        // interactiune lampa
-        float distToLamp = glm::length(camPos - lampPosition);
-        bool lKey = glfwGetKey(window, GLFW_KEY_L) == GLFW_PRESS;
-        if (lKey && !lampTogglePressed && distToLamp < lampProximity) {
-            lampLightOn = !lampLightOn;
-            lampTogglePressed = true;
-            std::cout << "Lamp light " << (lampLightOn ? "ON" : "OFF") << "\n";
+        doorsZone.end();
+        // interactiune lumini
+        bool lKey = keyDown(GLFW_KEY_L);
+        if (lKey && !lampTogglePressed) {
+            for (uint32_t i = 0; i < scene.interactableCount; i++) {
+                const SceneInteractable& lightSwitch = scene.interactables[i];
+                if (lightSwitch.kind != SceneInteractableKind::LightSwitch) continue;
+                if (glm::length(camPos - lightSwitch.position) >= lightSwitch.proximity) continue;
+                lightOn[lightSwitch.target] = !lightOn[lightSwitch.target];
+                lampTogglePressed = true;
+                std::cout << "Light " << scene.string(scene.lights[lightSwitch.target].name)
+                          << (lightOn[lightSwitch.target] ? " ON" : " OFF") << "\n";
+                break;
+            }
         }
         if (!lKey) lampTogglePressed = false;
-        //mod editare canapea
-        bool mKey = glfwGetKey(window, GLFW_KEY_M) == GLFW_PRESS;
+        //mod editare obiecte mutabile
+        bool mKey = keyDown(GLFW_KEY_M);
         if (mKey && !mPressed) {
-            sofaEditMode = !sofaEditMode;
+            editMode = !editMode;
             mPressed = true;
-            std::cout << "Sofa Edit Mode " << (sofaEditMode ? "ON - Use Arrow Keys to move, Scroll Wheel to rotate" : "OFF") << "\n";
+            std::cout << "Edit Mode " << (editMode ? "ON - Use Arrow Keys to move, Scroll Wheel to rotate" : "OFF") << "\n";
         }
         if (!mKey) mPressed = false;
 
-        if (sofaEditMode) {
-            float currentY = sofaPosition.y;
-
-            if (glfwGetKey(window, GLFW_KEY_UP) == GLFW_PRESS) {
-                sofaPosition.z -= sofaMovementSpeed;
+        if (editMode) {
+            //doar pe orizontala
+            glm::vec3 editMove(0.0f);
+            if (keyDown(GLFW_KEY_UP)) {
+                editMove.z -= editMovementSpeed;
             }
-            if (glfwGetKey(window, GLFW_KEY_DOWN) == GLFW_PRESS) {
-                sofaPosition.z += sofaMovementSpeed;
+            if (keyDown(GLFW_KEY_DOWN)) {
+                editMove.z += editMovementSpeed;
             }
-            if (glfwGetKey(window, GLFW_KEY_LEFT) == GLFW_PRESS) {
-                sofaPosition.x -= sofaMovementSpeed;
+            if (keyDown(GLFW_KEY_LEFT)) {
+                editMove.x -= editMovementSpeed;
             }
-            if (glfwGetKey(window, GLFW_KEY_RIGHT) == GLFW_PRESS) {
-                sofaPosition.x += sofaMovementSpeed;
+            if (keyDown(GLFW_KEY_RIGHT)) {
+                editMove.x += editMovementSpeed;
             }
 
-            sofaPosition.y = currentY;
+            for (uint32_t i = 0; i < scene.interactableCount; i++) {
+                const SceneInteractable& movable = scene.interactables[i];
+                if (movable.kind != SceneInteractableKind::Movable) continue;
+                instanceStates[movable.target].offset += editMove;
+                instanceStates[movable.target].yaw += editRotation;
+            }
+        }
+        editRotation = 0.0f;
+        for (uint32_t i = 0; i < scene.instanceCount; i++) {
+            instanceWorld[i] = instanceMatrix(scene.instances[i], instanceStates[i]);
+        }
+        //simularea cadrului s-a terminat: o scriem in log sau o comparam cu cea inregistrata
+        if (replay) {
+            if (!replayDiverged && simulationHash() != frameInput.stateHash) {
+                replayDiverged = true;
+                std::cerr << "Replay diverged at frame " << replay->frameCount() - 1 << "\n";
+            }
+        } else if (inputRecorder) {
+            frameInput.stateHash = simulationHash();
+            inputRecorder->write(frameInput);
         }
         //toggle ceata
-        bool fKey = glfwGetKey(window, GLFW_KEY_F) == GLFW_PRESS;
+        bool fKey = keyDown(GLFW_KEY_F);
         if (fKey && !fPressed) {
             fogEnabled = !fogEnabled;
             fPressed = true;
@@ -866,331 +947,198 @@ int main() {
         glClearColor(0.08f, 0.10f, 0.12f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-        glm::vec3 lightDir = glm::normalize(glm::vec3(-0.2f, -1.0f, -0.3f));
+        int w, h;
+        glfwGetFramebufferSize(window, &w, &h);
+        //pixeli pe unitate la distanta 1, pentru alegerea LOD-urilor
+        float lodScale = (float)h / (2.0f * std::tan(glm::radians(fov) * 0.5f));
+
+        glm::vec3 lightDir = sunLight >= 0 ? scene.lights[sunLight].vector : glm::vec3(0.0f, -1.0f, 0.0f);
         glm::vec3 lightPos = -lightDir * 20.0f;
         glm::mat4 lightProjection = glm::ortho(-15.0f, 15.0f, -15.0f, 15.0f, 1.0f, 50.0f);
         glm::mat4 lightView = glm::lookAt(lightPos, glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
         glm::mat4 lightSpaceMatrix = lightProjection * lightView;
 
-        glUseProgram(depthShader);
-        glUniformMatrix4fv(glGetUniformLocation(depthShader, "lightSpaceMatrix"), 1, GL_FALSE, &lightSpaceMatrix[0][0]);
-
-        glActiveTexture(GL_TEXTURE0);
-        glUniform1i(glGetUniformLocation(depthShader, "textureSampler"), 0);
+        ProfileZone uniformsZone("uniforms");
+        //setare matrici
+        glm::mat4 projection = glm::perspective(glm::radians(fov), (float)w/(float)h, 0.1f, 200.0f);
+        glm::mat4 view = glm::lookAt(camPos, camPos + camFront, camUp);
+        //view seteaza pozitia si orientarea camerei
+        //projection seteaza perspectiva (fov, aspect ratio, near, far), perspectiva
+        glm::vec3 sunColor = sunLight >= 0 && lightOn[sunLight] ? scene.lights[sunLight].color : glm::vec3(0.0f);
+        glm::vec3 lampPosition = lampLight >= 0 ? scene.lights[lampLight].vector : glm::vec3(0.0f);
+        glm::vec3 lampColor = lampLight >= 0 && lightOn[lampLight] ? scene.lights[lampLight].color : glm::vec3(0.0f);
+
+        uniformRing.beginFrame();
+        FrameConstants frame;
+        frame.projection = projection;
+        frame.view = view;
+        frame.lightSpaceMatrix = lightSpaceMatrix;
+        frame.viewPos = glm::vec4(camPos, 1.0f);
+        frame.dirLightDir = glm::vec4(lightDir, 0.0f);
+        frame.dirLightColor = glm::vec4(sunColor, 0.0f);
+        frame.pointLightPos = glm::vec4(lampPosition, 1.0f);
+        frame.pointLightColor = glm::vec4(lampColor, 0.0f);
+        frame.fogColor = glm::vec4(0.6f, 0.65f, 0.7f, 0.08f);
+        frame.fogParams = glm::vec4(fogEnabled ? 1.0f : 0.0f, 0.0f, 0.0f, 0.0f);
+        //model pune obiecte la pozitia initiala pe scena; o data pe instanta, ambele pase le citesc din ring
+        for (uint32_t i = 0; i < scene.instanceCount; i++) {
+            instanceData[i] = makeInstanceData(models[scene.instances[i].mesh], instanceWorld[i]);
+        }
+        frame.drawParams.x = (int)(uniformRing.push(instanceData.data(), instanceData.size() * sizeof(InstanceData)) / 16);
+        uniformsZone.end();
+
+        ProfileZone queueZone("render queue");
+        renderQueue.clear();
+        renderQueue.setPass(kShadowPass, depthProgram, lightPos);
+        renderQueue.setPass(kMainPass, basicProgram, camPos);
+        //in modul debug trecerea principala e a DebugRenderer-ului, umbrele raman
+        for (uint32_t i = 0; i < scene.instanceCount; i++) {
+            const SceneInstance& instance = scene.instances[i];
+            const ObjModel& obj = models[instance.mesh];
+            const glm::mat4& M = instanceWorld[i];
+            bool lod = instance.flags & SceneInstanceLod;
+            RenderRecord record;
+            record.model = &obj;
+            record.transform = &M;
+            record.instance = i;
+            record.passMask = ((instance.flags & SceneInstanceCastsShadow) ? kShadowPassBit : 0) |
+                              (debugMode ? 0 : kMainPassBit);
+            //umbrele folosesc LOD-uri mai grosiere
+            record.lod[kShadowPass] = lod ? obj.selectLod(M, camPos, lodScale, shadowLodPixelError) : 0;
+            record.lod[kMainPass] = lod ? obj.selectLod(M, camPos, lodScale, lodPixelError) : 0;
+            record.label = scene.string(scene.meshes[instance.mesh].path);
+            renderQueue.submit(record);
+            if (!debugMode) obj.requestTextureDetail(streamer, M, camPos, lodScale);
+        }
+        frame.drawParams.y = (int)(renderQueue.prepare(uniformRing) / 16);
+        uniformRing.bind<FrameConstants>(kFrameBlockBinding, uniformRing.push(frame));
+        bindInstanceTexels(uniformRing);
+        queueZone.end();
 
+        ProfileZone shadowZone("shadow pass");
+        if (gpuProfiler) gpuProfiler->beginZone("shadow");
         glViewport(0, 0, SHADOW_WIDTH, SHADOW_HEIGHT);
         glBindFramebuffer(GL_FRAMEBUFFER, depthMapFBO);
         glClear(GL_DEPTH_BUFFER_BIT);
-        //functie lambda pentru randarea scenei in depth map
-        auto renderSceneForDepth = [&](GLuint shader) {
-            glm::mat4 M = glm::mat4(1.0f);
-            glUniformMatrix4fv(glGetUniformLocation(shader, "model"), 1, GL_FALSE, &M[0][0]);
-            houseObj.draw();
-
-            M = glm::translate(glm::mat4(1.0f), glm::vec3(-2.41f, 1.41f, 4.89f));
-            M = glm::rotate(M, glm::radians(door1Angle), glm::vec3(0, 1, 0));
-            glUniformMatrix4fv(glGetUniformLocation(shader, "model"), 1, GL_FALSE, &M[0][0]);
-            doorNewObj.draw();
-
-            M = glm::translate(glm::mat4(1.0f), glm::vec3(0.2f, 1.41f, -3.67f));
-            M = glm::rotate(M, glm::radians(door2Angle), glm::vec3(0, 1, 0));
-            glUniformMatrix4fv(glGetUniformLocation(shader, "model"), 1, GL_FALSE, &M[0][0]);
-            doorNew2Obj.draw();
-
-            M = glm::mat4(1.0f);
-            glUniformMatrix4fv(glGetUniformLocation(shader, "model"), 1, GL_FALSE, &M[0][0]);
-            interiorObj.draw();
-            floorObj.draw();
-            roofObj.draw();
-
-            M = glm::translate(glm::mat4(1.0f), sofaPosition);
-            M = glm::rotate(M, glm::radians(sofaRotation), glm::vec3(0, 1, 0));
-            M = glm::scale(M, glm::vec3(1.5f));
-            glUniformMatrix4fv(glGetUniformLocation(shader, "model"), 1, GL_FALSE, &M[0][0]);
-            sofaObj.draw();
-
-            M = glm::translate(glm::mat4(1.0f), glm::vec3(1.5f, 0.5f, 0.0f));
-            M = glm::scale(M, glm::vec3(0.25f));
-            glUniformMatrix4fv(glGetUniformLocation(shader, "model"), 1, GL_FALSE, &M[0][0]);
-            lampObj.draw();
-
-            M = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -1.0f));
-            M = glm::rotate(M, glm::radians(-90.0f), glm::vec3(0, 1, 0));
-            M = glm::scale(M, glm::vec3(0.1f));
-            glUniformMatrix4fv(glGetUniformLocation(shader, "model"), 1, GL_FALSE, &M[0][0]);
-            tableObj.draw();
-
-            glEnable(GL_BLEND);
-            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-            M = glm::translate(glm::mat4(1.0f), glm::vec3(-12.0f, -0.7f, 8.0f));
-            M = glm::scale(M, glm::vec3(0.8f));
-            glUniformMatrix4fv(glGetUniformLocation(shader, "model"), 1, GL_FALSE, &M[0][0]);
-            treeObj.draw();
-
-            M = glm::translate(glm::mat4(1.0f), glm::vec3(12.0f, -0.7f, 6.0f));
-            M = glm::scale(M, glm::vec3(1.0f));
-            glUniformMatrix4fv(glGetUniformLocation(shader, "model"), 1, GL_FALSE, &M[0][0]);
-            treeObj.draw();
-
-            M = glm::translate(glm::mat4(1.0f), glm::vec3(10.0f, -0.7f, -12.0f));
-            M = glm::scale(M, glm::vec3(0.9f));
-            glUniformMatrix4fv(glGetUniformLocation(shader, "model"), 1, GL_FALSE, &M[0][0]);
-            treeObj.draw();
-
-            glDisable(GL_BLEND);
-
-            M = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, -0.7f, 0.0f));
-            M = glm::rotate(M, glm::radians(-90.0f), glm::vec3(1, 0, 0));
-            M = glm::scale(M, glm::vec3(0.1f));
-            glUniformMatrix4fv(glGetUniformLocation(shader, "model"), 1, GL_FALSE, &M[0][0]);
-            groundObj.draw();
-        };
-
-        renderSceneForDepth(depthShader);
+        //randarea scenei in depth map
+        renderQueue.execute(kShadowPass, uniformRing, drawProfiler);
 
         glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        if (gpuProfiler) gpuProfiler->endZone();
+        shadowZone.end();
         //randare scena normala
-        int w, h;
-        glfwGetFramebufferSize(window, &w, &h);
         glViewport(0, 0, w, h);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-        glUseProgram(program);
-        //setare matrici
-        glm::mat4 projection = glm::perspective(glm::radians(fov), (float)w/(float)h, 0.1f, 200.0f);
-        glm::mat4 view = glm::lookAt(camPos, camPos + camFront, camUp);
-        glm::mat4 model(1.0f);
-        //model pune obiecte la pozitia initiala pe scena
-        //view seteaza pozitia si orientarea camerei
-        //projection seteaza perspectiva (fov, aspect ratio, near, far), perspectiva
-        glUniformMatrix4fv(glGetUniformLocation(program, "projection"), 1, GL_FALSE, &projection[0][0]);
-        glUniformMatrix4fv(glGetUniformLocation(program, "view"), 1, GL_FALSE, &view[0][0]);
-        glUniformMatrix4fv(glGetUniformLocation(program, "model"), 1, GL_FALSE, &model[0][0]);
-        glUniformMatrix4fv(glGetUniformLocation(program, "lightSpaceMatrix"), 1, GL_FALSE, &lightSpaceMatrix[0][0]);
-
-        glUniform3f(glGetUniformLocation(program, "viewPos"), camPos.x, camPos.y, camPos.z);
-
-        glActiveTexture(GL_TEXTURE0);
-        glUniform1i(glGetUniformLocation(program, "textureSampler"), 0);
-
+        if (gpuProfiler) gpuProfiler->beginZone(debugMode ? "debug" : "main");
         glActiveTexture(GL_TEXTURE1);
         glBindTexture(GL_TEXTURE_2D, depthMap);
-        glUniform1i(glGetUniformLocation(program, "shadowMap"), 1);
-
-        glUniform3f(glGetUniformLocation(program, "dirLightDir"), -0.2f, -1.0f, -0.3f);
-        glUniform3f(glGetUniformLocation(program, "dirLightColor"), 0.9f, 0.9f, 0.85f);
-
-        glUniform3f(glGetUniformLocation(program, "pointLightPos"), lampPosition.x, lampPosition.y, lampPosition.z);
-        if (lampLightOn) {
-            glUniform3f(glGetUniformLocation(program, "pointLightColor"), 1.0f, 0.9f, 0.7f);
-        } else {
-            glUniform3f(glGetUniformLocation(program, "pointLightColor"), 0.0f, 0.0f, 0.0f);
-        }
-
-        glUniform1i(glGetUniformLocation(program, "fogEnabled"), fogEnabled);
-        glUniform1f(glGetUniformLocation(program, "fogDensity"), 0.08f);
-        glUniform3f(glGetUniformLocation(program, "fogColor"), 0.6f, 0.65f, 0.7f);
+        glActiveTexture(GL_TEXTURE0);
 
+        ProfileZone submitZone("draw submission");
         if (debugMode) {
-            debugRenderer.drawFloorPolygonFilled(floorPoly, floorY, projection, view);
-            debugRenderer.drawFloorPolygonFilled(floorPoly25, floorY25, projection, view);
-
-            debugRenderer.drawFloorBoundary(floorPoly, floorY, projection, view);
-            debugRenderer.drawFloorBoundary(floorPoly25, floorY25, projection, view);
-
-            std::vector<std::vector<glm::vec3>> walls = {
-                {glm::vec3(-0.21f, 0.0f, 6.7f), glm::vec3(-5.4f, 0.0f, 6.7f),
-                 glm::vec3(-5.4f, 3.0f, 6.7f), glm::vec3(-2.3f, 3.0f, 6.7f)},
-                {glm::vec3(-2.3f, 0.0f, 4.4f), glm::vec3(-2.3f, 0.0f, 6.7f),
-                 glm::vec3(-2.3f, 0.5f, 6.7f), glm::vec3(-2.3f, 0.5f, 4.4f)},
-                {glm::vec3(-2.3f, 0.5f, 5.6f), glm::vec3(-2.3f, 0.5f, 6.7f),
-                 glm::vec3(-2.3f, 3.0f, 6.7f), glm::vec3(-2.3f, 3.0f, 5.6f)},
-                {glm::vec3(-2.3f, 0.5f, 4.4f), glm::vec3(-2.3f, 0.5f, 4.8f),
-                 glm::vec3(-2.3f, 3.0f, 4.8f), glm::vec3(-2.3f, 3.0f, 4.4f)},
-                {glm::vec3(-2.3f, 2.29f, 4.8f), glm::vec3(-2.3f, 2.29f, 5.6f),
-                 glm::vec3(-2.3f, 3.0f, 5.6f), glm::vec3(-2.3f, 3.0f, 4.8f)},
-                {glm::vec3(-2.3f, 3.0f, 4.4f), glm::vec3(-2.3f, 0.5f, 4.4f),
-                 glm::vec3(5.7f, 0.5f, 4.4f), glm::vec3(5.7f, 3.0f, 4.4f)},
-                {glm::vec3(5.7f, 3.0f, 4.4f), glm::vec3(5.7f, 0.5f, 4.4f),
-                 glm::vec3(5.7f, 0.5f, -6.0f), glm::vec3(5.7f, 3.0f, -3.7f)},
-                {glm::vec3(5.7f, 0.5f, -3.7f), glm::vec3(1.0f, 0.5f, -3.7f),
-                 glm::vec3(1.0f, 3.0f, -3.7f), glm::vec3(5.7f, 3.0f, -3.7f)},
-                {glm::vec3(0.2f, 0.5f, -3.7f), glm::vec3(-5.4f, 0.5f, -3.7f),
-                 glm::vec3(-5.4f, 3.0f, -3.7f), glm::vec3(0.2f, 3.0f, -3.7f)},
-                {glm::vec3(0.2f, 2.28f, -3.7f), glm::vec3(1.0f, 2.28f, -3.7f),
-                 glm::vec3(1.0f, 3.0f, -3.7f), glm::vec3(0.2f, 3.0f, -3.7f)},
-                {glm::vec3(5.7f, 0.5f, -6.0f), glm::vec3(1.8f, 0.5f, -6.0f),
-                 glm::vec3(1.8f, 3.0f, -6.0f), glm::vec3(5.7f, 3.0f, -6.0f)},
-                {glm::vec3(-1.4f, 0.5f, -6.0f), glm::vec3(-5.4f, 0.5f, -6.0f),
-                 glm::vec3(-5.4f, 3.0f, -6.0f), glm::vec3(-1.4f, 3.0f, -6.0f)},
-                {glm::vec3(-5.4f, 0.5f, -6.0f), glm::vec3(-5.4f, 0.5f, 6.7f),
-                 glm::vec3(-5.4f, 3.0f, 6.7f), glm::vec3(-5.4f, 3.0f, -6.0f)},
-                {glm::vec3(-4.8f, 0.5f, 6.4f), glm::vec3(-4.8f, 0.5f, -3.4f),
-                 glm::vec3(-4.8f, 3.0f, -3.4f), glm::vec3(-4.8f, 3.0f, 6.4f)}
-            };
-            for (const auto& wall : walls) {
-                debugRenderer.drawWallQuad(wall, projection, view);
+            for (uint32_t i = 0; i < scene.floorCount; i++) {
+                const SceneFloor& floor = scene.floors[i];
+                debugRenderer.drawFloorPolygonFilled(scenePolygon(scene, floor.firstPoint, floor.pointCount),
+                                                     floor.y, projection, view);
             }
-            std::vector<std::vector<glm::vec3>> doorFrames = {
-                {glm::vec3(-2.3f, 0.5f, 4.8f), glm::vec3(-2.6f, 0.5f, 4.8f),
-                 glm::vec3(-2.6f, 2.29f, 4.8f), glm::vec3(-2.3f, 2.29f, 4.8f)},
-                {glm::vec3(-2.3f, 0.5f, 5.6f), glm::vec3(-2.3f, 2.29f, 5.6f),
-                 glm::vec3(-2.6f, 2.29f, 5.6f), glm::vec3(-2.6f, 0.5f, 5.6f)},
-                {glm::vec3(-2.3f, 2.29f, 5.6f), glm::vec3(-2.3f, 2.29f, 4.8f),
-                 glm::vec3(-2.6f, 2.29f, 4.8f), glm::vec3(-2.6f, 2.29f, 5.6f)},
-                {glm::vec3(0.2f, 0.5f, -3.4f), glm::vec3(0.2f, 0.5f, -3.7f),
-                 glm::vec3(0.2f, 2.29f, -3.7f), glm::vec3(0.2f, 2.29f, -3.4f)},
-                {glm::vec3(1.0f, 0.5f, -3.7f), glm::vec3(1.0f, 0.5f, -3.4f),
-                 glm::vec3(1.0f, 2.29f, -3.4f), glm::vec3(1.0f, 2.29f, -3.7f)},
-                {glm::vec3(0.2f, 2.29f, -3.7f), glm::vec3(0.2f, 2.29f, -3.4f),
-                 glm::vec3(1.0f, 2.29f, -3.4f), glm::vec3(1.0f, 2.29f, -3.7f)}
-            };
-
-            for (const auto& frame : doorFrames) {
-                debugRenderer.drawWallQuad(frame, projection, view, glm::vec3(1.0f, 1.0f, 0.0f));
+            for (uint32_t i = 0; i < scene.floorCount; i++) {
+                const SceneFloor& floor = scene.floors[i];
+                debugRenderer.drawFloorBoundary(scenePolygon(scene, floor.firstPoint, floor.pointCount),
+                                                floor.y, projection, view);
             }
-
-            debugRenderer.drawDoorCollisionQuad(door1Corners, door1Angle, projection, view);
-            debugRenderer.drawDoorCollisionQuad(door2Corners, door2Angle, projection, view);
-
-            debugRenderer.drawSlope(slopePoints3D, projection, view, glm::vec3(1.0f, 1.0f, 0.0f));
-            debugRenderer.drawSlope(slopePoints3D2, projection, view, glm::vec3(1.0f, 0.5f, 0.0f));
-
-        } else {
-            {//randare obiecte scena
-                glm::mat4 M(1.0f);
-                M = glm::translate(M, glm::vec3(0.0f, 0.0f, 0.0f));
-                M = glm::scale(M, glm::vec3(1.0f));
-                glUniformMatrix4fv(glGetUniformLocation(program, "model"), 1, GL_FALSE, &M[0][0]);
-                houseObj.draw();
+            //peretii si, cu alta culoare, tocurile usilor
+            for (uint32_t i = 0; i < scene.wallCount; i++) {
+                const SceneWall& wall = scene.walls[i];
+                debugRenderer.drawWallQuad(std::vector<glm::vec3>(wall.corners, wall.corners + 4),
+                                           projection, view, wall.debugColor);
             }
 
-            {
-                glm::mat4 M(1.0f);
-                M = glm::translate(M, glm::vec3(-2.41f, 1.41f, 4.89f));
-                M = glm::rotate(M, glm::radians(door1Angle), glm::vec3(0, 1, 0));
-                M = glm::scale(M, glm::vec3(1.0f));
-                glUniformMatrix4fv(glGetUniformLocation(program, "model"), 1, GL_FALSE, &M[0][0]);
-                doorNewObj.draw();
+            for (uint32_t i = 0; i < scene.interactableCount; i++) {
+                const SceneInteractable& door = scene.interactables[i];
+                if (door.kind != SceneInteractableKind::Door) continue;
+                debugRenderer.drawDoorCollisionQuad(std::vector<glm::vec3>(door.corners, door.corners + 4),
+                                                    doorStates[i].angle, projection, view);
             }
 
-            {
-                glm::mat4 M(1.0f);
-                M = glm::translate(M, glm::vec3(0.2f, 1.41f, -3.67f));
-                M = glm::rotate(M, glm::radians(door2Angle), glm::vec3(0, 1, 0));
-                M = glm::scale(M, glm::vec3(1.0f));
-                glUniformMatrix4fv(glGetUniformLocation(program, "model"), 1, GL_FALSE, &M[0][0]);
-                doorNew2Obj.draw();
+            for (uint32_t i = 0; i < scene.slopeCount; i++) {
+                const SceneSlope& slope = scene.slopes[i];
+                debugRenderer.drawSlope(std::vector<glm::vec3>(slope.plane.points, slope.plane.points + 4),
+                                        projection, view, slope.debugColor);
             }
 
-            {
-                glm::mat4 M(1.0f);
-                M = glm::translate(M, glm::vec3(0.0f, 0.0f, 0.0f));
-                M = glm::scale(M, glm::vec3(1.0f));
-                glUniformMatrix4fv(glGetUniformLocation(program, "model"), 1, GL_FALSE, &M[0][0]);
-                interiorObj.draw();
-            }
-
-            {
-                glm::mat4 M(1.0f);
-                M = glm::translate(M, glm::vec3(0.0f, 0.0f, 0.0f));
-                M = glm::scale(M, glm::vec3(1.0f));
-                glUniformMatrix4fv(glGetUniformLocation(program, "model"), 1, GL_FALSE, &M[0][0]);
-                floorObj.draw();
-            }
-
-            {
-                glm::mat4 M(1.0f);
-                M = glm::translate(M, glm::vec3(0.0f, 0.0f, 0.0f));
-                M = glm::scale(M, glm::vec3(1.0f));
-                glUniformMatrix4fv(glGetUniformLocation(program, "model"), 1, GL_FALSE, &M[0][0]);
-                roofObj.draw();
-            }
-
-            {
-                glm::mat4 M(1.0f);
-                M = glm::translate(M, sofaPosition);
-                M = glm::rotate(M, glm::radians(sofaRotation), glm::vec3(0, 1, 0));
-                M = glm::scale(M, glm::vec3(1.5f));
-                glUniformMatrix4fv(glGetUniformLocation(program, "model"), 1, GL_FALSE, &M[0][0]);
-                sofaObj.draw();
-            }
-
-            {
-                glm::mat4 M(1.0f);
-                M = glm::translate(M, glm::vec3(1.5f, 0.5f, 0.0f));
-                M = glm::scale(M, glm::vec3(0.25f));
-                glUniformMatrix4fv(glGetUniformLocation(program, "model"), 1, GL_FALSE, &M[0][0]);
-                lampObj.draw();
-            }
-
-            {
-                glm::mat4 M(1.0f);
-                M = glm::translate(M, glm::vec3(4.1f, 0.5f, 3.30f));
-                M = glm::rotate(M, glm::radians(90.0f), glm::vec3(0, 1, 0));
-                M = glm::scale(M, glm::vec3(0.08f));
-                glUniformMatrix4fv(glGetUniformLocation(program, "model"), 1, GL_FALSE, &M[0][0]);
-                tableObj.draw();
-            }
-
-            {
-                glm::mat4 M(1.0f);
-                M = glm::translate(M, glm::vec3(-12.0f, -0.7f, 8.0f));
-                M = glm::scale(M, glm::vec3(0.8f));
-                glUniformMatrix4fv(glGetUniformLocation(program, "model"), 1, GL_FALSE, &M[0][0]);
-                treeObj.draw();
-            }
-
-            {
-                glm::mat4 M(1.0f);
-                M = glm::translate(M, glm::vec3(12.0f, -0.7f, 6.0f));
-                M = glm::scale(M, glm::vec3(1.0f));
-                glUniformMatrix4fv(glGetUniformLocation(program, "model"), 1, GL_FALSE, &M[0][0]);
-                treeObj.draw();
-            }
-
-            {
-                glm::mat4 M(1.0f);
-                M = glm::translate(M, glm::vec3(10.0f, -0.7f, -12.0f));
-                M = glm::scale(M, glm::vec3(0.9f));
-                glUniformMatrix4fv(glGetUniformLocation(program, "model"), 1, GL_FALSE, &M[0][0]);
-                treeObj.draw();
-            }
-
-            {
-                glm::mat4 M(1.0f);
-                M = glm::translate(M, glm::vec3(0.0f, -0.7f, 0.0f));
-                M = glm::rotate(M, glm::radians(-90.0f), glm::vec3(1, 0, 0));
-                M = glm::scale(M, glm::vec3(0.1f));
-                glUniformMatrix4fv(glGetUniformLocation(program, "model"), 1, GL_FALSE, &M[0][0]);
-                groundObj.draw();
-            }
+        } else {
+            //randare obiecte scena
+            renderQueue.execute(kMainPass, uniformRing, drawProfiler);
         }
+        submitZone.end();
+        if (gpuProfiler) gpuProfiler->endZone();
         //randare skybox, facem ultimul pentru a evita probleme de depth testing
-        if (skyboxTexture != 0) {
+        if (skyboxTexture->state == AssetState::Ready) {
+            PROFILE_ZONE("skybox");
+            GpuZone skyboxZone(gpuProfiler.get(), "skybox");
+            //cerul acopera tot ecranul, vrem mereu nivelul complet
+            streamer.request(skyboxTexture, 0.0f, std::numeric_limits<float>::max());
             glDepthFunc(GL_LEQUAL);
-            glUseProgram(skyboxProgram);
-
-            glm::mat4 skyboxView = glm::mat4(glm::mat3(view));
-            glUniformMatrix4fv(glGetUniformLocation(skyboxProgram, "projection"), 1, GL_FALSE, &projection[0][0]);
-            glUniformMatrix4fv(glGetUniformLocation(skyboxProgram, "view"), 1, GL_FALSE, &skyboxView[0][0]);
+            skyboxProgram.use();
 
             glBindVertexArray(skyboxVAO);
             glActiveTexture(GL_TEXTURE0);
-            glBindTexture(GL_TEXTURE_2D, skyboxTexture);
-            glUniform1i(glGetUniformLocation(skyboxProgram, "skybox"), 0);
+            glBindTexture(GL_TEXTURE_2D, skyboxTexture->id);
+            skyboxProgram.set(skyboxUniforms.skybox, 0);
 
             glDrawArrays(GL_TRIANGLES, 0, 36);
+            renderStats().drawCalls++;
+            renderStats().triangles += 12;
             glBindVertexArray(0);
 
             glDepthFunc(GL_LESS);
         }
 
+        {
+            PROFILE_ZONE("texture streaming");
+            streamer.update();
+        }
+        uniformRing.endFrame();
+        if (gpuProfiler) gpuProfiler->endFrame();
+        if (benchmark) benchmark->endFrame(renderStats().drawCalls, renderStats().triangles);
+        PROFILE_ZONE("swap");
         glfwSwapBuffers(window);
         glfwPollEvents();
     }
+    int exitCode = 0;
+    if (inputRecorder) {
+        std::cout << "Recorded " << inputRecorder->frameCount() << " frames to " << options.recordPath << "\n";
+    }
+    if (replay) {
+        std::cout << "Replayed " << replay->frameCount() << " frames from " << options.replayPath
+                  << (replayDiverged ? " (diverged)" : " (identical)") << "\n";
+        if (replayDiverged) exitCode = 1;
+    }
+    if (benchmark) {
+        benchmark->finish();
+        if (!benchmark->write(options.benchmarkOut, options.width, options.height)) exitCode = 1;
+        benchmark.reset();
+    }
+    if (gpuProfiler) {
+        gpuProfiler->finish();
+        std::cout << "GPU profile: " << options.gpuProfilePath << " (" << gpuProfiler->droppedFrames()
+                  << " frames dropped because results were late)\n";
+        gpuProfiler.reset();
+    }
     //curatare resurse
+    //handle-urile trebuie eliberate inainte sa dispara contextul GL
+    for (ObjModel& obj : models) {
+        obj.release();
+    }
+    skyboxTexture.reset();
+    //mesh-urile eliberate mai sus si-au dat inapoi intervalele; acum se sterg buffer-ele comune
+    releaseGeometryArenas();
+    materialArrays.release();
+    uniformRing.release();
+    assets.shutdown();
+    //dupa oprirea worker-ilor, ca buffer-ele lor sa nu se mai schimbe
+    if (!options.tracePath.empty() && !writeChromeTrace(options.tracePath)) exitCode = 1;
     glfwTerminate();
-    return 0;
+    return exitCode;
 }
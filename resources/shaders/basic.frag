@@ -5,20 +5,26 @@ in vec3 FragPos;
 in vec3 Normal;
 in vec2 TexCoord;
 in vec4 FragPosLightSpace;
+flat in int MaterialLayer;
 
-uniform vec3 viewPos;
 uniform sampler2D textureSampler;
+uniform sampler2DArray materialArray;
 uniform sampler2D shadowMap;
 
-uniform vec3 dirLightDir;
-uniform vec3 dirLightColor;
-
-uniform vec3 pointLightPos;
-uniform vec3 pointLightColor;
-
-uniform bool fogEnabled;
-uniform float fogDensity;
-uniform vec3 fogColor;
+//acelasi bloc ca in basic.vert
+layout (std140) uniform FrameConstants {
+    mat4 projection;
+    mat4 view;
+    mat4 lightSpaceMatrix;
+    vec4 viewPos;
+    vec4 dirLightDir;
+    vec4 dirLightColor;
+    vec4 pointLightPos;
+    vec4 pointLightColor;
+    vec4 fogColor;      //w = densitatea
+    vec4 fogParams;     //x = 1 daca ceata e pornita
+    ivec4 drawParams;   //x = primul texel al instantelor, y = primul texel al desenarilor
+};
 
 // Shadow calculation with PCF (Percentage Closer Filtering)
 float ShadowCalculation(vec4 fragPosLightSpace, vec3 normal, vec3 lightDir)
@@ -60,8 +66,9 @@ float ShadowCalculation(vec4 fragPosLightSpace, vec3 normal, vec3 lightDir)
 
 void main() {
     vec3 n = normalize(Normal);
-    //citim textura
-    vec4 texColor4 = texture(textureSampler, TexCoord);
+    //citim textura; stratul e acelasi in toata desenarea, deci ramura nu strica derivatele pentru mip-uri
+    vec4 texColor4 = MaterialLayer < 0 ? texture(textureSampler, TexCoord)
+                                       : texture(materialArray, vec3(TexCoord, float(MaterialLayer)));
     vec3 texColor = texColor4.rgb;
     //aplha discard pt umbrele la frunze
     // Alpha test for leaves (discard transparent pixels)
@@ -69,7 +76,7 @@ void main() {
         discard;
     }
     //lumina mai precis, daca oare normala obiectului e orientata spre camera sau nu
-    vec3 viewDir = normalize(viewPos - FragPos);
+    vec3 viewDir = normalize(viewPos.xyz - FragPos);
 
     // Two-sided lighting: flip normal if facing away from camera
     if (dot(n, viewDir) < 0.0) {
@@ -80,23 +87,23 @@ void main() {
     vec3 ambient = 0.25 * texColor;
     //0 umbra totala, 1 lumina totala
     // === DIRECTIONAL LIGHT (Sun) ===
-    vec3 lightDir = normalize(-dirLightDir);
+    vec3 lightDir = normalize(-dirLightDir.xyz);
 
     // Diffuse
     float diffD = max(dot(n, lightDir), 0.0);
-    vec3 diffuse = diffD * dirLightColor * texColor;
+    vec3 diffuse = diffD * dirLightColor.rgb * texColor;
 
     // Specular (Blinn-Phong)
     vec3 halfwayDir = normalize(lightDir + viewDir);
     float spec = pow(max(dot(n, halfwayDir), 0.0), 32.0);
-    vec3 specular = spec * dirLightColor * 0.3; // Subtle specular
+    vec3 specular = spec * dirLightColor.rgb * 0.3; // Subtle specular
 
     // Shadow din perspectiva luminii
     float shadow = ShadowCalculation(FragPosLightSpace, n, lightDir);
     vec3 dirLighting = (1.0 - shadow * 0.85) * (diffuse + specular);
 
     // === POINT LIGHT (Interior) ===
-    vec3 l = pointLightPos - FragPos;
+    vec3 l = pointLightPos.xyz - FragPos;
     float dist = length(l);
     vec3 ldirP = normalize(l);
 
@@ -109,7 +116,7 @@ void main() {
 
     // Attenuation (realistic falloff)
     float att = 1.0 / (1.0 + 0.09*dist + 0.032*dist*dist);
-    vec3 pointLighting = (diffP * texColor + specP * 0.2) * pointLightColor * att;
+    vec3 pointLighting = (diffP * texColor + specP * 0.2) * pointLightColor.rgb * att;
 
     // Final color
     vec3 result = ambient + dirLighting + pointLighting;
@@ -118,11 +125,11 @@ void main() {
     result = result / (result + vec3(0.5));
 
     // Apply fog if enabled (isInsideHouse is checked in CPU, not here)
-    if (fogEnabled) {
-        float distance = length(viewPos - FragPos);
-        float fogFactor = exp(-fogDensity * distance);
+    if (fogParams.x > 0.5) {
+        float distance = length(viewPos.xyz - FragPos);
+        float fogFactor = exp(-fogColor.w * distance);
         fogFactor = clamp(fogFactor, 0.0, 1.0);
-        result = mix(fogColor, result, fogFactor);
+        result = mix(fogColor.rgb, result, fogFactor);
     }
     //scrie culoarea finala in buffer
     FragColor = vec4(result, 1.0);
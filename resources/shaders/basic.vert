@@ -2,25 +2,67 @@
 layout (location=0) in vec3 aPos;
 layout (location=1) in vec3 aNormal;
 layout (location=2) in vec2 aTex;
+//indexul desenarii: din baseInstance la multi-draw indirect, altfel constant (glVertexAttribI1ui)
+layout (location=5) in uint aDrawIndex;
 //shaderul principal de varfuri
 //pt lumina,  umbra si ceata
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
-uniform mat4 lightSpaceMatrix;
+//blocul e comun cu depth si skybox (UniformRing.h); transformarile vin per instanta din ring
+layout (std140) uniform FrameConstants {
+    mat4 projection;
+    mat4 view;
+    mat4 lightSpaceMatrix;
+    vec4 viewPos;
+    vec4 dirLightDir;
+    vec4 dirLightColor;
+    vec4 pointLightPos;
+    vec4 pointLightColor;
+    vec4 fogColor;      //w = densitatea
+    vec4 fogParams;     //x = 1 daca ceata e pornita
+    ivec4 drawParams;   //x = primul texel al instantelor, y = primul texel al desenarilor
+};
+//inregistrarea desenarii (x = instanta) si datele instantei (InstanceData din UniformRing.h, 10 texeli)
+uniform usamplerBuffer drawRecords;
+uniform samplerBuffer instanceData;
+
+mat4 fetchMatrix(int texel) {
+    return mat4(texelFetch(instanceData, texel), texelFetch(instanceData, texel + 1),
+                texelFetch(instanceData, texel + 2), texelFetch(instanceData, texel + 3));
+}
 //fragposlight este pozitia varfului in coordonate din punctul de vedere al luminii
 
 out vec3 FragPos;
 out vec3 Normal;
 out vec2 TexCoord;
 out vec4 FragPosLightSpace;
+//stratul din array-ul de materiale (DrawRecord.materialLayer), < 0 pentru textura 2D
+flat out int MaterialLayer;
+
+vec3 octDecode(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    if (n.z < 0.0) {
+        vec2 s = vec2(e.x >= 0.0 ? 1.0 : -1.0, e.y >= 0.0 ? 1.0 : -1.0);
+        n.xy = (1.0 - abs(e.yx)) * s;
+    }
+    return normalize(n);
+}
 
 void main() {
+    uvec4 record = texelFetch(drawRecords, drawParams.y + int(aDrawIndex));
+    int instance = drawParams.x + int(record.x) * 10;
+    MaterialLayer = int(record.y);
+    mat4 model = fetchMatrix(instance);
+    mat4 normalMatrix = fetchMatrix(instance + 4);
+    //pos = aPos * scale + offset pentru varfurile cuantizate; w din scala = 1 cand normala e octaedrica (xy)
+    vec4 quantScale = texelFetch(instanceData, instance + 8);
+    vec4 quantOffset = texelFetch(instanceData, instance + 9);
+    vec3 pos = aPos * quantScale.xyz + quantOffset.xyz;
+    vec3 normal = quantScale.w > 0.5 ? octDecode(aNormal.xy) : aNormal;
     //luam un vertex si ii calculam pozitia in spatiul lumii, normalala si coordonatele de textura
     //world space fragment position
-    FragPos = vec3(model * vec4(aPos, 1.0));
+    FragPos = vec3(model * vec4(pos, 1.0));
     //transformam normalele corect in spatiul lumii
-    Normal  = mat3(transpose(inverse(model))) * aNormal;
+    //normalMatrix vine gata calculata de pe CPU, o data pe instanta
+    Normal  = mat3(normalMatrix) * normal;
     TexCoord = aTex;
     //calculam pozitia varfului in coordonate din punctul de vedere al luminii, si transformam prin lightSpaceMatrix
     FragPosLightSpace = lightSpaceMatrix * vec4(FragPos, 1.0);
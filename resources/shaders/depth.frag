@@ -1,14 +1,18 @@
 #version 330 core
 
 in vec2 TexCoord;
+//ca in basic.frag: < 0 pentru textura 2D, altfel stratul din array-ul de materiale
+flat in int MaterialLayer;
 
 uniform sampler2D textureSampler;
+uniform sampler2DArray materialArray;
 
 void main()
 {
     // Alpha test for leaves (discard transparent pixels)
     //copacii au frunze pe care se vede prin ele, unde alpha e mica le disardam sa nu le mai desenam si umbra sa fie corecta
-    float alpha = texture(textureSampler, TexCoord).a;
+    float alpha = MaterialLayer < 0 ? texture(textureSampler, TexCoord).a
+                                    : texture(materialArray, vec3(TexCoord, float(MaterialLayer))).a;
     if (alpha < 0.5) {
         discard;
     }
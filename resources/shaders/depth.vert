@@ -1,16 +1,41 @@
 #version 330 core
 layout (location = 0) in vec3 aPos;
 layout (location = 2) in vec2 aTexCoord;
+//acelasi index de desenare ca in basic.vert; umbra nu are nevoie de normala
+layout (location = 5) in uint aDrawIndex;
 
 out vec2 TexCoord;
+flat out int MaterialLayer;
 
-uniform mat4 lightSpaceMatrix;
-uniform mat4 model;
+//blocul comun din basic.vert; aici se foloseste doar lightSpaceMatrix
+layout (std140) uniform FrameConstants {
+    mat4 projection;
+    mat4 view;
+    mat4 lightSpaceMatrix;
+    vec4 viewPos;
+    vec4 dirLightDir;
+    vec4 dirLightColor;
+    vec4 pointLightPos;
+    vec4 pointLightColor;
+    vec4 fogColor;      //w = densitatea
+    vec4 fogParams;     //x = 1 daca ceata e pornita
+    ivec4 drawParams;   //x = primul texel al instantelor, y = primul texel al desenarilor
+};
+//aceleasi date per desenare ca in basic.vert
+uniform usamplerBuffer drawRecords;
+uniform samplerBuffer instanceData;
 //folosim sa calculcam umberele, adica din punctul de vedere al luminii ce se vede nu are umbrire si ce nu, are umbrire
 void main()
 {
     TexCoord = aTexCoord;
+    uvec4 record = texelFetch(drawRecords, drawParams.y + int(aDrawIndex));
+    int instance = drawParams.x + int(record.x) * 10;
+    MaterialLayer = int(record.y);
+    mat4 model = mat4(texelFetch(instanceData, instance), texelFetch(instanceData, instance + 1),
+                      texelFetch(instanceData, instance + 2), texelFetch(instanceData, instance + 3));
+    vec4 quantScale = texelFetch(instanceData, instance + 8);
+    vec4 quantOffset = texelFetch(instanceData, instance + 9);
     //lightSpaceMatrix contine proiectia si view din punctul de vedere al luminii'
     //gl_Position este in coordonate  pe care se vede din punctul de vedere al luminii
-    gl_Position = lightSpaceMatrix * model * vec4(aPos, 1.0);
+    gl_Position = lightSpaceMatrix * model * vec4(aPos * quantScale.xyz + quantOffset.xyz, 1.0);
 }
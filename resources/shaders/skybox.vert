@@ -3,8 +3,20 @@ layout (location = 0) in vec3 aPos;
 
 out vec3 TexCoords;
 
-uniform mat4 projection;
-uniform mat4 view;
+//blocul comun din basic.vert; view-ul isi pierde translatia mai jos
+layout (std140) uniform FrameConstants {
+    mat4 projection;
+    mat4 view;
+    mat4 lightSpaceMatrix;
+    vec4 viewPos;
+    vec4 dirLightDir;
+    vec4 dirLightColor;
+    vec4 pointLightPos;
+    vec4 pointLightColor;
+    vec4 fogColor;      //w = densitatea
+    vec4 fogParams;     //x = 1 daca ceata e pornita
+    ivec4 drawParams;   //x = primul texel al instantelor, y = primul texel al desenarilor
+};
 
 void main()
 {
@@ -0,0 +1,36 @@
+#include "Arena.h"
+
+#include <algorithm>
+#include <new>
+
+void* Arena::allocate(size_t size, size_t alignment) {
+    if (!blocks.empty()) {
+        Block& block = blocks.back();
+        uintptr_t address = (uintptr_t)(block.data + block.used);
+        size_t padding = (size_t)((alignment - address % alignment) % alignment);
+        if (block.used + padding + size <= block.size) {
+            block.used += padding;
+            void* p = block.data + block.used;
+            block.used += size;
+            return p;
+        }
+    }
+    //alocarile mari primesc blocul lor, ca sa nu risipim restul blocului curent
+    size_t bytes = std::max(blockSize, size + alignment);
+    Block block;
+    block.data = static_cast<uint8_t*>(::operator new(bytes));
+    block.size = bytes;
+    uintptr_t address = (uintptr_t)block.data;
+    size_t padding = (size_t)((alignment - address % alignment) % alignment);
+    block.used = padding + size;
+    reserved += bytes;
+    peak = std::max(peak, reserved);
+    blocks.push_back(block);
+    return block.data + padding;
+}
+
+void Arena::release() {
+    for (const Block& block : blocks) ::operator delete(block.data);
+    blocks.clear();
+    reserved = 0;
+}
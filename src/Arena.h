@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//alocator liniar pentru datele temporare ale unei incarcari: blocuri mari, eliberate toate odata
+//nu apeleaza constructori/destructori, deci e doar pentru tipuri triviale
+class Arena {
+public:
+    explicit Arena(size_t blockSize = 1 << 20) : blockSize(blockSize) {}
+    ~Arena() { release(); }
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+    template <typename T>
+    T* allocateArray(size_t count) {
+        return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void release();
+    //memoria luata de la sistem acum si maximul de pana acum (nu scade la release)
+    size_t reservedBytes() const { return reserved; }
+    size_t peakBytes() const { return peak; }
+
+private:
+    struct Block {
+        uint8_t* data;
+        size_t size;
+        size_t used;
+    };
+
+    size_t blockSize;
+    std::vector<Block> blocks;
+    size_t reserved = 0;
+    size_t peak = 0;
+};
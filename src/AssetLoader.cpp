@@ -0,0 +1,169 @@
+#include "AssetLoader.h"
+#include "AssetRegistry.h"
+#include "Profiler.h"
+#include "Texture.h"
+#include "TextureStreamer.h"
+
+#include <chrono>
+#include <iostream>
+
+AssetLoader::AssetLoader(unsigned workerCount) : loadOptions(queryTextureLoadOptions()) {
+    if (workerCount == 0) {
+        unsigned hw = std::thread::hardware_concurrency();
+        workerCount = hw > 1 ? hw - 1 : 1;
+    }
+    for (unsigned i = 0; i < workerCount; i++) {
+        workers.emplace_back(&AssetLoader::workerLoop, this);
+    }
+}
+
+AssetLoader::~AssetLoader() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    jobAvailable.notify_all();
+    for (auto& worker : workers) {
+        if (worker.joinable()) worker.join();
+    }
+}
+
+void AssetLoader::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        jobs.clear();
+    }
+    jobAvailable.notify_all();
+    for (auto& worker : workers) {
+        if (worker.joinable()) worker.join();
+    }
+    workers.clear();
+    uploads.clear();
+    pending = 0;
+    if (pbo != 0) {
+        glDeleteBuffers(1, &pbo);
+        pbo = 0;
+    }
+}
+
+void AssetLoader::workerLoop() {
+    profilerSetThreadName("asset worker");
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            jobAvailable.wait(lock, [this] { return stopping || !jobs.empty(); });
+            if (stopping) return;
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+        ProfileZone jobZone("asset job");
+        UploadTask upload = job();
+        jobZone.end();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            //si un job fara upload trece prin coada, ca pending sa scada pe thread-ul GL
+            uploads.push_back(upload ? std::move(upload) : UploadTask([] {}));
+        }
+        uploadAvailable.notify_one();
+    }
+}
+
+void AssetLoader::submit(Job job) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.push_back(std::move(job));
+        pending++;
+    }
+    jobAvailable.notify_one();
+}
+
+TextureHandle AssetLoader::loadTexture(const std::string& path, TextureUsage usage, int maxDimension) {
+    TextureLoadOptions options = loadOptions;
+    if (maxDimension >= 0) options.maxDimension = maxDimension;
+    bool created = false;
+    TextureHandle texture = assetRegistry().acquireTexture(path, textureVariant(usage, options.maxDimension), created);
+    if (!created) return texture;
+    submit([this, texture, usage, options]() -> UploadTask {
+        PROFILE_ZONE("prepare texture");
+        auto prepared = std::make_shared<PreparedTexture>();
+        if (!prepareTexture(texture->path, usage, options, *prepared)) {
+            return [texture] { texture->state = AssetState::Failed; };
+        }
+        return [this, texture, usage, prepared, options] {
+            //texturile de material raman complete, ca MaterialArrays sa le poata pune in acelasi array
+            bool streamed = usage != TextureUsage::Material && streamer &&
+                            streamer->adopt(texture, prepared, pixelUnpackBuffer());
+            if (!streamed) {
+                texture->id = uploadPreparedTexture(*prepared, options.immutableStorage, texture->gpuBytes,
+                                                    pixelUnpackBuffer());
+                texture->width = prepared->width();
+                texture->height = prepared->height();
+                texture->levelCount = prepared->levelCount();
+            }
+            texture->state = AssetState::Ready;
+            int width = prepared->width(), height = prepared->height();
+            std::cout << "Loaded texture: " << texture->path << " (" << width << "x" << height;
+            if (width != prepared->sourceWidth || height != prepared->sourceHeight) {
+                std::cout << ", from " << prepared->sourceWidth << "x" << prepared->sourceHeight;
+            }
+            std::cout << (prepared->compressed ? ", compressed" : "") << (streamed ? ", streamed" : "")
+                      << ", " << texture->gpuBytes / 1024 << " KB resident)\n";
+        };
+    });
+    return texture;
+}
+
+GLuint AssetLoader::pixelUnpackBuffer() {
+    if (pbo == 0) glGenBuffers(1, &pbo);
+    return pbo;
+}
+
+bool AssetLoader::runOneUpload() {
+    UploadTask upload;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (uploads.empty()) return false;
+        upload = std::move(uploads.front());
+        uploads.pop_front();
+    }
+    {
+        PROFILE_ZONE("asset upload");
+        upload();
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    pending--;
+    return true;
+}
+
+void AssetLoader::processUploads(double budgetMs) {
+    auto start = std::chrono::steady_clock::now();
+    while (runOneUpload()) {
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        if (elapsed.count() >= budgetMs) break;
+    }
+}
+
+void AssetLoader::waitUntil(const std::function<bool()>& done) {
+    while (!done()) {
+        if (runOneUpload()) continue;
+        std::unique_lock<std::mutex> lock(mutex);
+        if (pending == 0) break;
+        uploadAvailable.wait(lock, [this] { return !uploads.empty(); });
+    }
+}
+
+void AssetLoader::wait(const TextureHandle& texture) {
+    if (!texture) return;
+    waitUntil([&texture] { return texture->state != AssetState::Pending; });
+}
+
+void AssetLoader::waitIdle() {
+    waitUntil([this] { return pendingCount() == 0; });
+}
+
+size_t AssetLoader::pendingCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return pending;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "AssetTypes.h"
+#include "Texture.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class TextureStreamer;
+
+//decodarea si parsarea ruleaza pe un pool de worker-i; ce trebuie facut in OpenGL
+//se intoarce ca o continuare care ruleaza pe thread-ul GL in processUploads/wait
+class AssetLoader {
+public:
+    using UploadTask = std::function<void()>;
+    using Job = std::function<UploadTask()>;
+
+    //workerCount = 0 foloseste hardware_concurrency - 1 (minim 1)
+    //se construieste pe thread-ul GL, dupa glewInit (afla ce formate de textura avem)
+    explicit AssetLoader(unsigned workerCount = 0);
+    ~AssetLoader();
+
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+
+    //job ruleaza pe un worker; continuarea intoarsa (poate fi goala) ruleaza pe thread-ul GL
+    void submit(Job job);
+    //textura vine din registru; daca e deja incarcata (sau in curs) nu mai trimite nimic
+    //pe worker se foloseste varianta comprimata din cache sau se comprima acum
+    //maxDimension < 0 foloseste limita globala, 0 pastreaza rezolutia sursei
+    //TextureUsage::Material nu trece prin TextureStreamer (ramane cu toate nivelurile)
+    TextureHandle loadTexture(const std::string& path, TextureUsage usage = TextureUsage::Color,
+                              int maxDimension = -1);
+
+    //ruleaza upload-urile terminate, dar nu mai mult de budgetMs intr-un cadru
+    void processUploads(double budgetMs = 2.0);
+    //blocheaza thread-ul GL (urcand ce se termina intre timp) pana cand done() e adevarat
+    void waitUntil(const std::function<bool()>& done);
+    void wait(const TextureHandle& texture);
+    void waitIdle();
+    size_t pendingCount() const;
+
+    //opreste worker-ii si sterge PBO-ul; se apeleaza cat timp contextul GL mai exista
+    void shutdown();
+
+    GLuint pixelUnpackBuffer();
+    const TextureLoadOptions& textureLoadOptions() const { return loadOptions; }
+    //texturile comprimate mari incarcate de acum incolo pornesc doar cu mip-urile mici
+    //si raman in grija streamer-ului (nullptr le urca intregi)
+    void setTextureStreamer(TextureStreamer* textureStreamer) { streamer = textureStreamer; }
+    //limita globala pentru texturile cerute de acum incolo (0 = fara limita)
+    void setMaxTextureDimension(int maxDimension) { loadOptions.maxDimension = maxDimension; }
+
+private:
+    void workerLoop();
+    bool runOneUpload();
+
+    std::vector<std::thread> workers;
+    std::deque<Job> jobs;
+    std::deque<UploadTask> uploads;
+    mutable std::mutex mutex;
+    std::condition_variable jobAvailable;
+    std::condition_variable uploadAvailable;
+    size_t pending = 0;     //cereri trimise al caror upload nu a rulat inca
+    bool stopping = false;
+    GLuint pbo = 0;
+    TextureLoadOptions loadOptions;
+    TextureStreamer* streamer = nullptr;
+};
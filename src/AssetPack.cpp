@@ -0,0 +1,290 @@
+#include "AssetPack.h"
+#include "Hash.h"
+#include "Lz.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+
+namespace {
+
+const char kAssetPackMagic[4] = { 'A', 'P', 'A', 'K' };
+
+struct AssetPackHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t reserved;
+    uint64_t tocOffset;
+    uint64_t tocSize;
+};
+
+//in tabela de continut, fiecare intrare e urmata de nume
+struct AssetPackTocEntry {
+    uint64_t offset;
+    uint64_t storedSize;
+    uint64_t rawSize;
+    uint64_t sourceHash;
+    uint64_t sourceSize;
+    int64_t sourceMtime;
+    uint64_t sourceContentHash;
+    uint32_t flags;
+    uint32_t nameLength;
+};
+
+bool statSources(const std::vector<std::string>& paths, uint64_t& size, int64_t& mtime) {
+    size = 0;
+    mtime = 0;
+    for (size_t i = 0; i < paths.size(); i++) {
+        std::error_code ec;
+        auto fileSize = std::filesystem::file_size(paths[i], ec);
+        if (ec) return false;
+        auto writeTime = std::filesystem::last_write_time(paths[i], ec);
+        if (ec) return false;
+        size += (uint64_t)fileSize;
+        //epoca ceasului de fisiere poate fi dupa 1970, deci valorile pot fi negative
+        int64_t time = (int64_t)writeTime.time_since_epoch().count();
+        mtime = i == 0 ? time : std::max(mtime, time);
+    }
+    return true;
+}
+
+bool hashSources(const std::vector<std::string>& paths, uint64_t& hash) {
+    hash = kFnvOffsetBasis;
+    for (const auto& path : paths) {
+        MappedFile file;
+        if (!file.open(path)) return false;
+        hash = hashBytes(file.data(), file.size(), hash);
+    }
+    return true;
+}
+
+} // namespace
+
+bool stampSources(const std::vector<std::string>& paths, SourceStamp& stamp) {
+    return statSources(paths, stamp.size, stamp.mtime) && hashSources(paths, stamp.hash);
+}
+
+bool AssetPack::open(const std::string& path) {
+    close();
+    MappedFile mapped;
+    if (!mapped.open(path)) return false;
+
+    AssetPackHeader header;
+    if (mapped.size() < sizeof(header)) {
+        std::cerr << "Asset pack too small: " << path << "\n";
+        return false;
+    }
+    std::memcpy(&header, mapped.data(), sizeof(header));
+    if (std::memcmp(header.magic, kAssetPackMagic, 4) == 0 && header.version != kAssetPackVersion) {
+        std::cerr << "Asset pack " << path << " has version " << header.version << ", expected "
+                  << kAssetPackVersion << "; run asset_cooker again\n";
+        return false;
+    }
+    if (std::memcmp(header.magic, kAssetPackMagic, 4) != 0 ||
+        header.tocOffset > mapped.size() || header.tocSize > mapped.size() - header.tocOffset) {
+        std::cerr << "Invalid asset pack: " << path << "\n";
+        return false;
+    }
+
+    std::vector<PackEntry> entries;
+    const uint8_t* p = mapped.data() + header.tocOffset;
+    const uint8_t* end = p + header.tocSize;
+    for (uint32_t i = 0; i < header.entryCount; i++) {
+        AssetPackTocEntry toc;
+        if ((size_t)(end - p) < sizeof(toc)) break;
+        std::memcpy(&toc, p, sizeof(toc));
+        p += sizeof(toc);
+        if ((size_t)(end - p) < toc.nameLength) break;
+        if (toc.offset > header.tocOffset || toc.storedSize > header.tocOffset - toc.offset) break;
+        if (!(toc.flags & kPackEntryLz) && toc.rawSize != toc.storedSize) break;
+        PackEntry entry;
+        entry.name.assign(reinterpret_cast<const char*>(p), toc.nameLength);
+        p += toc.nameLength;
+        entry.offset = toc.offset;
+        entry.storedSize = toc.storedSize;
+        entry.rawSize = toc.rawSize;
+        entry.sourceHash = toc.sourceHash;
+        entry.source.size = toc.sourceSize;
+        entry.source.mtime = toc.sourceMtime;
+        entry.source.hash = toc.sourceContentHash;
+        entry.flags = toc.flags;
+        entries.push_back(std::move(entry));
+    }
+    if (entries.size() != header.entryCount) {
+        std::cerr << "Corrupt asset pack table: " << path << "\n";
+        return false;
+    }
+
+    file = std::move(mapped);
+    entryList = std::move(entries);
+    for (size_t i = 0; i < entryList.size(); i++) index[entryList[i].name] = i;
+    return true;
+}
+
+void AssetPack::close() {
+    file.close();
+    entryList.clear();
+    index.clear();
+    staleReported.clear();
+}
+
+const PackEntry* AssetPack::find(const std::string& name) const {
+    auto it = index.find(name);
+    return it == index.end() ? nullptr : &entryList[it->second];
+}
+
+bool AssetPack::read(const PackEntry& entry, PackBlob& out) const {
+    const uint8_t* stored = storedData(entry);
+    if (!(entry.flags & kPackEntryLz)) {
+        out.storage.clear();
+        out.data = stored;
+        out.size = (size_t)entry.rawSize;
+        return true;
+    }
+    out.storage.resize((size_t)entry.rawSize);
+    if (!lzDecompress(stored, (size_t)entry.storedSize, out.storage.data(), out.storage.size())) {
+        std::cerr << "Corrupt asset pack entry: " << entry.name << "\n";
+        out.storage.clear();
+        return false;
+    }
+    out.data = out.storage.data();
+    out.size = out.storage.size();
+    return true;
+}
+
+bool AssetPack::read(const std::string& name, PackBlob& out) const {
+    const PackEntry* entry = find(name);
+    return entry && read(*entry, out);
+}
+
+bool AssetPack::readFresh(const std::string& name, const std::vector<std::string>& sources, PackBlob& out) const {
+    const PackEntry* entry = find(name);
+    if (!entry) return false;
+    std::error_code ec;
+    if (!sources.empty() && std::filesystem::exists(sources[0], ec)) {
+        uint64_t size;
+        int64_t mtime;
+        uint64_t hash;
+        bool fresh = statSources(sources, size, mtime) && size == entry->source.size &&
+                     (mtime == entry->source.mtime || (hashSources(sources, hash) && hash == entry->source.hash));
+        if (!fresh) {
+            //o intrare poate fi ceruta de mai multe ori (ex. scena, inainte si dupa recompilare)
+            std::lock_guard<std::mutex> lock(staleMutex);
+            if (staleReported.insert(name).second) {
+                std::cerr << "Asset pack entry " << name << " does not match " << sources[0]
+                          << ", using the loose files"
+                          << (staleReported.size() == 1 ? " (run asset_cooker to refresh the pack)" : "") << "\n";
+            }
+            return false;
+        }
+    }
+    return read(*entry, out);
+}
+
+bool AssetPackWriter::begin(const std::string& path) {
+    finalPath = path;
+    tmpPath = path + ".tmp";
+    entryList.clear();
+    out.open(tmpPath, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "Cannot write asset pack: " << tmpPath << "\n";
+        return false;
+    }
+    //antetul se completeaza la finish
+    AssetPackHeader header = {};
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    position = sizeof(header);
+    return (bool)out;
+}
+
+bool AssetPackWriter::writeAligned(const uint8_t* data, size_t size, uint64_t& offset) {
+    static const char padding[kPackAlignment] = {};
+    size_t pad = (size_t)((kPackAlignment - position % kPackAlignment) % kPackAlignment);
+    out.write(padding, (std::streamsize)pad);
+    position += pad;
+    offset = position;
+    out.write(reinterpret_cast<const char*>(data), (std::streamsize)size);
+    position += size;
+    return (bool)out;
+}
+
+bool AssetPackWriter::add(const std::string& name, const uint8_t* data, size_t size, uint64_t sourceHash,
+                          const SourceStamp& source, bool tryLz) {
+    PackEntry entry;
+    entry.name = name;
+    entry.rawSize = size;
+    entry.sourceHash = sourceHash;
+    entry.source = source;
+
+    std::vector<uint8_t> packed;
+    if (tryLz && size > 0) lzCompress(data, size, packed);
+    bool useLz = tryLz && size > 0 && packed.size() <= size - size / 8;
+    if (useLz) {
+        entry.flags = kPackEntryLz;
+        data = packed.data();
+        size = packed.size();
+    }
+    entry.storedSize = size;
+    if (!writeAligned(data, size, entry.offset)) return false;
+    entryList.push_back(std::move(entry));
+    return true;
+}
+
+bool AssetPackWriter::addStored(const PackEntry& entry, const uint8_t* stored, const SourceStamp& source) {
+    PackEntry copy = entry;
+    copy.source = source;
+    if (!writeAligned(stored, (size_t)entry.storedSize, copy.offset)) return false;
+    entryList.push_back(std::move(copy));
+    return true;
+}
+
+bool AssetPackWriter::finish() {
+    AssetPackHeader header = {};
+    std::memcpy(header.magic, kAssetPackMagic, 4);
+    header.version = kAssetPackVersion;
+    header.entryCount = (uint32_t)entryList.size();
+    header.tocOffset = position;
+    for (const auto& entry : entryList) {
+        AssetPackTocEntry toc = { entry.offset, entry.storedSize, entry.rawSize, entry.sourceHash,
+                                  entry.source.size, entry.source.mtime, entry.source.hash,
+                                  entry.flags, (uint32_t)entry.name.size() };
+        out.write(reinterpret_cast<const char*>(&toc), sizeof(toc));
+        out.write(entry.name.data(), (std::streamsize)entry.name.size());
+        position += sizeof(toc) + entry.name.size();
+    }
+    header.tocSize = position - header.tocOffset;
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.close();
+    if (out.fail()) {
+        std::cerr << "Cannot write asset pack: " << tmpPath << "\n";
+        return false;
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmpPath, finalPath, ec);
+    if (ec) {
+        std::cerr << "Cannot replace asset pack: " << finalPath << "\n";
+        std::filesystem::remove(tmpPath, ec);
+        return false;
+    }
+    return true;
+}
+
+std::string packEntryName(const std::string& path) {
+    std::string name = path;
+    for (char& c : name) {
+        if (c == '\\') c = '/';
+    }
+    while (name.compare(0, 2, "./") == 0) name.erase(0, 2);
+    //ex. "resources/models/house/./tex.png" din baseDir + nume din MTL
+    size_t dot;
+    while ((dot = name.find("/./")) != std::string::npos) name.erase(dot, 2);
+    return name;
+}
+
+AssetPack& assetPack() {
+    static AssetPack pack;
+    return pack;
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "MappedFile.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+//un singur fisier cu toate resursele gatite (meshcache, DDS, shadere), construit de asset_cooker
+//antet, apoi intrarile aliniate la kPackAlignment, apoi tabela de continut la final
+//numele intrarilor sunt caile relative la directorul de lucru, cu '/'
+//(ex. resources/models/house/house.obj.meshcache), deci pack-ul acopera exact fisierele de cache
+//fiecare intrare tine si amprenta fisierelor sursa, ca la rulare o sursa editata sa castige in fata pack-ului
+constexpr uint32_t kAssetPackVersion = 2;
+//varfurile din meshcache sunt aliniate la 16 fata de inceputul intrarii
+constexpr size_t kPackAlignment = 64;
+
+constexpr uint32_t kPackEntryLz = 1;    //intrarea e comprimata cu lzCompress
+
+//fisierele din care s-a gatit o intrare, fara setarile gatirii: marimea totala, cel mai nou mtime, hash-ul continutului
+struct SourceStamp {
+    uint64_t size = 0;
+    int64_t mtime = 0;
+    uint64_t hash = 0;
+};
+//false daca vreun fisier nu se poate citi
+bool stampSources(const std::vector<std::string>& paths, SourceStamp& stamp);
+
+struct PackEntry {
+    std::string name;
+    uint64_t offset = 0;        //fata de inceputul fisierului
+    uint64_t storedSize = 0;    //cat ocupa in pack
+    uint64_t rawSize = 0;       //dupa decomprimare
+    uint64_t sourceHash = 0;    //sursa + setarile de gatire, pentru re-gatirea incrementala
+    SourceStamp source;         //doar sursa, comparata la rulare cu fisierele de langa pack
+    uint32_t flags = 0;
+};
+
+//continutul unei intrari: direct in maparea pack-ului, sau decomprimat in storage
+struct PackBlob {
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    std::vector<uint8_t> storage;
+};
+
+class AssetPack {
+public:
+    //false (fara mesaj) daca fisierul lipseste; mesaj daca e corupt
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return file.isOpen(); }
+
+    const PackEntry* find(const std::string& name) const;
+    //intrarile necomprimate nu se copiaza; blob-ul e valid cat timp pack-ul e deschis
+    bool read(const PackEntry& entry, PackBlob& out) const;
+    bool read(const std::string& name, PackBlob& out) const;
+    //ca read, dar refuza (cu un avertisment) intrarea ale carei surse exista si s-au schimbat de la gatire,
+    //ca apelantul sa treaca la fisierele separate; fara surse (pack livrat singur) intrarea e folosita
+    //sources[0] e sursa principala; mtime-ul egal scuteste hash-ul
+    bool readFresh(const std::string& name, const std::vector<std::string>& sources, PackBlob& out) const;
+    //bytes-ii asa cum sunt stocati (eventual comprimati), pentru copierea intr-un pack nou
+    const uint8_t* storedData(const PackEntry& entry) const { return file.data() + entry.offset; }
+    const std::vector<PackEntry>& entries() const { return entryList; }
+
+private:
+    MappedFile file;
+    std::vector<PackEntry> entryList;
+    std::unordered_map<std::string, size_t> index;
+    //intrarile deja raportate ca vechi (readFresh se apeleaza si de pe worker-i)
+    mutable std::mutex staleMutex;
+    mutable std::unordered_set<std::string> staleReported;
+};
+
+//scrie un pack nou in <path>.tmp si il redenumeste la finish
+class AssetPackWriter {
+public:
+    bool begin(const std::string& path);
+    //tryLz: comprima intrarea daca asa se castiga macar 1/8 din marime
+    bool add(const std::string& name, const uint8_t* data, size_t size, uint64_t sourceHash,
+             const SourceStamp& source, bool tryLz);
+    //copiaza o intrare neschimbata dintr-un pack vechi, fara sa o decomprime; amprenta e cea de acum
+    bool addStored(const PackEntry& entry, const uint8_t* stored, const SourceStamp& source);
+    bool finish();
+
+private:
+    bool writeAligned(const uint8_t* data, size_t size, uint64_t& offset);
+
+    std::string finalPath;
+    std::string tmpPath;
+    std::ofstream out;
+    uint64_t position = 0;
+    std::vector<PackEntry> entryList;
+};
+
+//normalizeaza o cale in nume de intrare: '\' devine '/', fara "./" in fata
+std::string packEntryName(const std::string& path);
+
+//pack-ul folosit la rulare; inchis pana cand main il deschide, caz in care totul vine din fisiere separate
+//se deschide inainte de primele incarcari, apoi e doar citit (si de pe worker-i)
+AssetPack& assetPack();
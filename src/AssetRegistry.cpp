@@ -0,0 +1,146 @@
+#include "AssetRegistry.h"
+#include "Hash.h"
+#include "MappedFile.h"
+
+#include <algorithm>
+#include <filesystem>
+
+namespace {
+
+bool hashFile(const std::string& path, uint64_t& hash) {
+    MappedFile file;
+    if (!file.open(path)) return false;
+    hash = hashBytes(file.data(), file.size());
+    return true;
+}
+
+void destroyTexture(TextureAsset* texture) {
+    //array-urile de materiale sunt sterse de MaterialArrays
+    if (texture->id != 0 && texture->target == GL_TEXTURE_2D) glDeleteTextures(1, &texture->id);
+    delete texture;
+}
+
+void destroyMesh(MeshAsset* mesh) {
+    if (mesh->arena) mesh->arena->free(mesh->arenaRange);
+    if (mesh->EBO != 0) glDeleteBuffers(1, &mesh->EBO);
+    if (mesh->VBO != 0) glDeleteBuffers(1, &mesh->VBO);
+    delete mesh;
+}
+
+} // namespace
+
+AssetRegistry& assetRegistry() {
+    static AssetRegistry registry;
+    return registry;
+}
+
+TextureHandle makeReadyTexture(GLuint id, const std::string& path) {
+    auto texture = std::make_shared<TextureAsset>();
+    texture->path = path;
+    texture->id = id;
+    texture->state = id ? AssetState::Ready : AssetState::Failed;
+    return texture;
+}
+
+AssetRegistry::Entry* AssetRegistry::findEntry(std::vector<Entry>& entries, const std::string& path, int variant,
+                                               bool sameDirectory, uint64_t& fileSize, std::string& canonicalPath) {
+    //intrarile ale caror handle-uri au fost eliberate nu mai conteaza
+    entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                 [](const Entry& e) { return e.asset.expired(); }),
+                  entries.end());
+
+    std::error_code ec;
+    canonicalPath = std::filesystem::weakly_canonical(path, ec).generic_string();
+    if (ec) canonicalPath = path;
+    for (auto& e : entries) {
+        if (e.variant == variant && e.canonicalPath == canonicalPath) return &e;
+    }
+
+    fileSize = (uint64_t)std::filesystem::file_size(canonicalPath, ec);
+    if (ec || fileSize == 0) {
+        fileSize = 0;
+        return nullptr;
+    }
+    //continutul il comparam doar cu fisierele de aceeasi marime
+    std::filesystem::path directory = std::filesystem::path(canonicalPath).parent_path();
+    uint64_t hash = 0;
+    bool hashed = false;
+    for (auto& e : entries) {
+        if (e.variant != variant || e.fileSize != fileSize) continue;
+        if (sameDirectory && std::filesystem::path(e.canonicalPath).parent_path() != directory) continue;
+        if (!hashed) {
+            if (!hashFile(canonicalPath, hash)) return nullptr;
+            hashed = true;
+        }
+        if (!e.hashed) {
+            if (!hashFile(e.canonicalPath, e.contentHash)) continue;
+            e.hashed = true;
+        }
+        if (e.contentHash == hash) return &e;
+    }
+    return nullptr;
+}
+
+TextureHandle AssetRegistry::acquireTexture(const std::string& path, int variant, bool& created) {
+    uint64_t fileSize = 0;
+    std::string canonicalPath;
+    if (Entry* e = findEntry(textures, path, variant, false, fileSize, canonicalPath)) {
+        created = false;
+        return std::static_pointer_cast<TextureAsset>(e->asset.lock());
+    }
+
+    TextureHandle texture(new TextureAsset(), destroyTexture);
+    texture->path = path;
+    Entry entry;
+    entry.canonicalPath = canonicalPath;
+    entry.variant = variant;
+    entry.fileSize = fileSize;
+    entry.asset = texture;
+    textures.push_back(entry);
+    created = true;
+    return texture;
+}
+
+MeshHandle AssetRegistry::acquireMesh(const std::string& path, int variant, bool& created) {
+    uint64_t fileSize = 0;
+    std::string canonicalPath;
+    //acelasi OBJ in alt director are alte MTL-uri si alte texturi
+    if (Entry* e = findEntry(meshes, path, variant, true, fileSize, canonicalPath)) {
+        created = false;
+        return std::static_pointer_cast<MeshAsset>(e->asset.lock());
+    }
+
+    MeshHandle mesh(new MeshAsset(), destroyMesh);
+    mesh->path = path;
+    Entry entry;
+    entry.canonicalPath = canonicalPath;
+    entry.variant = variant;
+    entry.fileSize = fileSize;
+    entry.asset = mesh;
+    meshes.push_back(entry);
+    created = true;
+    return mesh;
+}
+
+AssetMemoryStats AssetRegistry::stats() const {
+    AssetMemoryStats stats;
+    for (const auto& e : textures) {
+        if (auto texture = std::static_pointer_cast<TextureAsset>(e.asset.lock())) {
+            stats.textureCount++;
+            stats.textureBytes += texture->gpuBytes;
+        }
+    }
+    for (const auto& e : meshes) {
+        if (auto mesh = std::static_pointer_cast<MeshAsset>(e.asset.lock())) {
+            stats.meshCount++;
+            stats.meshBytes += mesh->gpuBytes;
+        }
+    }
+    return stats;
+}
+
+void AssetRegistry::report(std::ostream& out) const {
+    AssetMemoryStats s = stats();
+    out << "Assets: textures=" << s.textureCount << " (" << s.textureBytes / (1024.0 * 1024.0) << " MB)"
+        << " meshes=" << s.meshCount << " (" << s.meshBytes / (1024.0 * 1024.0) << " MB)\n";
+}
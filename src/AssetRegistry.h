@@ -0,0 +1,53 @@
+#pragma once
+
+#include "AssetTypes.h"
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+struct AssetMemoryStats {
+    size_t textureCount = 0;
+    size_t textureBytes = 0;
+    size_t meshCount = 0;
+    size_t meshBytes = 0;
+};
+
+//registrul tine doar weak_ptr-uri: resursa OpenGL e stearsa cand dispare ultimul handle
+//cheia e calea canonica; doua fisiere diferite cu acelasi continut primesc acelasi handle
+//(hash-ul se calculeaza doar cand exista deja o resursa cu aceeasi marime de fisier)
+//la mesh-uri continutul se compara doar in acelasi director: MTL-urile si texturile lor se cauta langa OBJ
+//se foloseste doar de pe thread-ul GL, iar handle-urile se elibereaza tot acolo
+class AssetRegistry {
+public:
+    //created = true cand handle-ul e nou si apelantul trebuie sa il incarce
+    //variant separa versiunile aceleiasi surse (ex. formatul varfurilor, folosirea texturii)
+    TextureHandle acquireTexture(const std::string& path, int variant, bool& created);
+    MeshHandle acquireMesh(const std::string& path, int variant, bool& created);
+
+    AssetMemoryStats stats() const;
+    void report(std::ostream& out) const;
+
+private:
+    struct Entry {
+        std::string canonicalPath;
+        int variant = 0;
+        uint64_t fileSize = 0;
+        uint64_t contentHash = 0;
+        bool hashed = false;
+        std::weak_ptr<void> asset;
+    };
+
+    //sameDirectory: potrivirea dupa continut cere si acelasi director canonic
+    Entry* findEntry(std::vector<Entry>& entries, const std::string& path, int variant, bool sameDirectory,
+                     uint64_t& fileSize, std::string& canonicalPath);
+
+    std::vector<Entry> textures;
+    std::vector<Entry> meshes;
+};
+
+AssetRegistry& assetRegistry();
+
+//o textura urcata in afara registrului (ex. render target); registrul nu o sterge
+TextureHandle makeReadyTexture(GLuint id, const std::string& path = "");
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "GeometryArena.h"
+#include "VertexPacking.h"
+
+enum class AssetState {
+    Pending,
+    Ready,
+    Failed
+};
+
+//o textura din registru; campurile se schimba doar pe thread-ul GL
+struct TextureAsset {
+    std::string path;
+    GLuint id = 0;
+    AssetState state = AssetState::Pending;
+    size_t gpuBytes = 0;    //doar nivelurile rezidente
+    //dimensiunile nivelului 0; baseLevel > 0 cand nivelurile mari nu sunt (inca) pe GPU
+    int width = 0;
+    int height = 0;
+    int levelCount = 1;
+    int baseLevel = 0;
+    //dupa MaterialArrays::build id poate fi un GL_TEXTURE_2D_ARRAY comun (al lui MaterialArrays), cu textura in layer
+    GLenum target = GL_TEXTURE_2D;
+    int layer = 0;
+};
+using TextureHandle = std::shared_ptr<TextureAsset>;
+
+//un grup se deseneaza cu glDrawElementsBaseVertex din EBO-ul comun
+//pentru mesh-urile din arena offset-ul si baseVertex sunt deja absolute in buffer-ele arenei
+struct MaterialGroup {
+    GLsizei indexCount;
+    GLenum indexType;       //GL_UNSIGNED_SHORT sau GL_UNSIGNED_INT
+    size_t indexOffset;     //in bytes, in EBO
+    GLint baseVertex;
+    TextureHandle texture;  //textura din MTL, poate fi inca in incarcare
+    float uvDensity;        //unitati UV pe unitate a modelului (medie ponderata cu aria)
+};
+
+//acelasi VBO, alti indici; error e abaterea geometrica a nivelului in unitatile modelului
+struct LodLevel {
+    float error;
+    std::vector<MaterialGroup> groups;
+};
+
+//buffer-ele de pe GPU ale unui OBJ, impartite de toate ObjModel-urile cu aceeasi sursa
+struct MeshAsset {
+    std::string path;
+    AssetState state = AssetState::Pending;
+    VertexFormat vertexFormat = VertexFormat::Float;
+
+    //VAO-ul arenei; VBO/EBO sunt buffer-ele de trecere ale incarcarii in flux, 0 dupa ce mesh-ul e in arena
+    GLuint VAO = 0;
+    GLuint VBO = 0;
+    GLuint EBO = 0;
+    GeometryArena* arena = nullptr;
+    ArenaRange arenaRange;
+    //lodLevels[0] sunt grupurile complete, restul sunt versiunile simplificate
+    std::vector<LodLevel> lodLevels;
+    QuantizationBounds quantization;
+
+    //sfera care contine modelul, pentru alegerea LOD-ului
+    glm::vec3 boundsCenter = glm::vec3(0.0f);
+    float boundsRadius = 0.0f;
+
+    size_t gpuBytes = 0;
+};
+using MeshHandle = std::shared_ptr<MeshAsset>;
@@ -0,0 +1,211 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+struct PathKey {
+    float time;
+    CameraPose pose;
+};
+
+//inaltimea ochilor: curtea e la y = 0, casa la 0.5
+const PathKey kPath[] = {
+    {  0.0f, { {  6.0f, 1.6f, 14.0f }, -110.0f,  -5.0f } },   //curtea, spre casa
+    {  4.0f, { { -0.3f, 1.6f,  8.5f }, -100.0f,  -5.0f } },
+    {  7.0f, { { -1.2f, 1.9f,  5.2f },  180.0f,   0.0f } },   //treptele de la intrare
+    { 10.0f, { { -3.5f, 2.0f,  5.2f },  180.0f,   0.0f } },   //prin usa 1
+    { 13.0f, { { -3.5f, 2.0f,  1.0f },  -60.0f,   0.0f } },
+    { 17.0f, { {  1.0f, 2.0f,  1.5f },   30.0f, -10.0f } },   //livingul: canapeaua, lampa, masa
+    { 20.0f, { {  0.6f, 2.0f, -2.0f },  -90.0f,   0.0f } },
+    { 23.0f, { {  0.6f, 2.0f, -5.0f },  -90.0f,   0.0f } },   //prin usa 2
+    { 26.0f, { {  0.2f, 1.6f, -9.0f },  -90.0f,  -5.0f } },   //treptele din spate
+    { 30.0f, { {  8.0f, 3.0f, -14.0f }, 135.0f, -10.0f } }    //inapoi spre casa
+};
+constexpr int kPathKeys = sizeof(kPath) / sizeof(kPath[0]);
+
+glm::vec3 catmullRom(const glm::vec3& p0, const glm::vec3& p1, const glm::vec3& p2, const glm::vec3& p3, float t) {
+    float t2 = t * t;
+    float t3 = t2 * t;
+    return 0.5f * ((2.0f * p1) + (p2 - p0) * t + (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3) * t2 +
+                   (3.0f * p1 - p0 - 3.0f * p2 + p3) * t3);
+}
+
+//percentila prin rang (valorile sunt deja sortate)
+double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    size_t rank = (size_t)std::ceil(p / 100.0 * (double)sorted.size());
+    return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+
+struct Summary {
+    double mean = 0.0;
+    double p50 = 0.0;
+    double p95 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+};
+
+Summary summarize(std::vector<double> values) {
+    Summary s;
+    if (values.empty()) return s;
+    std::sort(values.begin(), values.end());
+    for (double v : values) s.mean += v;
+    s.mean /= (double)values.size();
+    s.p50 = percentile(values, 50.0);
+    s.p95 = percentile(values, 95.0);
+    s.p99 = percentile(values, 99.0);
+    s.max = values.back();
+    return s;
+}
+
+void writeSummary(std::ostream& out, const char* name, const Summary& s, bool last) {
+    out << "  \"" << name << "\": { \"mean\": " << s.mean << ", \"p50\": " << s.p50 << ", \"p95\": " << s.p95
+        << ", \"p99\": " << s.p99 << ", \"max\": " << s.max << " }" << (last ? "\n" : ",\n");
+}
+
+std::string glString(GLenum name) {
+    const GLubyte* s = glGetString(name);
+    return s ? reinterpret_cast<const char*>(s) : "";
+}
+
+//pentru JSON; numele driverelor nu au de obicei caractere speciale, dar nu ne bazam pe asta
+std::string jsonEscape(const std::string& s) {
+    std::string out;
+    for (char c : s) {
+        if (c == '"' || c == '\\') out += '\\';
+        if ((unsigned char)c >= 0x20) out += c;
+    }
+    return out;
+}
+
+} // namespace
+
+float benchmarkPathDuration() {
+    return kPath[kPathKeys - 1].time;
+}
+
+CameraPose sampleBenchmarkPath(float time) {
+    time = std::clamp(time, 0.0f, benchmarkPathDuration());
+    int k = 0;
+    while (k < kPathKeys - 2 && time > kPath[k + 1].time) k++;
+    const PathKey& a = kPath[k];
+    const PathKey& b = kPath[k + 1];
+    float t = (time - a.time) / (b.time - a.time);
+
+    const glm::vec3& before = kPath[std::max(k - 1, 0)].pose.position;
+    const glm::vec3& after = kPath[std::min(k + 2, kPathKeys - 1)].pose.position;
+    //unghiurile se interpoleaza liniar, cu pornire si oprire lina
+    float s = t * t * (3.0f - 2.0f * t);
+    CameraPose pose;
+    pose.position = catmullRom(before, a.pose.position, b.pose.position, after, t);
+    pose.yaw = a.pose.yaw + (b.pose.yaw - a.pose.yaw) * s;
+    pose.pitch = a.pose.pitch + (b.pose.pitch - a.pose.pitch) * s;
+    return pose;
+}
+
+BenchmarkRecorder::BenchmarkRecorder(int warmupFrames) : warmupFrames(warmupFrames) {
+    glGenQueries(kQueryLatency, queries);
+    std::fill(std::begin(queryFrame), std::end(queryFrame), -1);
+}
+
+BenchmarkRecorder::~BenchmarkRecorder() {
+    glDeleteQueries(kQueryLatency, queries);
+}
+
+//dupa kQueryLatency cadre rezultatul e de obicei gata; daca nu, asteptam decat sa pierdem cadrul
+void BenchmarkRecorder::collectQuery(int slot) {
+    if (queryFrame[slot] < 0) return;
+    GLuint64 ns = 0;
+    glGetQueryObjectui64v(queries[slot], GL_QUERY_RESULT, &ns);
+    frames[queryFrame[slot]].gpuMs = (double)ns / 1.0e6;
+    queryFrame[slot] = -1;
+}
+
+void BenchmarkRecorder::beginFrame() {
+    Clock::time_point now = Clock::now();
+    if (inFrame) {
+        frames.back().frameMs = std::chrono::duration<double, std::milli>(now - frameStart).count();
+    }
+    frameStart = now;
+    inFrame = true;
+
+    int slot = (int)(frames.size() % kQueryLatency);
+    collectQuery(slot);
+    frames.push_back({ 0.0, 0.0, -1.0, 0, 0 });
+    queryFrame[slot] = (int)frames.size() - 1;
+    glBeginQuery(GL_TIME_ELAPSED, queries[slot]);
+}
+
+void BenchmarkRecorder::endFrame(uint32_t drawCalls, uint64_t triangles) {
+    glEndQuery(GL_TIME_ELAPSED);
+    BenchmarkFrame& frame = frames.back();
+    frame.cpuMs = std::chrono::duration<double, std::milli>(Clock::now() - frameStart).count();
+    frame.drawCalls = drawCalls;
+    frame.triangles = triangles;
+}
+
+void BenchmarkRecorder::finish() {
+    if (inFrame) {
+        frames.back().frameMs = std::chrono::duration<double, std::milli>(Clock::now() - frameStart).count();
+        inFrame = false;
+    }
+    for (int slot = 0; slot < kQueryLatency; slot++) collectQuery(slot);
+}
+
+bool BenchmarkRecorder::write(const std::string& prefix, int width, int height) const {
+    std::string csvPath = prefix + ".csv";
+    std::ofstream csv(csvPath, std::ios::trunc);
+    if (!csv.is_open()) {
+        std::cerr << "Cannot write benchmark results: " << csvPath << "\n";
+        return false;
+    }
+    csv << "frame,frame_ms,cpu_ms,gpu_ms,draw_calls,triangles,warmup\n";
+    std::vector<double> frameMs, cpuMs, gpuMs, drawCalls;
+    for (size_t i = 0; i < frames.size(); i++) {
+        const BenchmarkFrame& f = frames[i];
+        bool warmup = (int)i < warmupFrames;
+        csv << i << "," << f.frameMs << "," << f.cpuMs << "," << f.gpuMs << "," << f.drawCalls << ","
+            << f.triangles << "," << (warmup ? 1 : 0) << "\n";
+        if (warmup) continue;
+        frameMs.push_back(f.frameMs);
+        cpuMs.push_back(f.cpuMs);
+        if (f.gpuMs >= 0.0) gpuMs.push_back(f.gpuMs);
+        drawCalls.push_back((double)f.drawCalls);
+    }
+
+    Summary frame = summarize(frameMs);
+    Summary cpu = summarize(cpuMs);
+    Summary gpu = summarize(gpuMs);
+    Summary draws = summarize(drawCalls);
+
+    std::string jsonPath = prefix + ".json";
+    std::ofstream json(jsonPath, std::ios::trunc);
+    if (!json.is_open()) {
+        std::cerr << "Cannot write benchmark results: " << jsonPath << "\n";
+        return false;
+    }
+    json << "{\n";
+    json << "  \"renderer\": \"" << jsonEscape(glString(GL_RENDERER)) << "\",\n";
+    json << "  \"version\": \"" << jsonEscape(glString(GL_VERSION)) << "\",\n";
+    json << "  \"width\": " << width << ",\n";
+    json << "  \"height\": " << height << ",\n";
+    json << "  \"frames\": " << frameMs.size() << ",\n";
+    json << "  \"warmupFrames\": " << std::min((size_t)warmupFrames, frames.size()) << ",\n";
+    writeSummary(json, "frameMs", frame, false);
+    writeSummary(json, "cpuMs", cpu, false);
+    writeSummary(json, "gpuMs", gpu, false);
+    writeSummary(json, "drawCalls", draws, true);
+    json << "}\n";
+
+    std::cout << "Benchmark: " << frameMs.size() << " frames on " << glString(GL_RENDERER) << "\n"
+              << "  frame ms p50 " << frame.p50 << "  p95 " << frame.p95 << "  p99 " << frame.p99
+              << "  max " << frame.max << "\n"
+              << "  cpu ms mean " << cpu.mean << "  gpu ms mean " << gpu.mean
+              << "  draw calls mean " << draws.mean << "\n"
+              << "  results: " << csvPath << ", " << jsonPath << "\n";
+    return true;
+}
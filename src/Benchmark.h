@@ -0,0 +1,57 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//pozitia camerei intr-un moment al traseului; yaw/pitch in grade, ca in main.cpp
+struct CameraPose {
+    glm::vec3 position;
+    float yaw;
+    float pitch;
+};
+
+//traseul fix pentru --benchmark: curtea, usa 1, livingul, usa 2 si inapoi in curte
+//timpul e cel simulat (pas fix), deci fiecare rulare vede exact aceleasi cadre
+float benchmarkPathDuration();
+CameraPose sampleBenchmarkPath(float time);
+
+struct BenchmarkFrame {
+    double frameMs;     //de la inceputul cadrului pana la inceputul urmatorului (include swap-ul)
+    double cpuMs;       //pana la ultima comanda a cadrului, inainte de swap
+    double gpuMs;       //GL_TIME_ELAPSED; -1 pana se citeste rezultatul
+    uint32_t drawCalls;
+    uint64_t triangles;
+};
+
+//masoara fiecare cadru; query-urile GPU se citesc cu cateva cadre intarziere, ca sa nu blocheze
+class BenchmarkRecorder {
+public:
+    explicit BenchmarkRecorder(int warmupFrames);
+    ~BenchmarkRecorder();
+
+    void beginFrame();
+    void endFrame(uint32_t drawCalls, uint64_t triangles);
+    //dupa ultimul cadru: asteapta query-urile ramase
+    void finish();
+
+    //<prefix>.csv cu fiecare cadru si <prefix>.json cu percentilele; rezumatul merge si pe cout
+    bool write(const std::string& prefix, int width, int height) const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+    static constexpr int kQueryLatency = 4;
+
+    void collectQuery(int slot);
+
+    int warmupFrames;
+    std::vector<BenchmarkFrame> frames;
+    Clock::time_point frameStart;
+    bool inFrame = false;
+    GLuint queries[kQueryLatency] = {};
+    int queryFrame[kQueryLatency];  //indicele cadrului masurat de fiecare query, -1 daca e liber
+};
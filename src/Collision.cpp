@@ -0,0 +1,116 @@
+#include "Collision.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+bool pointInPolygon(const glm::vec2& p, const glm::vec2* poly, size_t count) {
+    bool inside = false;
+    for (size_t i = 0, j = count - 1; i < count; j = i++) {
+        const glm::vec2& a = poly[i];
+        const glm::vec2& b = poly[j];
+        //verifica daca linia dintre punct si infinit intersecteaza latura poligonului
+        bool intersect =
+            ((a.y > p.y) != (b.y > p.y)) &&
+            (p.x < (b.x - a.x) * (p.y - a.y) / (b.y - a.y) + a.x);
+        if (intersect) inside = !inside;
+    }
+    return inside;
+}
+
+float getSlopeHeight(const glm::vec2& posXZ, const ScenePlane& plane) {
+    //verificam inaltimea folosind primii 3 puncte pentru a defini planul pantei
+    glm::vec3 p0 = plane.points[0];
+    glm::vec3 p1 = plane.points[1];
+    glm::vec3 p2 = plane.points[2];
+
+    glm::vec3 v1 = p1 - p0;
+    glm::vec3 v2 = p2 - p0;
+    glm::vec3 normal = glm::cross(v1, v2);
+    float d = -glm::dot(normal, p0);
+
+    if (std::fabs(normal.y) < 0.001f) return 0.0f;
+
+    float heightOnSlope = -(normal.x * posXZ.x + normal.z * posXZ.y + d) / normal.y;
+    return heightOnSlope;
+}
+
+bool checkSlopeCollision(const glm::vec3& pos, glm::vec3& correctedPos,
+                         const glm::vec2* slopePoly, size_t slopePolyCount,
+                         const ScenePlane& slopePlane, float eyeHeight) {
+    glm::vec2 posXZ(pos.x, pos.z);
+    if (!pointInPolygon(posXZ, slopePoly, slopePolyCount)) {
+        return false;
+    }
+    //daca suntem in interiorul poligonului pantei, calculam inaltimea pantei la pozitia XZ
+    //daca picioarele sunt sub inaltimea pantei, corectam pozitia pe Y
+    float slopeHeight = getSlopeHeight(posXZ, slopePlane);
+    float feetY = pos.y - eyeHeight;
+    float tolerance = 1.0f;
+    //aici verificam daca picioarele sunt sub inaltimea pantei plus o toleranta
+    if (feetY < slopeHeight + tolerance) {
+        correctedPos = pos;
+        correctedPos.y = slopeHeight + eyeHeight;
+        return true;
+    }
+
+    return false;
+}
+
+bool checkWallQuadCollision(const glm::vec3& pos, const glm::vec3* wallCorners, float thickness) {
+    //daca pozitia este in interiorul axelor AABB extinse cu grosimea peretelui, atunci este coliziune
+    float minX = std::min({wallCorners[0].x, wallCorners[1].x, wallCorners[2].x, wallCorners[3].x});
+    float maxX = std::max({wallCorners[0].x, wallCorners[1].x, wallCorners[2].x, wallCorners[3].x});
+    float minY = std::min({wallCorners[0].y, wallCorners[1].y, wallCorners[2].y, wallCorners[3].y});
+    float maxY = std::max({wallCorners[0].y, wallCorners[1].y, wallCorners[2].y, wallCorners[3].y});
+    float minZ = std::min({wallCorners[0].z, wallCorners[1].z, wallCorners[2].z, wallCorners[3].z});
+    float maxZ = std::max({wallCorners[0].z, wallCorners[1].z, wallCorners[2].z, wallCorners[3].z});
+
+    return (pos.x >= minX - thickness && pos.x <= maxX + thickness &&
+            pos.y >= minY - thickness && pos.y <= maxY + thickness &&
+            pos.z >= minZ - thickness && pos.z <= maxZ + thickness);
+}
+
+bool checkInteriorWallsCollision(const glm::vec3& pos, const SceneView& scene, uint32_t* hitWall) {
+    for (uint32_t i = 0; i < scene.wallCount; ++i) {
+        const SceneWall& wall = scene.walls[i];
+        if (!(wall.flags & SceneWallCollides)) continue;
+        if (checkWallQuadCollision(pos, wall.corners)) {
+            if (hitWall) *hitWall = i;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool checkDoorCollision(const glm::vec3& pos, const glm::vec3* baseCorners, float doorAngle) {
+    if (std::fabs(doorAngle) > 45.0f) return false;
+    //dupa 45 de grade nu mai exista coliziunea usii
+    glm::vec3 hingePos = baseCorners[0];
+    hingePos.y = (baseCorners[0].y + baseCorners[1].y) / 2.0f;
+    //calculeaza pozitiile colturilor usii dupa rotatie
+    glm::vec3 rotatedCorners[4];
+    float angleRad = glm::radians(doorAngle);
+    glm::mat4 rotation = glm::rotate(glm::mat4(1.0f), angleRad, glm::vec3(0, 1, 0));
+
+    for (int i = 0; i < 4; i++) {
+        glm::vec3 localPos = baseCorners[i] - hingePos;
+        glm::vec4 rotated = rotation * glm::vec4(localPos, 1.0f);
+        rotatedCorners[i] = glm::vec3(rotated) + hingePos;
+    }
+
+    float minY = rotatedCorners[0].y;
+    float maxY = rotatedCorners[1].y;
+    if (pos.y < minY || pos.y > maxY) return false;
+
+    float minX = std::min({rotatedCorners[0].x, rotatedCorners[1].x, rotatedCorners[2].x, rotatedCorners[3].x});
+    float maxX = std::max({rotatedCorners[0].x, rotatedCorners[1].x, rotatedCorners[2].x, rotatedCorners[3].x});
+    float minZ = std::min({rotatedCorners[0].z, rotatedCorners[1].z, rotatedCorners[2].z, rotatedCorners[3].z});
+    float maxZ = std::max({rotatedCorners[0].z, rotatedCorners[1].z, rotatedCorners[2].z, rotatedCorners[3].z});
+
+    float thickness = 0.2f;
+    return (pos.x >= minX - thickness && pos.x <= maxX + thickness &&
+            pos.z >= minZ - thickness && pos.z <= maxZ + thickness);
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "Scene.h"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+//testele de coliziune ale camerei, pe datele scenei; nu depind de OpenGL (le foloseste si hot_path_bench)
+
+//verifica daca un punct este in interiorul unui poligon 2D, pt colizuni, sa nu cadem prin podea
+bool pointInPolygon(const glm::vec2& p, const glm::vec2* poly, size_t count);
+//inaltimea pe panta la o pozitie XZ data
+float getSlopeHeight(const glm::vec2& posXZ, const ScenePlane& plane);
+//coliziunea cu panta; daca picioarele (pos.y - eyeHeight) sunt sub ea, correctedPos le ridica pe panta
+bool checkSlopeCollision(const glm::vec3& pos, glm::vec3& correctedPos,
+                         const glm::vec2* slopePoly, size_t slopePolyCount,
+                         const ScenePlane& slopePlane, float eyeHeight);
+//coliziunea cu un perete definit prin 4 colturi
+bool checkWallQuadCollision(const glm::vec3& pos, const glm::vec3* wallCorners, float thickness = 0.15f);
+//peretii casei din scena (tocurile usilor sunt doar pentru debug); hitWall primeste indicele peretelui lovit
+bool checkInteriorWallsCollision(const glm::vec3& pos, const SceneView& scene, uint32_t* hitWall = nullptr);
+//o usa rotita cu doorAngle grade in jurul balamalei (primul colt)
+bool checkDoorCollision(const glm::vec3& pos, const glm::vec3* baseCorners, float doorAngle);
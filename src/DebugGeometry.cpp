@@ -0,0 +1,123 @@
+#include "DebugGeometry.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace {
+
+void push(std::vector<float>& vertices, const glm::vec3& p) {
+    vertices.push_back(p.x);
+    vertices.push_back(p.y);
+    vertices.push_back(p.z);
+}
+
+void pushLine(std::vector<float>& vertices, const glm::vec3& a, const glm::vec3& b) {
+    push(vertices, a);
+    push(vertices, b);
+}
+
+} // namespace
+
+void buildFloorBoundaryLines(const std::vector<glm::vec2>& polygon, float y, std::vector<float>& vertices) {
+    if (polygon.empty()) return;
+    float ceilingY = y + 3.0f;
+    vertices.reserve(vertices.size() + polygon.size() * 18);
+    for (size_t i = 0; i < polygon.size(); ++i) {
+        size_t next = (i + 1) % polygon.size();
+        pushLine(vertices, glm::vec3(polygon[i].x, y, polygon[i].y), glm::vec3(polygon[next].x, y, polygon[next].y));
+    }
+    for (const auto& point : polygon) {
+        pushLine(vertices, glm::vec3(point.x, y, point.y), glm::vec3(point.x, ceilingY, point.y));
+    }
+    for (size_t i = 0; i < polygon.size(); ++i) {
+        size_t next = (i + 1) % polygon.size();
+        pushLine(vertices, glm::vec3(polygon[i].x, ceilingY, polygon[i].y),
+                 glm::vec3(polygon[next].x, ceilingY, polygon[next].y));
+    }
+}
+
+void buildDoorBoxLines(const glm::vec3& doorPos, float doorAngle, float doorWidth, float doorThickness,
+                       std::vector<float>& vertices) {
+    float halfWidth = doorWidth / 2.0f;
+    float halfThickness = doorThickness / 2.0f;
+    float doorHeight = 2.0f;
+    float angleRad = glm::radians(doorAngle);
+    glm::mat4 rotation = glm::rotate(glm::mat4(1.0f), angleRad, glm::vec3(0, 1, 0));
+    glm::vec3 corners[8] = {
+        glm::vec3(-halfWidth, 0.0f, -halfThickness),
+        glm::vec3( halfWidth, 0.0f, -halfThickness),
+        glm::vec3( halfWidth, 0.0f,  halfThickness),
+        glm::vec3(-halfWidth, 0.0f,  halfThickness),
+        glm::vec3(-halfWidth, doorHeight, -halfThickness),
+        glm::vec3( halfWidth, doorHeight, -halfThickness),
+        glm::vec3( halfWidth, doorHeight,  halfThickness),
+        glm::vec3(-halfWidth, doorHeight,  halfThickness)
+    };
+    glm::vec3 worldCorners[8];
+    for (int i = 0; i < 8; i++) {
+        glm::vec4 rotated = rotation * glm::vec4(corners[i], 1.0f);
+        worldCorners[i] = glm::vec3(rotated) + doorPos;
+    }
+    //baza, capacul si muchiile verticale
+    for (int i = 0; i < 4; i++) pushLine(vertices, worldCorners[i], worldCorners[(i + 1) % 4]);
+    for (int i = 0; i < 4; i++) pushLine(vertices, worldCorners[4 + i], worldCorners[4 + (i + 1) % 4]);
+    for (int i = 0; i < 4; i++) pushLine(vertices, worldCorners[i], worldCorners[i + 4]);
+}
+
+void buildDoorQuadLines(const glm::vec3* baseCorners, float doorAngle, std::vector<float>& vertices) {
+    glm::vec3 hingePos = baseCorners[0];
+    hingePos.y = (baseCorners[0].y + baseCorners[1].y) / 2.0f; // mid-height
+    glm::vec3 rotatedCorners[4];
+    float angleRad = glm::radians(doorAngle);
+    glm::mat4 rotation = glm::rotate(glm::mat4(1.0f), angleRad, glm::vec3(0, 1, 0));
+    for (int i = 0; i < 4; i++) {
+        glm::vec3 localPos = baseCorners[i] - hingePos;
+        glm::vec4 rotated = rotation * glm::vec4(localPos, 1.0f);
+        rotatedCorners[i] = glm::vec3(rotated) + hingePos;
+    }
+    pushLine(vertices, rotatedCorners[0], rotatedCorners[3]);
+    pushLine(vertices, rotatedCorners[3], rotatedCorners[2]);
+    pushLine(vertices, rotatedCorners[2], rotatedCorners[1]);
+    pushLine(vertices, rotatedCorners[1], rotatedCorners[0]);
+}
+
+void buildWallLines(const std::vector<glm::vec2>& floorPoly, float floorY, float wallHeight,
+                    std::vector<float>& vertices) {
+    float topY = floorY + wallHeight;
+    vertices.reserve(vertices.size() + floorPoly.size() * 18);
+    for (size_t i = 0; i < floorPoly.size(); ++i) {
+        size_t next = (i + 1) % floorPoly.size();
+        glm::vec2 p1 = floorPoly[i];
+        glm::vec2 p2 = floorPoly[next];
+        pushLine(vertices, glm::vec3(p1.x, floorY, p1.y), glm::vec3(p2.x, floorY, p2.y));
+        pushLine(vertices, glm::vec3(p1.x, topY, p1.y), glm::vec3(p2.x, topY, p2.y));
+        pushLine(vertices, glm::vec3(p1.x, floorY, p1.y), glm::vec3(p1.x, topY, p1.y));
+    }
+}
+
+void buildFloorFan(const std::vector<glm::vec2>& floorPoly, float floorY, std::vector<float>& vertices) {
+    if (floorPoly.size() < 3) return;
+    glm::vec2 center(0.0f);
+    for (const auto& p : floorPoly) {
+        center.x += p.x;
+        center.y += p.y;
+    }
+    center.x /= floorPoly.size();
+    center.y /= floorPoly.size();
+    vertices.reserve(vertices.size() + floorPoly.size() * 9);
+    for (size_t i = 0; i < floorPoly.size(); ++i) {
+        size_t next = (i + 1) % floorPoly.size();
+        push(vertices, glm::vec3(center.x, floorY, center.y));
+        push(vertices, glm::vec3(floorPoly[i].x, floorY, floorPoly[i].y));
+        push(vertices, glm::vec3(floorPoly[next].x, floorY, floorPoly[next].y));
+    }
+}
+
+void buildQuadLines(const glm::vec3* corners, std::vector<float>& vertices) {
+    for (int i = 0; i < 4; i++) pushLine(vertices, corners[i], corners[(i + 1) % 4]);
+}
+
+void buildSlopeLines(const glm::vec3* points, std::vector<float>& vertices) {
+    buildQuadLines(points, vertices);
+    pushLine(vertices, points[0], points[2]);
+    pushLine(vertices, points[1], points[3]);
+}
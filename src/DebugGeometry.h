@@ -0,0 +1,25 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+//varfurile (xyz, cate 3 float-uri) desenate de DebugRenderer, construite fara OpenGL
+//toate functiile adauga la sfarsitul lui vertices; cele pentru linii dau perechi de capete (GL_LINES)
+
+//conturul podelei la y si la y + 3, plus muchiile verticale
+void buildFloorBoundaryLines(const std::vector<glm::vec2>& polygon, float y, std::vector<float>& vertices);
+//cutia usii (latime x 2 x grosime) rotita cu doorAngle grade in jurul lui doorPos
+void buildDoorBoxLines(const glm::vec3& doorPos, float doorAngle, float doorWidth, float doorThickness,
+                       std::vector<float>& vertices);
+//quad-ul usii rotit cu doorAngle grade in jurul balamalei (primul colt, la jumatatea inaltimii)
+void buildDoorQuadLines(const glm::vec3* baseCorners, float doorAngle, std::vector<float>& vertices);
+//peretii verticali de pe conturul podelei
+void buildWallLines(const std::vector<glm::vec2>& floorPoly, float floorY, float wallHeight,
+                    std::vector<float>& vertices);
+//podeaua ca evantai de triunghiuri din centrul poligonului (GL_TRIANGLES)
+void buildFloorFan(const std::vector<glm::vec2>& floorPoly, float floorY, std::vector<float>& vertices);
+//conturul unui quad
+void buildQuadLines(const glm::vec3* corners, std::vector<float>& vertices);
+//conturul pantei si diagonalele ei
+void buildSlopeLines(const glm::vec3* points, std::vector<float>& vertices);
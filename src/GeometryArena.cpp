@@ -0,0 +1,225 @@
+#include "GeometryArena.h"
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+#include "MeshData.h"
+
+namespace {
+
+//arenele pornesc cu loc pentru cateva modele medii si se dubleaza la nevoie
+constexpr size_t kInitialVertices = 256 * 1024;
+constexpr size_t kInitialIndexBytes = 1024 * 1024;
+
+size_t alignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+//first fit; offset-ul intors e aliniat, restul de dinainte ramane liber
+bool takeRange(std::map<size_t, size_t>& ranges, size_t size, size_t alignment, size_t& offset) {
+    for (auto it = ranges.begin(); it != ranges.end(); ++it) {
+        size_t start = alignUp(it->first, alignment);
+        size_t end = it->first + it->second;
+        if (start + size > end) continue;
+        size_t before = start - it->first;
+        size_t after = end - (start + size);
+        if (before > 0) it->second = before;
+        else ranges.erase(it);
+        if (after > 0) ranges[start + size] = after;
+        offset = start;
+        return true;
+    }
+    return false;
+}
+
+//pune intervalul inapoi si il lipeste de vecinii liberi
+void giveRange(std::map<size_t, size_t>& ranges, size_t offset, size_t size) {
+    if (size == 0) return;
+    auto next = ranges.lower_bound(offset);
+    if (next != ranges.end() && offset + size == next->first) {
+        size += next->second;
+        next = ranges.erase(next);
+    }
+    if (next != ranges.begin()) {
+        auto prev = std::prev(next);
+        if (prev->first + prev->second == offset) {
+            prev->second += size;
+            return;
+        }
+    }
+    ranges[offset] = size;
+}
+
+//un buffer nou de marimea ceruta, cu primele oldBytes copiate din cel vechi (care se sterge)
+GLuint growBuffer(GLuint old, size_t oldBytes, size_t newBytes) {
+    GLuint buffer;
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, (GLsizeiptr)newBytes, nullptr, GL_STATIC_DRAW);
+    if (old) {
+        glBindBuffer(GL_COPY_READ_BUFFER, old);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, (GLsizeiptr)oldBytes);
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        glDeleteBuffers(1, &old);
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    return buffer;
+}
+
+//0, 1, 2, ... pentru atributul kDrawIndexAttribute, comun tuturor arenelor
+GLuint drawIndexBuffer = 0;
+
+std::unique_ptr<GeometryArena> arenas[2];
+
+} // namespace
+
+void configureVertexAttributes(VertexFormat format) {
+    if (format == VertexFormat::Packed) {
+        //pozitie unorm16, normala octaedrica snorm16, uv half
+        glVertexAttribPointer(0, 3, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(PackedVertex), (void*)offsetof(PackedVertex, pos));
+        glVertexAttribPointer(1, 2, GL_SHORT, GL_TRUE, sizeof(PackedVertex), (void*)offsetof(PackedVertex, normal));
+        glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, sizeof(PackedVertex), (void*)offsetof(PackedVertex, uv));
+    } else {
+        //vertexAttribPointer configureaza modul in care datele varfurilor sunt interpretate de shader
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(ObjVertex), (void*)0);
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(ObjVertex), (void*)offsetof(ObjVertex, normal));
+        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(ObjVertex), (void*)offsetof(ObjVertex, uv));
+    }
+    glEnableVertexAttribArray(0);
+    glEnableVertexAttribArray(1);
+    glEnableVertexAttribArray(2);
+}
+
+size_t GeometryArena::vertexStride() const {
+    return format == VertexFormat::Packed ? sizeof(PackedVertex) : sizeof(ObjVertex);
+}
+
+//VAO-ul trebuie refacut cand buffer-ele se schimba la crestere
+void GeometryArena::bindVertexArray() {
+    if (vertexArray == 0) glGenVertexArrays(1, &vertexArray);
+    glBindVertexArray(vertexArray);
+    glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+    configureVertexAttributes(format);
+    if (multiDrawIndirectSupported()) {
+        if (drawIndexBuffer == 0) {
+            std::vector<uint32_t> indices(kMaxDrawsPerFrame);
+            std::iota(indices.begin(), indices.end(), 0u);
+            glGenBuffers(1, &drawIndexBuffer);
+            glBindBuffer(GL_ARRAY_BUFFER, drawIndexBuffer);
+            glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)(indices.size() * sizeof(uint32_t)), indices.data(),
+                         GL_STATIC_DRAW);
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, drawIndexBuffer);
+        glVertexAttribIPointer(kDrawIndexAttribute, 1, GL_UNSIGNED_INT, sizeof(uint32_t), (void*)0);
+        glVertexAttribDivisor(kDrawIndexAttribute, 1);
+        glEnableVertexAttribArray(kDrawIndexAttribute);
+    }
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+//marimea se dubleaza pana cand coada libera adaugata incape cererea
+void GeometryArena::growVertices(size_t vertexCount) {
+    size_t capacity = vertexCapacity ? vertexCapacity : kInitialVertices;
+    while (capacity < vertexCapacity + vertexCount) capacity *= 2;
+    vertexBuffer = growBuffer(vertexBuffer, vertexCapacity * vertexStride(), capacity * vertexStride());
+    giveRange(freeVertices, vertexCapacity, capacity - vertexCapacity);
+    vertexCapacity = capacity;
+    bindVertexArray();
+}
+
+void GeometryArena::growIndices(size_t indexBytes) {
+    size_t capacity = indexCapacity ? indexCapacity : kInitialIndexBytes;
+    while (capacity < indexCapacity + indexBytes) capacity *= 2;
+    indexBuffer = growBuffer(indexBuffer, indexCapacity, capacity);
+    giveRange(freeIndices, indexCapacity, capacity - indexCapacity);
+    indexCapacity = capacity;
+    bindVertexArray();
+}
+
+void GeometryArena::reserve(size_t vertexCount, size_t indexBytes, ArenaRange& range) {
+    size_t firstVertex = 0;
+    size_t indexOffset = 0;
+    //capacitatile sunt multipli de 4, deci coada adaugata la crestere e deja aliniata
+    if (!takeRange(freeVertices, vertexCount, 1, firstVertex)) {
+        growVertices(vertexCount);
+        takeRange(freeVertices, vertexCount, 1, firstVertex);
+    }
+    if (!takeRange(freeIndices, indexBytes, 4, indexOffset)) {
+        growIndices(indexBytes);
+        takeRange(freeIndices, indexBytes, 4, indexOffset);
+    }
+    range.firstVertex = firstVertex;
+    range.vertexCount = vertexCount;
+    range.indexOffset = indexOffset;
+    range.indexBytes = indexBytes;
+    usedVertices += vertexCount;
+    usedIndexBytes += indexBytes;
+}
+
+void GeometryArena::allocate(const void* vertices, size_t vertexCount, const uint8_t* indices, size_t indexBytes,
+                             ArenaRange& range) {
+    reserve(vertexCount, indexBytes, range);
+    size_t stride = vertexStride();
+    glBindBuffer(GL_COPY_WRITE_BUFFER, vertexBuffer);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, (GLintptr)(range.firstVertex * stride), (GLsizeiptr)(vertexCount * stride),
+                    vertices);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, indexBuffer);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, (GLintptr)range.indexOffset, (GLsizeiptr)indexBytes, indices);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+void GeometryArena::allocateCopy(GLuint vertexSource, size_t vertexCount, GLuint indexSource, size_t indexBytes,
+                                 ArenaRange& range) {
+    reserve(vertexCount, indexBytes, range);
+    size_t stride = vertexStride();
+    glBindBuffer(GL_COPY_READ_BUFFER, vertexSource);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, vertexBuffer);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, (GLintptr)(range.firstVertex * stride),
+                        (GLsizeiptr)(vertexCount * stride));
+    glBindBuffer(GL_COPY_READ_BUFFER, indexSource);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, indexBuffer);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, (GLintptr)range.indexOffset,
+                        (GLsizeiptr)indexBytes);
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+void GeometryArena::free(const ArenaRange& range) {
+    giveRange(freeVertices, range.firstVertex, range.vertexCount);
+    giveRange(freeIndices, range.indexOffset, range.indexBytes);
+    usedVertices -= range.vertexCount;
+    usedIndexBytes -= range.indexBytes;
+}
+
+void GeometryArena::release() {
+    if (vertexArray) glDeleteVertexArrays(1, &vertexArray);
+    if (vertexBuffer) glDeleteBuffers(1, &vertexBuffer);
+    if (indexBuffer) glDeleteBuffers(1, &indexBuffer);
+    vertexArray = vertexBuffer = indexBuffer = 0;
+    vertexCapacity = indexCapacity = 0;
+    usedVertices = usedIndexBytes = 0;
+    freeVertices.clear();
+    freeIndices.clear();
+}
+
+GeometryArena& geometryArena(VertexFormat format) {
+    std::unique_ptr<GeometryArena>& arena = arenas[format == VertexFormat::Packed ? 1 : 0];
+    if (!arena) arena = std::make_unique<GeometryArena>(format);
+    return *arena;
+}
+
+void releaseGeometryArenas() {
+    for (auto& arena : arenas) {
+        if (arena) arena->release();
+    }
+    if (drawIndexBuffer) glDeleteBuffers(1, &drawIndexBuffer);
+    drawIndexBuffer = 0;
+}
+
+bool multiDrawIndirectSupported() {
+    return (GLEW_VERSION_4_3 || GLEW_ARB_multi_draw_indirect) && (GLEW_VERSION_4_2 || GLEW_ARB_base_instance);
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <GL/glew.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+
+#include "VertexPacking.h"
+
+//atributele 0-2 pentru formatul dat, din GL_ARRAY_BUFFER-ul legat, in VAO-ul legat
+void configureVertexAttributes(VertexFormat format);
+
+//locul unui mesh intr-o arena: varfurile in unitati de varf, indicii in bytes (aliniati la 4)
+struct ArenaRange {
+    size_t firstVertex = 0;
+    size_t vertexCount = 0;
+    size_t indexOffset = 0;
+    size_t indexBytes = 0;
+};
+
+//un VBO, un EBO si un VAO comune tuturor mesh-urilor statice cu acelasi format de varf,
+//ca scena sa se poata desena cu cateva glMultiDrawElementsIndirect
+//EBO-ul amesteca indici pe 16 si pe 32 de biti; fiecare tip se deseneaza separat, cu firstIndex in unitatile lui
+//cand nu mai incape, buffer-ele se dubleaza si continutul se copiaza pe GPU; VAO-ul ramane acelasi
+class GeometryArena {
+public:
+    explicit GeometryArena(VertexFormat format) : format(format) {}
+    GeometryArena(const GeometryArena&) = delete;
+    GeometryArena& operator=(const GeometryArena&) = delete;
+
+    //vertices are vertexCount varfuri in formatul arenei
+    void allocate(const void* vertices, size_t vertexCount, const uint8_t* indices, size_t indexBytes,
+                  ArenaRange& range);
+    //la fel, dar datele vin din buffer-ele date si se copiaza pe GPU (fara copie in memoria CPU)
+    void allocateCopy(GLuint vertexSource, size_t vertexCount, GLuint indexSource, size_t indexBytes,
+                      ArenaRange& range);
+    void free(const ArenaRange& range);
+    //inainte sa dispara contextul GL
+    void release();
+
+    GLuint vao() const { return vertexArray; }
+    size_t vertexStride() const;
+    size_t usedBytes() const { return usedVertices * vertexStride() + usedIndexBytes; }
+
+private:
+    void growVertices(size_t vertexCount);
+    void growIndices(size_t indexBytes);
+    void reserve(size_t vertexCount, size_t indexBytes, ArenaRange& range);
+    void bindVertexArray();
+
+    VertexFormat format;
+    GLuint vertexArray = 0;
+    GLuint vertexBuffer = 0;
+    GLuint indexBuffer = 0;
+    size_t vertexCapacity = 0;
+    size_t indexCapacity = 0;
+    size_t usedVertices = 0;
+    size_t usedIndexBytes = 0;
+    //intervalele libere, offset -> marime
+    std::map<size_t, size_t> freeVertices;
+    std::map<size_t, size_t> freeIndices;
+};
+
+//cate o arena pentru fiecare VertexFormat, create la primul mesh
+GeometryArena& geometryArena(VertexFormat format);
+void releaseGeometryArenas();
+
+//glMultiDrawElementsIndirect cu baseInstance (GL 4.3 sau extensiile); altfel desenam grup cu grup
+bool multiDrawIndirectSupported();
+
+//layout-ul fix cerut de glMultiDrawElementsIndirect
+struct DrawElementsIndirectCommand {
+    uint32_t count;
+    uint32_t instanceCount;
+    uint32_t firstIndex;        //in unitatile tipului de index
+    int32_t baseVertex;
+    uint32_t baseInstance;      //indexul desenarii, ajunge in shader prin atributul kDrawIndexAttribute
+};
+
+//atributul 5 e indexul desenarii in inregistrarile cadrului; in VAO-urile arenelor vine dintr-un buffer
+//0, 1, 2, ... cu divisor 1, deci din baseInstance-ul comenzii indirecte; altfel e constanta setata de glVertexAttribI1ui
+constexpr GLuint kDrawIndexAttribute = 5;
+constexpr uint32_t kMaxDrawsPerFrame = 65536;
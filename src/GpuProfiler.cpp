@@ -0,0 +1,161 @@
+#include "GpuProfiler.h"
+
+#include <iostream>
+
+namespace {
+
+const GLenum kStatisticTargets[] = {
+    GL_VERTICES_SUBMITTED_ARB,
+    GL_PRIMITIVES_SUBMITTED_ARB,
+    GL_FRAGMENT_SHADER_INVOCATIONS_ARB
+};
+
+bool queryAvailable(GLuint query) {
+    GLuint available = GL_FALSE;
+    glGetQueryObjectuiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+    return available == GL_TRUE;
+}
+
+uint64_t queryResult(GLuint query) {
+    GLuint64 value = 0;
+    glGetQueryObjectui64v(query, GL_QUERY_RESULT, &value);
+    return value;
+}
+
+} // namespace
+
+static_assert(sizeof(kStatisticTargets) / sizeof(kStatisticTargets[0]) == 3, "GpuProfiler::kStatisticsPerZone");
+
+GpuProfiler::GpuProfiler() {
+    statistics = GLEW_ARB_pipeline_statistics_query;
+}
+
+GpuProfiler::~GpuProfiler() {
+    for (FrameQueries& queries : frames) {
+        if (!queries.timestamps.empty()) glDeleteQueries((GLsizei)queries.timestamps.size(), queries.timestamps.data());
+        if (!queries.statistics.empty()) glDeleteQueries((GLsizei)queries.statistics.size(), queries.statistics.data());
+    }
+}
+
+bool GpuProfiler::openLog(const std::string& path) {
+    log.open(path, std::ios::trunc);
+    if (!log.is_open()) {
+        std::cerr << "Cannot write GPU profile: " << path << "\n";
+        return false;
+    }
+    log << "frame,zone,depth,gpu_ms,vertices,primitives,fragments\n";
+    return true;
+}
+
+//query-urile se refolosesc de la un cadru la altul; pool-ul creste doar cand apar zone noi
+GLuint GpuProfiler::nextQuery(std::vector<GLuint>& pool, uint32_t& used) {
+    if (used == pool.size()) {
+        GLuint query;
+        glGenQueries(1, &query);
+        pool.push_back(query);
+    }
+    return pool[used++];
+}
+
+//citeste cadrul doar daca ultima pasa s-a terminat pe GPU (toate zonele sunt inchise inaintea ei)
+bool GpuProfiler::collect(FrameQueries& queries) {
+    for (auto it = queries.zones.rbegin(); it != queries.zones.rend(); ++it) {
+        if (it->depth != 0) continue;
+        if (!queryAvailable(queries.timestamps[it->firstTimestamp + 1])) return false;
+        if (it->firstStatistics >= 0 &&
+            !queryAvailable(queries.statistics[it->firstStatistics + kStatisticsPerZone - 1])) return false;
+        break;
+    }
+
+    lastResults.clear();
+    for (const Zone& zone : queries.zones) {
+        GpuZoneResult result = {};
+        result.name = zone.name;
+        result.depth = zone.depth;
+        uint64_t start = queryResult(queries.timestamps[zone.firstTimestamp]);
+        uint64_t end = queryResult(queries.timestamps[zone.firstTimestamp + 1]);
+        result.gpuMs = end > start ? (double)(end - start) / 1.0e6 : 0.0;
+        if (zone.firstStatistics >= 0) {
+            result.hasStatistics = true;
+            result.vertices = queryResult(queries.statistics[zone.firstStatistics]);
+            result.primitives = queryResult(queries.statistics[zone.firstStatistics + 1]);
+            result.fragments = queryResult(queries.statistics[zone.firstStatistics + 2]);
+        }
+        lastResults.push_back(result);
+    }
+    lastFrame = queries.frame;
+
+    if (log.is_open()) {
+        for (const GpuZoneResult& r : lastResults) {
+            log << lastFrame << "," << r.name << "," << r.depth << "," << r.gpuMs << ",";
+            if (r.hasStatistics) log << r.vertices << "," << r.primitives << "," << r.fragments << "\n";
+            else log << ",,\n";
+        }
+    }
+    return true;
+}
+
+void GpuProfiler::beginFrame() {
+    FrameQueries& queries = frames[frameIndex % kFrameLatency];
+    if (queries.pending && !collect(queries)) dropped++;
+    queries.pending = false;
+    queries.usedTimestamps = 0;
+    queries.usedStatistics = 0;
+    queries.zones.clear();
+    queries.frame = frameIndex;
+    open.clear();
+    inFrame = true;
+}
+
+void GpuProfiler::endFrame() {
+    if (!inFrame) return;
+    while (!open.empty()) endZone();
+    FrameQueries& queries = frames[frameIndex % kFrameLatency];
+    queries.pending = !queries.zones.empty();
+    frameIndex++;
+    inFrame = false;
+}
+
+void GpuProfiler::finish() {
+    endFrame();
+    glFinish();
+    //cel mai vechi cadru e cel care s-ar refolosi primul
+    for (int i = 0; i < kFrameLatency; i++) {
+        FrameQueries& queries = frames[(frameIndex + i) % kFrameLatency];
+        if (queries.pending && !collect(queries)) dropped++;
+        queries.pending = false;
+    }
+}
+
+void GpuProfiler::beginZone(const char* name) {
+    if (!inFrame) return;
+    FrameQueries& queries = frames[frameIndex % kFrameLatency];
+    Zone zone;
+    zone.name = name;
+    zone.depth = (int)open.size();
+    zone.firstTimestamp = queries.usedTimestamps;
+    zone.firstStatistics = -1;
+    glQueryCounter(nextQuery(queries.timestamps, queries.usedTimestamps), GL_TIMESTAMP);
+    //query-urile de statistici nu se pot imbrica, deci le punem doar pe pase
+    if (statistics && zone.depth == 0) {
+        zone.firstStatistics = (int32_t)queries.usedStatistics;
+        for (GLenum target : kStatisticTargets) {
+            glBeginQuery(target, nextQuery(queries.statistics, queries.usedStatistics));
+        }
+    }
+    //query-ul de sfarsit se rezerva acum, ca sa fie mereu imediat dupa cel de inceput
+    nextQuery(queries.timestamps, queries.usedTimestamps);
+    open.push_back((int)queries.zones.size());
+    queries.zones.push_back(zone);
+}
+
+void GpuProfiler::endZone() {
+    if (!inFrame || open.empty()) return;
+    FrameQueries& queries = frames[frameIndex % kFrameLatency];
+    const Zone& zone = queries.zones[open.back()];
+    open.pop_back();
+    if (zone.firstStatistics >= 0) {
+        for (GLenum target : kStatisticTargets) glEndQuery(target);
+    }
+    glQueryCounter(queries.timestamps[zone.firstTimestamp + 1], GL_TIMESTAMP);
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <GL/glew.h>
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+//rezultatul unei zone dintr-un cadru terminat pe GPU
+struct GpuZoneResult {
+    const char* name;       //pointerul dat la beginZone, trebuie sa traiasca pana se citeste rezultatul
+    int depth;              //0 pentru pase, 1+ pentru zonele din interiorul lor
+    double gpuMs;
+    //GL_ARB_pipeline_statistics_query, doar pentru zonele de nivel 0 si doar daca driverul il are
+    bool hasStatistics;
+    uint64_t vertices;
+    uint64_t primitives;
+    uint64_t fragments;
+};
+
+//timpi GPU pe pase: fiecare zona e o pereche de timestamp-uri (glQueryCounter), deci zonele se pot imbrica;
+//rezultatele unui cadru se citesc dupa kFrameLatency cadre, doar daca sunt gata, ca sa nu blocheze pipeline-ul
+class GpuProfiler {
+public:
+    GpuProfiler();
+    ~GpuProfiler();
+    GpuProfiler(const GpuProfiler&) = delete;
+    GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+    void beginFrame();
+    void endFrame();
+    void beginZone(const char* name);
+    void endZone();
+    //la oprire: asteapta GPU-ul si citeste cadrele ramase in zbor, altfel ultimele kFrameLatency lipsesc din CSV
+    void finish();
+
+    bool statisticsSupported() const { return statistics; }
+    //ultimul cadru citit complet; resultFrame() e -1 pana la primul
+    const std::vector<GpuZoneResult>& results() const { return lastResults; }
+    int64_t resultFrame() const { return lastFrame; }
+    uint64_t droppedFrames() const { return dropped; }
+
+    //CSV cu o linie pe zona pentru fiecare cadru citit
+    bool openLog(const std::string& path);
+
+private:
+    static constexpr int kFrameLatency = 3;
+    static constexpr int kStatisticsPerZone = 3;
+
+    struct Zone {
+        const char* name;
+        int depth;
+        uint32_t firstTimestamp;    //inceputul; sfarsitul e urmatorul query
+        int32_t firstStatistics;    //-1 daca zona nu are statistici
+    };
+
+    struct FrameQueries {
+        std::vector<GLuint> timestamps;
+        std::vector<GLuint> statistics;
+        uint32_t usedTimestamps = 0;
+        uint32_t usedStatistics = 0;
+        std::vector<Zone> zones;
+        int64_t frame = -1;
+        bool pending = false;
+    };
+
+    GLuint nextQuery(std::vector<GLuint>& pool, uint32_t& used);
+    bool collect(FrameQueries& queries);
+
+    bool statistics = false;
+    FrameQueries frames[kFrameLatency];
+    int64_t frameIndex = 0;
+    bool inFrame = false;
+    std::vector<int> open;  //zonele deschise, pentru imbricare
+    std::vector<GpuZoneResult> lastResults;
+    int64_t lastFrame = -1;
+    uint64_t dropped = 0;
+    std::ofstream log;
+};
+
+//zona pentru un bloc; cu profiler nullptr nu face nimic
+class GpuZone {
+public:
+    GpuZone(GpuProfiler* profiler, const char* name) : profiler(profiler) {
+        if (profiler) profiler->beginZone(name);
+    }
+    ~GpuZone() {
+        if (profiler) profiler->endZone();
+    }
+    GpuZone(const GpuZone&) = delete;
+    GpuZone& operator=(const GpuZone&) = delete;
+
+private:
+    GpuProfiler* profiler;
+};
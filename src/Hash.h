@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+//FNV-1a pe 64 biti, suficient pentru chei de cache (nu e criptografic)
+constexpr uint64_t kFnvOffsetBasis = 1469598103934665603ull;
+
+inline uint64_t hashBytes(const void* data, size_t size, uint64_t seed = kFnvOffsetBasis) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    uint64_t h = seed;
+    for (size_t i = 0; i < size; i++) {
+        h ^= p[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+inline uint64_t hashString(const std::string& s, uint64_t seed = kFnvOffsetBasis) {
+    return hashBytes(s.data(), s.size(), seed);
+}
@@ -0,0 +1,200 @@
+#include "ImageResize.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define IMAGE_RESIZE_SSE2 1
+#endif
+
+namespace {
+
+constexpr float kLanczosRadius = 3.0f;
+
+float lanczos3(float x) {
+    x = std::fabs(x);
+    if (x < 1e-6f) return 1.0f;
+    if (x >= kLanczosRadius) return 0.0f;
+    const float pi = 3.14159265358979f;
+    float px = pi * x;
+    return kLanczosRadius * std::sin(px) * std::sin(px / kLanczosRadius) / (px * px);
+}
+
+//ponderile pentru fiecare pixel de iesire, pe o axa
+//texturile sunt GL_REPEAT, deci marginile se continua de pe partea opusa; asa media
+//imaginii se pastreaza si la nivelurile mici, unde filtrul e mai lat decat imaginea
+struct FilterAxis {
+    std::vector<int> count;
+    std::vector<int> offset;
+    std::vector<int> indices;
+    std::vector<float> weights;
+};
+
+void buildFilterAxis(int srcSize, int dstSize, FilterAxis& axis) {
+    float scale = (float)srcSize / (float)dstSize;
+    float stretch = std::max(scale, 1.0f);
+    float support = kLanczosRadius * stretch;
+    axis.count.resize(dstSize);
+    axis.offset.resize(dstSize);
+    axis.indices.clear();
+    axis.weights.clear();
+    for (int i = 0; i < dstSize; i++) {
+        float center = (i + 0.5f) * scale - 0.5f;
+        int lo = (int)std::floor(center - support) + 1;
+        int hi = (int)std::floor(center + support);
+        size_t base = axis.weights.size();
+        float total = 0.0f;
+        for (int j = lo; j <= hi; j++) {
+            float w = lanczos3((j - center) / stretch);
+            if (w == 0.0f) continue;
+            axis.indices.push_back(((j % srcSize) + srcSize) % srcSize);
+            axis.weights.push_back(w);
+            total += w;
+        }
+        if (std::fabs(total) > 1e-6f) {
+            for (size_t k = base; k < axis.weights.size(); k++) axis.weights[k] /= total;
+        }
+        axis.count[i] = (int)(axis.weights.size() - base);
+        axis.offset[i] = (int)base;
+    }
+}
+
+#ifdef IMAGE_RESIZE_SSE2
+
+inline __m128 loadPixel(const uint8_t* p) {
+    int32_t v;
+    std::memcpy(&v, p, 4);
+    __m128i zero = _mm_setzero_si128();
+    __m128i bytes = _mm_cvtsi32_si128(v);
+    return _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(bytes, zero), zero));
+}
+
+inline void storePixel(uint8_t* p, __m128 value) {
+    //rotunjire si saturare la 0..255 in aceeasi trecere
+    __m128i i = _mm_cvtps_epi32(value);
+    i = _mm_packs_epi32(i, i);
+    i = _mm_packus_epi16(i, i);
+    int32_t v = _mm_cvtsi128_si32(i);
+    std::memcpy(p, &v, 4);
+}
+
+void filterRows(const uint8_t* src, int width, int height, const FilterAxis& axis, int dstWidth,
+                std::vector<float>& tmp) {
+    tmp.resize((size_t)dstWidth * height * 4);
+    for (int y = 0; y < height; y++) {
+        const uint8_t* row = src + (size_t)y * width * 4;
+        float* out = tmp.data() + (size_t)y * dstWidth * 4;
+        for (int x = 0; x < dstWidth; x++) {
+            const float* w = axis.weights.data() + axis.offset[x];
+            const int* index = axis.indices.data() + axis.offset[x];
+            __m128 sum = _mm_setzero_ps();
+            for (int k = 0; k < axis.count[x]; k++) {
+                sum = _mm_add_ps(sum, _mm_mul_ps(loadPixel(row + (size_t)index[k] * 4), _mm_set1_ps(w[k])));
+            }
+            _mm_storeu_ps(out + x * 4, sum);
+        }
+    }
+}
+
+void filterColumns(const std::vector<float>& tmp, int width, const FilterAxis& axis, int dstHeight,
+                   uint8_t* dst) {
+    std::vector<float> acc((size_t)width * 4);
+    for (int y = 0; y < dstHeight; y++) {
+        std::fill(acc.begin(), acc.end(), 0.0f);
+        const float* w = axis.weights.data() + axis.offset[y];
+        const int* index = axis.indices.data() + axis.offset[y];
+        for (int k = 0; k < axis.count[y]; k++) {
+            const float* row = tmp.data() + (size_t)index[k] * width * 4;
+            __m128 wk = _mm_set1_ps(w[k]);
+            for (int x = 0; x < width; x++) {
+                __m128 a = _mm_loadu_ps(acc.data() + x * 4);
+                _mm_storeu_ps(acc.data() + x * 4, _mm_add_ps(a, _mm_mul_ps(_mm_loadu_ps(row + x * 4), wk)));
+            }
+        }
+        uint8_t* out = dst + (size_t)y * width * 4;
+        for (int x = 0; x < width; x++) storePixel(out + x * 4, _mm_loadu_ps(acc.data() + x * 4));
+    }
+}
+
+#else
+
+void filterRows(const uint8_t* src, int width, int height, const FilterAxis& axis, int dstWidth,
+                std::vector<float>& tmp) {
+    tmp.resize((size_t)dstWidth * height * 4);
+    for (int y = 0; y < height; y++) {
+        const uint8_t* row = src + (size_t)y * width * 4;
+        float* out = tmp.data() + (size_t)y * dstWidth * 4;
+        for (int x = 0; x < dstWidth; x++) {
+            const float* w = axis.weights.data() + axis.offset[x];
+            const int* index = axis.indices.data() + axis.offset[x];
+            float sum[4] = {};
+            for (int k = 0; k < axis.count[x]; k++) {
+                const uint8_t* p = row + (size_t)index[k] * 4;
+                for (int c = 0; c < 4; c++) sum[c] += p[c] * w[k];
+            }
+            std::memcpy(out + x * 4, sum, sizeof(sum));
+        }
+    }
+}
+
+void filterColumns(const std::vector<float>& tmp, int width, const FilterAxis& axis, int dstHeight,
+                   uint8_t* dst) {
+    std::vector<float> acc((size_t)width * 4);
+    for (int y = 0; y < dstHeight; y++) {
+        std::fill(acc.begin(), acc.end(), 0.0f);
+        const float* w = axis.weights.data() + axis.offset[y];
+        const int* index = axis.indices.data() + axis.offset[y];
+        for (int k = 0; k < axis.count[y]; k++) {
+            const float* row = tmp.data() + (size_t)index[k] * width * 4;
+            for (size_t i = 0; i < acc.size(); i++) acc[i] += row[i] * w[k];
+        }
+        uint8_t* out = dst + (size_t)y * width * 4;
+        for (size_t i = 0; i < acc.size(); i++) {
+            out[i] = (uint8_t)std::clamp((int)std::lround(acc[i]), 0, 255);
+        }
+    }
+}
+
+#endif
+
+} // namespace
+
+void resizeImage(const uint8_t* src, int width, int height,
+                 int dstWidth, int dstHeight, std::vector<uint8_t>& dst) {
+    dst.resize((size_t)dstWidth * dstHeight * 4);
+    if (dstWidth == width && dstHeight == height) {
+        std::memcpy(dst.data(), src, dst.size());
+        return;
+    }
+    FilterAxis horizontal, vertical;
+    buildFilterAxis(width, dstWidth, horizontal);
+    buildFilterAxis(height, dstHeight, vertical);
+    std::vector<float> tmp;
+    filterRows(src, width, height, horizontal, dstWidth, tmp);
+    filterColumns(tmp, dstWidth, vertical, dstHeight, dst.data());
+}
+
+void fitToMaxDimension(int width, int height, int maxDimension, int& outWidth, int& outHeight) {
+    outWidth = width;
+    outHeight = height;
+    int largest = std::max(width, height);
+    if (maxDimension <= 0 || largest <= maxDimension) return;
+    double scale = (double)maxDimension / largest;
+    outWidth = std::max(1, (int)std::lround(width * scale));
+    outHeight = std::max(1, (int)std::lround(height * scale));
+}
+
+void buildMipChain(ImageLevel base, std::vector<ImageLevel>& levels) {
+    levels.clear();
+    levels.push_back(std::move(base));
+    while (levels.back().width > 1 || levels.back().height > 1) {
+        const ImageLevel& prev = levels.back();
+        ImageLevel next;
+        next.width = std::max(1, prev.width / 2);
+        next.height = std::max(1, prev.height / 2);
+        resizeImage(prev.pixels.data(), prev.width, prev.height, next.width, next.height, next.pixels);
+        levels.push_back(std::move(next));
+    }
+}
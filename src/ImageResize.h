@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+//un nivel de imagine RGBA8, randurile unul dupa altul
+struct ImageLevel {
+    int width = 0;
+    int height = 0;
+    std::vector<uint8_t> pixels;
+};
+
+//redimensionare separabila cu filtru Lanczos3 (latit cu raportul la micsorare);
+//un pixel RGBA e un registru SSE, cu varianta scalara unde nu avem SSE2
+void resizeImage(const uint8_t* src, int width, int height,
+                 int dstWidth, int dstHeight, std::vector<uint8_t>& dst);
+
+//dimensiunile dupa limitare, cu acelasi raport de aspect; maxDimension <= 0 nu limiteaza
+void fitToMaxDimension(int width, int height, int maxDimension, int& outWidth, int& outHeight);
+
+//lantul complet de mip-uri (pana la 1x1), fiecare nivel filtrat din cel anterior; base devine levels[0]
+void buildMipChain(ImageLevel base, std::vector<ImageLevel>& levels);
@@ -0,0 +1,119 @@
+#include "InputLog.h"
+
+#include <GLFW/glfw3.h>
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+const int kInputKeys[] = {
+    GLFW_KEY_ESCAPE, GLFW_KEY_F2, GLFW_KEY_G, GLFW_KEY_P, GLFW_KEY_K, GLFW_KEY_F,
+    GLFW_KEY_W, GLFW_KEY_A, GLFW_KEY_S, GLFW_KEY_D, GLFW_KEY_Q, GLFW_KEY_SPACE,
+    GLFW_KEY_E, GLFW_KEY_L, GLFW_KEY_M,
+    GLFW_KEY_UP, GLFW_KEY_DOWN, GLFW_KEY_LEFT, GLFW_KEY_RIGHT
+};
+const int kInputKeyCount = sizeof(kInputKeys) / sizeof(kInputKeys[0]);
+
+namespace {
+
+const char kInputLogMagic[4] = { 'I', 'N', 'P', 'L' };
+
+struct InputLogHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t keyCount;
+};
+
+//antetul fiecarui cadru; urmeaza cursorCount perechi x,y si scrollCount valori
+struct InputFrameHeader {
+    float deltaTime;
+    uint32_t keys;
+    uint16_t cursorCount;
+    uint16_t scrollCount;
+    uint64_t stateHash;
+};
+
+int keyBit(int glfwKey) {
+    for (int i = 0; i < kInputKeyCount; i++) {
+        if (kInputKeys[i] == glfwKey) return i;
+    }
+    return -1;
+}
+
+} // namespace
+
+static_assert(sizeof(kInputKeys) / sizeof(kInputKeys[0]) <= 32, "InputFrame::keys has 32 bits");
+
+bool InputFrame::keyDown(int glfwKey) const {
+    int bit = keyBit(glfwKey);
+    return bit >= 0 && (keys & (1u << bit)) != 0;
+}
+
+void InputFrame::setKey(int glfwKey, bool down) {
+    int bit = keyBit(glfwKey);
+    if (bit < 0) return;
+    if (down) keys |= 1u << bit;
+    else keys &= ~(1u << bit);
+}
+
+bool InputRecorder::open(const std::string& path) {
+    out.open(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "Cannot write input log: " << path << "\n";
+        return false;
+    }
+    InputLogHeader header = {};
+    std::memcpy(header.magic, kInputLogMagic, 4);
+    header.version = kInputLogVersion;
+    header.keyCount = (uint32_t)kInputKeyCount;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    frames = 0;
+    return (bool)out;
+}
+
+void InputRecorder::write(const InputFrame& frame) {
+    //mai mult de 65535 de evenimente intr-un cadru nu apar in practica; restul se pierd
+    InputFrameHeader header = {};
+    header.deltaTime = frame.deltaTime;
+    header.keys = frame.keys;
+    header.cursorCount = (uint16_t)std::min<size_t>(frame.cursor.size(), UINT16_MAX);
+    header.scrollCount = (uint16_t)std::min<size_t>(frame.scroll.size(), UINT16_MAX);
+    header.stateHash = frame.stateHash;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(frame.cursor.data()), header.cursorCount * sizeof(glm::vec2));
+    out.write(reinterpret_cast<const char*>(frame.scroll.data()), header.scrollCount * sizeof(float));
+    frames++;
+}
+
+bool InputPlayer::open(const std::string& path) {
+    in.open(path, std::ios::binary);
+    if (!in.is_open()) {
+        std::cerr << "Cannot open input log: " << path << "\n";
+        return false;
+    }
+    InputLogHeader header;
+    in.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!in || std::memcmp(header.magic, kInputLogMagic, 4) != 0 || header.version != kInputLogVersion ||
+        header.keyCount != (uint32_t)kInputKeyCount) {
+        std::cerr << "Invalid or outdated input log: " << path << "\n";
+        return false;
+    }
+    frames = 0;
+    return true;
+}
+
+bool InputPlayer::next(InputFrame& frame) {
+    InputFrameHeader header;
+    in.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!in) return false;
+    frame.deltaTime = header.deltaTime;
+    frame.keys = header.keys;
+    frame.stateHash = header.stateHash;
+    frame.cursor.resize(header.cursorCount);
+    frame.scroll.resize(header.scrollCount);
+    in.read(reinterpret_cast<char*>(frame.cursor.data()), header.cursorCount * sizeof(glm::vec2));
+    in.read(reinterpret_cast<char*>(frame.scroll.data()), header.scrollCount * sizeof(float));
+    if (!in) return false;
+    frames++;
+    return true;
+}
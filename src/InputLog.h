@@ -0,0 +1,50 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+//tastele citite de bucla principala; ordinea da bitul din InputFrame::keys
+//(adaugarea unei taste schimba formatul, deci si kInputLogVersion)
+constexpr uint32_t kInputLogVersion = 1;
+extern const int kInputKeys[];
+extern const int kInputKeyCount;
+
+//tot ce intra in simulare intr-un cadru: cu acelasi sir de cadre, starea iese identica
+struct InputFrame {
+    float deltaTime = 0.0f;
+    uint32_t keys = 0;
+    std::vector<glm::vec2> cursor;  //pozitiile primite de callback-ul de mouse, in ordine
+    std::vector<float> scroll;      //yoffset-urile rotitei
+    uint64_t stateHash = 0;         //starea simularii la sfarsitul cadrului, pentru verificarea replay-ului
+
+    bool keyDown(int glfwKey) const;
+    void setKey(int glfwKey, bool down);
+};
+
+//log binar: antet (magic, versiune, numar de taste), apoi cadrele unul dupa altul
+class InputRecorder {
+public:
+    bool open(const std::string& path);
+    void write(const InputFrame& frame);
+    uint32_t frameCount() const { return frames; }
+
+private:
+    std::ofstream out;
+    uint32_t frames = 0;
+};
+
+class InputPlayer {
+public:
+    bool open(const std::string& path);
+    //false la sfarsitul log-ului (sau daca e trunchiat)
+    bool next(InputFrame& frame);
+    uint32_t frameCount() const { return frames; }
+
+private:
+    std::ifstream in;
+    uint32_t frames = 0;
+};
@@ -0,0 +1,115 @@
+#include "Lz.h"
+
+#include <cstring>
+
+namespace {
+
+constexpr int kHashBits = 14;
+constexpr size_t kMinMatch = 4;
+constexpr size_t kMaxOffset = 65535;
+constexpr size_t kNoPosition = ~(size_t)0;
+
+inline uint32_t read32(const uint8_t* p) {
+    uint32_t v;
+    std::memcpy(&v, p, 4);
+    return v;
+}
+
+inline uint32_t hash4(uint32_t v) {
+    return (v * 2654435761u) >> (32 - kHashBits);
+}
+
+void writeLength(std::vector<uint8_t>& out, size_t length) {
+    while (length >= 255) {
+        out.push_back(255);
+        length -= 255;
+    }
+    out.push_back((uint8_t)length);
+}
+
+//matchLength == 0 marcheaza ultima secventa (doar literali)
+void emitSequence(std::vector<uint8_t>& out, const uint8_t* literals, size_t literalLength,
+                  size_t offset, size_t matchLength) {
+    size_t extraMatch = matchLength ? matchLength - kMinMatch : 0;
+    size_t tokenLiterals = literalLength < 15 ? literalLength : 15;
+    size_t tokenMatch = extraMatch < 15 ? extraMatch : 15;
+    out.push_back((uint8_t)(tokenLiterals << 4 | tokenMatch));
+    if (literalLength >= 15) writeLength(out, literalLength - 15);
+    out.insert(out.end(), literals, literals + literalLength);
+    if (!matchLength) return;
+    out.push_back((uint8_t)(offset & 0xff));
+    out.push_back((uint8_t)(offset >> 8));
+    if (extraMatch >= 15) writeLength(out, extraMatch - 15);
+}
+
+bool readLength(const uint8_t*& ip, const uint8_t* end, size_t& length) {
+    uint8_t b;
+    do {
+        if (ip >= end) return false;
+        b = *ip++;
+        length += b;
+    } while (b == 255);
+    return true;
+}
+
+} // namespace
+
+void lzCompress(const uint8_t* src, size_t size, std::vector<uint8_t>& out) {
+    out.clear();
+    out.reserve(size + size / 255 + 16);
+    std::vector<size_t> table((size_t)1 << kHashBits, kNoPosition);
+    size_t anchor = 0;
+    size_t i = 0;
+    //pe date care nu se comprima (ex. blocuri BC) pasul creste, ca sa nu pierdem timp
+    size_t misses = 0;
+    while (i + kMinMatch <= size) {
+        uint32_t v = read32(src + i);
+        uint32_t h = hash4(v);
+        size_t candidate = table[h];
+        table[h] = i;
+        if (candidate != kNoPosition && i - candidate <= kMaxOffset && read32(src + candidate) == v) {
+            size_t length = kMinMatch;
+            while (i + length < size && src[candidate + length] == src[i + length]) length++;
+            emitSequence(out, src + anchor, i - anchor, i - candidate, length);
+            i += length;
+            anchor = i;
+            misses = 0;
+        } else {
+            i += 1 + (misses++ >> 6);
+        }
+    }
+    emitSequence(out, src + anchor, size - anchor, 0, 0);
+}
+
+bool lzDecompress(const uint8_t* src, size_t size, uint8_t* dst, size_t dstSize) {
+    const uint8_t* ip = src;
+    const uint8_t* end = src + size;
+    size_t op = 0;
+    while (ip < end) {
+        uint8_t token = *ip++;
+        size_t literalLength = token >> 4;
+        if (literalLength == 15 && !readLength(ip, end, literalLength)) return false;
+        if ((size_t)(end - ip) < literalLength || dstSize - op < literalLength) return false;
+        std::memcpy(dst + op, ip, literalLength);
+        ip += literalLength;
+        op += literalLength;
+        if (ip == end) break;
+
+        if (end - ip < 2) return false;
+        size_t offset = (size_t)ip[0] | (size_t)ip[1] << 8;
+        ip += 2;
+        size_t matchLength = token & 15;
+        if (matchLength == 15 && !readLength(ip, end, matchLength)) return false;
+        matchLength += kMinMatch;
+        if (offset == 0 || offset > op || dstSize - op < matchLength) return false;
+        const uint8_t* match = dst + op - offset;
+        if (offset >= matchLength) {
+            std::memcpy(dst + op, match, matchLength);
+        } else {
+            //suprapunere: repetam ultimii offset bytes
+            for (size_t k = 0; k < matchLength; k++) dst[op + k] = match[k];
+        }
+        op += matchLength;
+    }
+    return op == dstSize;
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//compresie LZ77 simpla, in stilul blocurilor LZ4: secvente de literali + (offset, lungime),
+//fereastra de 64 KB; decomprimarea e doar copiere, deci rapida la incarcare
+//nu are antet: dimensiunea decomprimata trebuie stiuta de cine apeleaza
+void lzCompress(const uint8_t* src, size_t size, std::vector<uint8_t>& out);
+
+//intoarce false daca datele sunt corupte sau nu produc exact dstSize bytes
+bool lzDecompress(const uint8_t* src, size_t size, uint8_t* dst, size_t dstSize);
@@ -0,0 +1,163 @@
+#include "MaterialArrays.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <tuple>
+
+namespace {
+
+//texturile din acelasi array trebuie sa aiba stocarea identica
+struct ArrayClass {
+    GLint internalFormat;
+    bool compressed;
+    int width;
+    int height;
+    int levelCount;
+
+    bool operator<(const ArrayClass& o) const {
+        return std::tie(internalFormat, compressed, width, height, levelCount) <
+               std::tie(o.internalFormat, o.compressed, o.width, o.height, o.levelCount);
+    }
+};
+
+int mipSize(int size, int level) {
+    return std::max(1, size >> level);
+}
+
+bool copyImageSupported() {
+    return GLEW_VERSION_4_3 || GLEW_ARB_copy_image;
+}
+
+//doar texturile 2D complet rezidente; cele din streamer (texturile de scena) isi muta BASE_LEVEL si raman separate
+bool arrayClass(const TextureAsset& texture, ArrayClass& result) {
+    if (texture.state != AssetState::Ready || texture.id == 0 || texture.target != GL_TEXTURE_2D) return false;
+    if (texture.baseLevel != 0) return false;
+    //textura 2D se sterge dupa copiere; cele facute cu makeReadyTexture (fara cale) nu sunt ale registrului
+    if (texture.path.empty()) return false;
+    GLint format = 0;
+    GLint compressed = 0;
+    glBindTexture(GL_TEXTURE_2D, texture.id);
+    glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_INTERNAL_FORMAT, &format);
+    glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_COMPRESSED, &compressed);
+    //necomprimat, Texture.cpp urca doar RGBA8
+    if (!compressed && format != GL_RGBA8) return false;
+    result = ArrayClass{ format, compressed != 0, texture.width, texture.height, texture.levelCount };
+    return true;
+}
+
+//marimea unui nivel comprimat al texturii 2D legate
+GLint compressedLevelBytes(int level) {
+    GLint size = 0;
+    glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_COMPRESSED_IMAGE_SIZE, &size);
+    return size;
+}
+
+//acelasi filtru si acelasi wrap ca texturile 2D din Texture.cpp
+GLuint createArray(const ArrayClass& cls, GLsizei layers, GLuint firstTexture) {
+    std::vector<GLint> levelBytes;
+    if (cls.compressed) {
+        glBindTexture(GL_TEXTURE_2D, firstTexture);
+        for (int level = 0; level < cls.levelCount; level++) levelBytes.push_back(compressedLevelBytes(level));
+    }
+    GLuint array;
+    glGenTextures(1, &array);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, array);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BASE_LEVEL, 0);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, cls.levelCount - 1);
+    if (GLEW_VERSION_4_2 || GLEW_ARB_texture_storage) {
+        glTexStorage3D(GL_TEXTURE_2D_ARRAY, cls.levelCount, (GLenum)cls.internalFormat, cls.width, cls.height,
+                       layers);
+        return array;
+    }
+    for (int level = 0; level < cls.levelCount; level++) {
+        int width = mipSize(cls.width, level);
+        int height = mipSize(cls.height, level);
+        if (cls.compressed) {
+            glCompressedTexImage3D(GL_TEXTURE_2D_ARRAY, level, (GLenum)cls.internalFormat, width, height, layers, 0,
+                                   levelBytes[level] * layers, nullptr);
+        } else {
+            glTexImage3D(GL_TEXTURE_2D_ARRAY, level, GL_RGBA8, width, height, layers, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                         nullptr);
+        }
+    }
+    return array;
+}
+
+//copia ramane pe GPU cu GL 4.3; altfel fiecare nivel trece prin memoria CPU
+void copyLayer(GLuint source, GLuint array, const ArrayClass& cls, GLint layer, std::vector<uint8_t>& scratch) {
+    for (int level = 0; level < cls.levelCount; level++) {
+        int width = mipSize(cls.width, level);
+        int height = mipSize(cls.height, level);
+        if (copyImageSupported()) {
+            glCopyImageSubData(source, GL_TEXTURE_2D, level, 0, 0, 0, array, GL_TEXTURE_2D_ARRAY, level, 0, 0, layer,
+                               width, height, 1);
+            continue;
+        }
+        glBindTexture(GL_TEXTURE_2D, source);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, array);
+        if (cls.compressed) {
+            GLint size = compressedLevelBytes(level);
+            scratch.resize((size_t)size);
+            glGetCompressedTexImage(GL_TEXTURE_2D, level, scratch.data());
+            glCompressedTexSubImage3D(GL_TEXTURE_2D_ARRAY, level, 0, 0, layer, width, height, 1,
+                                      (GLenum)cls.internalFormat, size, scratch.data());
+        } else {
+            //randurile RGBA8 sunt multiplu de 4 bytes, alinierea implicita e buna in ambele sensuri
+            scratch.resize((size_t)width * height * 4);
+            glGetTexImage(GL_TEXTURE_2D, level, GL_RGBA, GL_UNSIGNED_BYTE, scratch.data());
+            glTexSubImage3D(GL_TEXTURE_2D_ARRAY, level, 0, 0, layer, width, height, 1, GL_RGBA, GL_UNSIGNED_BYTE,
+                            scratch.data());
+        }
+    }
+}
+
+} // namespace
+
+void MaterialArrays::build(const std::vector<TextureHandle>& textures) {
+    std::map<ArrayClass, std::vector<TextureAsset*>> classes;
+    std::vector<const TextureAsset*> seen;
+    for (const TextureHandle& texture : textures) {
+        if (!texture || std::find(seen.begin(), seen.end(), texture.get()) != seen.end()) continue;
+        seen.push_back(texture.get());
+        ArrayClass cls;
+        if (arrayClass(*texture, cls)) classes[cls].push_back(texture.get());
+    }
+
+    GLint maxLayers = 0;
+    glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayers);
+    std::vector<uint8_t> scratch;
+    for (const auto& [cls, members] : classes) {
+        //o singura textura nu castiga nimic dintr-un array
+        for (size_t first = 0; first + 1 < members.size(); first += (size_t)maxLayers) {
+            GLsizei layers = (GLsizei)std::min(members.size() - first, (size_t)maxLayers);
+            if (layers < 2) break;
+            GLuint array = createArray(cls, layers, members[first]->id);
+            for (GLsizei layer = 0; layer < layers; layer++) {
+                TextureAsset& texture = *members[first + layer];
+                copyLayer(texture.id, array, cls, layer, scratch);
+                glDeleteTextures(1, &texture.id);
+                texture.id = array;
+                texture.target = GL_TEXTURE_2D_ARRAY;
+                texture.layer = layer;
+            }
+            arrays.push_back(array);
+            packed += (size_t)layers;
+        }
+    }
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    std::cout << "Material arrays: " << packed << " of " << seen.size() << " textures in " << arrays.size()
+              << " arrays\n";
+}
+
+void MaterialArrays::release() {
+    if (!arrays.empty()) glDeleteTextures((GLsizei)arrays.size(), arrays.data());
+    arrays.clear();
+    packed = 0;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <GL/glew.h>
+
+#include <cstddef>
+#include <vector>
+
+#include "AssetTypes.h"
+
+//unitatea de textura a array-ului legat de RenderQueue (textura 2D ramane pe unitatea 0)
+constexpr GLuint kMaterialArrayUnit = 4;
+
+//texturile de material cu acelasi format, aceeasi rezolutie si acelasi numar de niveluri se muta
+//in straturile unui GL_TEXTURE_2D_ARRAY, ca desenarile cu texturi diferite sa ramana in acelasi
+//glMultiDrawElementsIndirect; stratul ajunge in shader prin DrawRecord::materialLayer
+//dupa build() o textura impachetata are id = array-ul, target = GL_TEXTURE_2D_ARRAY si layer = stratul,
+//iar textura 2D initiala e stearsa
+//texturile din MTL se incarca cu TextureUsage::Material: patrate, cu latura putere a lui 2 si in afara
+//TextureStreamer-ului, deci cad in putine clase; texturile de scena din streamer (inca fara nivelurile
+//mari) si clasele cu o singura textura raman 2D
+class MaterialArrays {
+public:
+    MaterialArrays() = default;
+    MaterialArrays(const MaterialArrays&) = delete;
+    MaterialArrays& operator=(const MaterialArrays&) = delete;
+
+    //pe thread-ul GL, dupa ce incarcarile s-au terminat; duplicatele si texturile care nu sunt gata sunt sarite
+    void build(const std::vector<TextureHandle>& textures);
+    //inainte sa dispara contextul GL; straturile texturilor impachetate nu mai exista dupa
+    void release();
+
+    size_t arrayCount() const { return arrays.size(); }
+    size_t packedCount() const { return packed; }
+
+private:
+    std::vector<GLuint> arrays;
+    size_t packed = 0;
+};
@@ -0,0 +1,8 @@
+#pragma once
+
+#include <cstddef>
+
+//memoria fizica a procesului, pentru rapoarte; 0 daca platforma nu o ofera
+//maximul nu scade niciodata, deci pentru o singura operatie se compara valorile de dinainte si de dupa
+size_t currentResidentBytes();
+size_t peakResidentBytes();
@@ -0,0 +1,302 @@
+#include "MeshCache.h"
+#include "AssetPack.h"
+#include "Hash.h"
+#include "ObjParser.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+const char kMeshCacheMagic[4] = { 'O', 'M', 'C', 'H' };
+
+struct MeshCacheHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t sourceSize;
+    int64_t sourceMtime;
+    uint64_t sourceHash;
+    uint32_t vertexCount;
+    uint32_t groupCount;
+    uint32_t stringBytes;
+    uint32_t vertexOffset;
+    uint32_t indexBytes;
+    uint32_t indexOffset;
+    uint32_t lodCount;
+    uint32_t reserved;
+};
+
+struct MeshCacheGroup {
+    uint32_t startIndex;
+    uint32_t indexCount;
+    uint32_t baseVertex;
+    uint32_t vertexCount;
+    uint32_t indexByteOffset;
+    uint32_t indexSize;
+    uint32_t nameOffset;
+    uint32_t nameLength;
+};
+
+//dupa grupuri: pentru fiecare LOD eroarea, apoi cate un interval pe grup
+struct MeshCacheLodRange {
+    uint32_t startIndex;
+    uint32_t indexCount;
+    uint32_t indexByteOffset;
+};
+
+//varfurile sunt aliniate ca sa le putem citi direct din mapare
+constexpr size_t kVertexAlignment = 16;
+
+size_t alignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+//marimea totala si cel mai nou mtime; un fisier care lipseste schimba oricum marimea
+bool statSources(const std::vector<std::string>& paths, uint64_t& size, int64_t& mtime) {
+    size = 0;
+    mtime = 0;
+    for (size_t i = 0; i < paths.size(); i++) {
+        std::error_code ec;
+        auto fileSize = std::filesystem::file_size(paths[i], ec);
+        if (ec) return false;
+        auto writeTime = std::filesystem::last_write_time(paths[i], ec);
+        if (ec) return false;
+        size += (uint64_t)fileSize;
+        //epoca ceasului de fisiere poate fi dupa 1970, deci valorile pot fi negative
+        int64_t time = (int64_t)writeTime.time_since_epoch().count();
+        mtime = i == 0 ? time : std::max(mtime, time);
+    }
+    return true;
+}
+
+//dupa un checkout sau o copiere hash-ul confirma sursa, dar mtime-ul din antet ramane vechi;
+//il rescriem ca rularile urmatoare sa ramana pe calea rapida (marime + mtime)
+//fisierul nu trebuie sa fie mapat (pe Windows maparea nu lasa scrierea); un esec doar pastreaza calea lenta
+void rewriteSourceMtime(const std::string& cachePath, int64_t mtime) {
+    std::fstream file(cachePath, std::ios::binary | std::ios::in | std::ios::out);
+    if (!file.is_open()) return;
+    file.seekp((std::streamoff)offsetof(MeshCacheHeader, sourceMtime));
+    file.write(reinterpret_cast<const char*>(&mtime), sizeof(mtime));
+}
+
+bool hashSources(const std::vector<std::string>& paths, uint64_t& hash) {
+    hash = kFnvOffsetBasis;
+    for (const auto& path : paths) {
+        MappedFile src;
+        if (!src.open(path)) return false;
+        hash = hashBytes(src.data(), src.size(), hash);
+    }
+    return true;
+}
+
+} // namespace
+
+std::string meshCachePath(const std::string& objPath) {
+    return objPath + ".meshcache";
+}
+
+std::vector<std::string> meshSourceFiles(const std::string& objPath) {
+    std::vector<std::string> paths;
+    MappedFile obj;
+    if (!obj.open(objPath)) return paths;
+    paths.push_back(objPath);
+    std::string baseDir = std::filesystem::path(objPath).parent_path().generic_string();
+    if (baseDir.empty()) baseDir = ".";
+    //ca la parsare, alternativele care nu exista sunt sarite
+    std::error_code ec;
+    for (auto& mtl : objMtlLibraries(reinterpret_cast<const char*>(obj.data()), obj.size(), baseDir)) {
+        if (std::filesystem::is_regular_file(mtl, ec)) paths.push_back(std::move(mtl));
+    }
+    return paths;
+}
+
+bool computeMeshCacheKey(const std::string& objPath, MeshCacheKey& key) {
+    std::vector<std::string> sources = meshSourceFiles(objPath);
+    if (sources.empty() || !statSources(sources, key.sourceSize, key.sourceMtime)) return false;
+    return hashSources(sources, key.sourceHash);
+}
+
+namespace {
+
+//tabelele si pointerii din view arata in data, care trebuie sa ramana valida cat timp view-ul e folosit
+bool parseMeshCache(const uint8_t* data, size_t size, MeshCacheHeader& header, MeshCacheView& view) {
+    if (size < sizeof(MeshCacheHeader)) return false;
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, kMeshCacheMagic, 4) != 0) return false;
+    if (header.version != kMeshCacheVersion) return false;
+
+    size_t groupsOffset = sizeof(MeshCacheHeader);
+    size_t lodsOffset = groupsOffset + header.groupCount * sizeof(MeshCacheGroup);
+    size_t lodBytes = sizeof(float) + header.groupCount * sizeof(MeshCacheLodRange);
+    size_t stringsOffset = lodsOffset + header.lodCount * lodBytes;
+    size_t vertexBytes = (size_t)header.vertexCount * sizeof(ObjVertex);
+    if (stringsOffset + header.stringBytes > size) return false;
+    if (header.vertexOffset % kVertexAlignment != 0 ||
+        header.vertexOffset < stringsOffset + header.stringBytes ||
+        header.vertexOffset + vertexBytes > size) return false;
+    if (header.indexOffset % kVertexAlignment != 0 ||
+        header.indexOffset < header.vertexOffset + vertexBytes ||
+        (uint64_t)header.indexOffset + header.indexBytes > size) return false;
+
+    const char* strings = reinterpret_cast<const char*>(data + stringsOffset);
+    std::vector<MeshGroupData> groups(header.groupCount);
+    for (uint32_t i = 0; i < header.groupCount; i++) {
+        MeshCacheGroup g;
+        std::memcpy(&g, data + groupsOffset + i * sizeof(MeshCacheGroup), sizeof(g));
+        if ((uint64_t)g.nameOffset + g.nameLength > header.stringBytes) return false;
+        if ((uint64_t)g.baseVertex + g.vertexCount > header.vertexCount) return false;
+        if ((g.indexSize != 2 && g.indexSize != 4) ||
+            (uint64_t)g.indexByteOffset + (uint64_t)g.indexCount * g.indexSize > header.indexBytes) return false;
+        groups[i].startIndex = g.startIndex;
+        groups[i].indexCount = g.indexCount;
+        groups[i].baseVertex = g.baseVertex;
+        groups[i].vertexCount = g.vertexCount;
+        groups[i].indexByteOffset = g.indexByteOffset;
+        groups[i].indexSize = g.indexSize;
+        groups[i].diffuseTexture.assign(strings + g.nameOffset, g.nameLength);
+    }
+
+    std::vector<MeshLodData> lods(header.lodCount);
+    for (uint32_t l = 0; l < header.lodCount; l++) {
+        const uint8_t* record = data + lodsOffset + l * lodBytes;
+        std::memcpy(&lods[l].error, record, sizeof(float));
+        lods[l].groups.resize(header.groupCount);
+        for (uint32_t i = 0; i < header.groupCount; i++) {
+            MeshCacheLodRange r;
+            std::memcpy(&r, record + sizeof(float) + i * sizeof(MeshCacheLodRange), sizeof(r));
+            if ((uint64_t)r.indexByteOffset + (uint64_t)r.indexCount * groups[i].indexSize > header.indexBytes) return false;
+            lods[l].groups[i].startIndex = r.startIndex;
+            lods[l].groups[i].indexCount = r.indexCount;
+            lods[l].groups[i].indexByteOffset = r.indexByteOffset;
+        }
+    }
+
+    view.vertices = reinterpret_cast<const ObjVertex*>(data + header.vertexOffset);
+    view.vertexCount = header.vertexCount;
+    view.indexBytes = data + header.indexOffset;
+    view.indexByteCount = header.indexBytes;
+    view.groups = std::move(groups);
+    view.lods = std::move(lods);
+    return true;
+}
+
+} // namespace
+
+bool openMeshCache(const std::string& objPath, MeshCacheView& view) {
+    MeshCacheHeader header;
+    //intrarea din pack e folosita doar daca OBJ-ul si MTL-urile nu s-au schimbat de la gatire (sau lipsesc)
+    if (assetPack().isOpen()) {
+        PackBlob blob;
+        if (assetPack().readFresh(packEntryName(meshCachePath(objPath)), meshSourceFiles(objPath), blob)) {
+            if (!parseMeshCache(blob.data, blob.size, header, view)) return false;
+            view.storage = std::move(blob.storage);
+            return true;
+        }
+    }
+
+    std::vector<std::string> sources = meshSourceFiles(objPath);
+    uint64_t srcSize;
+    int64_t srcMtime;
+    if (sources.empty() || !statSources(sources, srcSize, srcMtime)) return false;
+
+    std::string cachePath = meshCachePath(objPath);
+    MappedFile file;
+    if (!file.open(cachePath)) return false;
+    if (!parseMeshCache(file.data(), file.size(), header, view)) return false;
+    if (header.sourceSize != srcSize) return false;
+
+    //daca doar mtime-ul difera (ex. checkout), verificam continutul
+    if (header.sourceMtime != srcMtime) {
+        uint64_t srcHash;
+        if (!hashSources(sources, srcHash) || srcHash != header.sourceHash) return false;
+        file.close();
+        rewriteSourceMtime(cachePath, srcMtime);
+        if (!file.open(cachePath) || !parseMeshCache(file.data(), file.size(), header, view)) return false;
+    }
+    view.file = std::move(file);
+    return true;
+}
+
+bool writeMeshCache(const std::string& objPath, const MeshData& mesh) {
+    MeshCacheKey key;
+    if (!computeMeshCacheKey(objPath, key)) return false;
+
+    std::vector<MeshCacheGroup> groups;
+    std::string strings;
+    for (const auto& g : mesh.groups) {
+        MeshCacheGroup cg;
+        cg.startIndex = g.startIndex;
+        cg.indexCount = g.indexCount;
+        cg.baseVertex = g.baseVertex;
+        cg.vertexCount = g.vertexCount;
+        cg.indexByteOffset = g.indexByteOffset;
+        cg.indexSize = g.indexSize;
+        cg.nameOffset = (uint32_t)strings.size();
+        cg.nameLength = (uint32_t)g.diffuseTexture.size();
+        strings += g.diffuseTexture;
+        groups.push_back(cg);
+    }
+
+    std::string lodRecords;
+    for (const auto& lod : mesh.lods) {
+        lodRecords.append(reinterpret_cast<const char*>(&lod.error), sizeof(float));
+        for (const auto& range : lod.groups) {
+            MeshCacheLodRange r = { range.startIndex, range.indexCount, range.indexByteOffset };
+            lodRecords.append(reinterpret_cast<const char*>(&r), sizeof(r));
+        }
+    }
+
+    MeshCacheHeader header;
+    std::memcpy(header.magic, kMeshCacheMagic, 4);
+    header.version = kMeshCacheVersion;
+    header.sourceSize = key.sourceSize;
+    header.sourceMtime = key.sourceMtime;
+    header.sourceHash = key.sourceHash;
+    header.vertexCount = (uint32_t)mesh.vertices.size();
+    header.groupCount = (uint32_t)groups.size();
+    header.stringBytes = (uint32_t)strings.size();
+    header.lodCount = (uint32_t)mesh.lods.size();
+    header.reserved = 0;
+    size_t stringsEnd = sizeof(header) + groups.size() * sizeof(MeshCacheGroup)
+                      + lodRecords.size() + strings.size();
+    header.vertexOffset = (uint32_t)alignUp(stringsEnd, kVertexAlignment);
+    size_t verticesEnd = header.vertexOffset + mesh.vertices.size() * sizeof(ObjVertex);
+    header.indexBytes = (uint32_t)mesh.indexBytes.size();
+    header.indexOffset = (uint32_t)alignUp(verticesEnd, kVertexAlignment);
+
+    //scriem intr-un fisier temporar si il redenumim, ca sa nu ramana un cache pe jumatate
+    std::string finalPath = meshCachePath(objPath);
+    std::string tmpPath = finalPath + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            std::cerr << "Cannot write mesh cache: " << tmpPath << "\n";
+            return false;
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(groups.data()), groups.size() * sizeof(MeshCacheGroup));
+        out.write(lodRecords.data(), lodRecords.size());
+        out.write(strings.data(), strings.size());
+        static const char padding[kVertexAlignment] = {};
+        out.write(padding, header.vertexOffset - stringsEnd);
+        out.write(reinterpret_cast<const char*>(mesh.vertices.data()),
+                  mesh.vertices.size() * sizeof(ObjVertex));
+        out.write(padding, header.indexOffset - verticesEnd);
+        out.write(reinterpret_cast<const char*>(mesh.indexBytes.data()), mesh.indexBytes.size());
+        if (!out) {
+            std::cerr << "Cannot write mesh cache: " << tmpPath << "\n";
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmpPath, finalPath, ec);
+    if (ec) {
+        std::filesystem::remove(tmpPath, ec);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "MappedFile.h"
+#include "MeshData.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//cache binar pentru OBJ-uri, scris langa fisierul sursa (<obj>.meshcache)
+//contine varfurile sudate si optimizate, indicii impachetati (cu LOD-urile),
+//tabela de grupuri de materiale si intervalele fiecarui LOD,
+//deci la pornirile urmatoare nu mai trecem prin tinyobj
+constexpr uint32_t kMeshCacheVersion = 5;
+
+//cheia cache-ului: marimea totala, cel mai nou mtime si hash-ul continutului pentru OBJ si MTL-urile lui
+//(numele texturilor din tabela de grupuri vin din MTL)
+struct MeshCacheKey {
+    uint64_t sourceSize = 0;
+    int64_t sourceMtime = 0;
+    uint64_t sourceHash = 0;
+};
+
+//vedere peste un cache mapat in memorie; vertices si indexBytes arata direct in mapare
+//(fisierul separat, intrarea din pack-ul montat, sau storage daca intrarea era comprimata)
+struct MeshCacheView {
+    MappedFile file;
+    std::vector<uint8_t> storage;
+    const ObjVertex* vertices = nullptr;
+    uint32_t vertexCount = 0;
+    const uint8_t* indexBytes = nullptr;
+    uint32_t indexByteCount = 0;
+    std::vector<MeshGroupData> groups;
+    std::vector<MeshLodData> lods;
+};
+
+std::string meshCachePath(const std::string& objPath);
+//OBJ-ul urmat de MTL-urile din liniile lui mtllib care exista; gol daca OBJ-ul nu se poate citi
+std::vector<std::string> meshSourceFiles(const std::string& objPath);
+bool computeMeshCacheKey(const std::string& objPath, MeshCacheKey& key);
+
+//cauta intai in assetPack(), apoi langa sursa
+//intoarce false daca cache-ul lipseste, e corupt sau nu corespunde sursei
+bool openMeshCache(const std::string& objPath, MeshCacheView& view);
+bool writeMeshCache(const std::string& objPath, const MeshData& mesh);
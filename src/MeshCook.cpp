@@ -0,0 +1,44 @@
+#include "MeshCook.h"
+#include "MeshCache.h"
+#include "MeshIndexing.h"
+#include "MeshOptimizer.h"
+#include "MeshSimplifier.h"
+#include "ObjParser.h"
+
+#include <iostream>
+
+namespace {
+
+bool parseObj(const std::string& path, const std::string& baseDir, MeshData& mesh) {
+    //parserul propriu imparte fisierul pe thread-uri, rezultatul e acelasi ca la tinyobj
+    ObjParseResult obj;
+    std::string err;
+    bool ok = parseObjFile(path, baseDir, obj, err);
+
+    if (!obj.warnings.empty()) std::cout << "OBJ warn: " << obj.warnings << "\n";
+    if (!err.empty())  std::cerr << "OBJ err: " << err << "\n";
+    if (!ok) return false;
+
+    buildMeshData(obj, mesh);
+    return true;
+}
+
+} // namespace
+
+bool cookMesh(const std::string& path, const std::string& baseDir, MeshData& mesh, MeshCookStats& stats) {
+    if (!parseObj(path, baseDir, mesh)) return false;
+    stats.soupVertices = mesh.vertices.size();
+    weldVertices(mesh);
+    //ordinea triunghiurilor pentru cache/overdraw se calculeaza o data si ajunge in cache
+    MeshOptimizeStats optStats;
+    optimizeMesh(mesh, &optStats);
+    std::cout << "Optimized OBJ: " << path
+              << " ACMR " << optStats.before.acmr() << " -> " << optStats.after.acmr()
+              << " ATVR " << optStats.before.atvr() << " -> " << optStats.after.atvr() << "\n";
+    stats.triangles = mesh.indices.size() / 3;
+    generateLods(mesh);
+    if (!writeMeshCache(path, mesh)) {
+        std::cerr << "Mesh cache not written for: " << path << "\n";
+    }
+    return true;
+}
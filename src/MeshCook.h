@@ -0,0 +1,16 @@
+#pragma once
+
+#include "MeshData.h"
+
+#include <cstddef>
+#include <string>
+
+//ce a facut gatirea, pentru log
+struct MeshCookStats {
+    size_t soupVertices = 0;    //varfuri inainte de sudare
+    size_t triangles = 0;
+};
+
+//OBJ -> MeshData gata de urcat: parsare, sudare, optimizare, LOD-uri, apoi scrie <obj>.meshcache
+//fara OpenGL, folosita si de ObjModel si de asset_cooker
+bool cookMesh(const std::string& path, const std::string& baseDir, MeshData& mesh, MeshCookStats& stats);
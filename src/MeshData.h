@@ -0,0 +1,49 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//datele de pe CPU ale unui model, fara nimic legat de OpenGL
+//le folosesc ObjModel, cache-ul binar si uneltele offline
+struct ObjVertex {
+    glm::vec3 pos;
+    glm::vec3 normal;
+    glm::vec2 uv;
+};
+
+//un grup = un material; indicii sunt locali grupului (se adauga baseVertex)
+//inainte de sudare indices e gol si grupul e o lista de triunghiuri in vertices
+struct MeshGroupData {
+    uint32_t startIndex = 0;        //primul index din MeshData::indices
+    uint32_t indexCount = 0;
+    uint32_t baseVertex = 0;        //primul varf al grupului din MeshData::vertices
+    uint32_t vertexCount = 0;
+    uint32_t indexByteOffset = 0;   //pozitia in indexBytes, dupa packIndices
+    uint32_t indexSize = 4;         //2 daca grupul incape pe 16 biti, altfel 4
+    std::string diffuseTexture;
+};
+
+//un nivel de detaliu refoloseste varfurile grupului, doar indicii difera
+struct MeshLodRange {
+    uint32_t startIndex = 0;
+    uint32_t indexCount = 0;
+    uint32_t indexByteOffset = 0;
+};
+
+struct MeshLodData {
+    float error = 0.0f;                 //abaterea geometrica, in unitatile modelului
+    std::vector<MeshLodRange> groups;   //cate unul pentru fiecare MeshGroupData
+};
+
+struct MeshData {
+    std::vector<ObjVertex> vertices;
+    std::vector<uint32_t> indices;
+    std::vector<MeshGroupData> groups;
+    //nivelurile 1..n; nivelul 0 (complet) e descris direct de groups
+    std::vector<MeshLodData> lods;
+    //indicii in forma urcata pe GPU (16 sau 32 biti pe grup)
+    std::vector<uint8_t> indexBytes;
+};
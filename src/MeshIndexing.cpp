@@ -0,0 +1,104 @@
+#include "MeshIndexing.h"
+#include "Hash.h"
+
+#include <cstring>
+#include <unordered_map>
+
+namespace {
+
+//comparam bitii exact, deci doar varfurile perfect identice sunt unite
+struct VertexKeyHash {
+    size_t operator()(const ObjVertex& v) const {
+        return (size_t)hashBytes(&v, sizeof(ObjVertex));
+    }
+};
+
+struct VertexKeyEqual {
+    bool operator()(const ObjVertex& a, const ObjVertex& b) const {
+        return std::memcmp(&a, &b, sizeof(ObjVertex)) == 0;
+    }
+};
+
+} // namespace
+
+void weldVertices(MeshData& mesh) {
+    if (!mesh.indices.empty()) return;
+
+    std::vector<ObjVertex> unique;
+    std::vector<uint32_t> indices;
+    unique.reserve(mesh.vertices.size() / 2);
+    indices.reserve(mesh.vertices.size());
+
+    std::unordered_map<ObjVertex, uint32_t, VertexKeyHash, VertexKeyEqual> lookup;
+    for (auto& group : mesh.groups) {
+        lookup.clear();
+        lookup.reserve(group.vertexCount);
+
+        uint32_t baseVertex = (uint32_t)unique.size();
+        uint32_t startIndex = (uint32_t)indices.size();
+        for (uint32_t i = 0; i < group.vertexCount; i++) {
+            const ObjVertex& v = mesh.vertices[group.baseVertex + i];
+            auto it = lookup.find(v);
+            if (it == lookup.end()) {
+                uint32_t local = (uint32_t)unique.size() - baseVertex;
+                lookup.emplace(v, local);
+                unique.push_back(v);
+                indices.push_back(local);
+            } else {
+                indices.push_back(it->second);
+            }
+        }
+        group.startIndex = startIndex;
+        group.indexCount = group.vertexCount;
+        group.baseVertex = baseVertex;
+        group.vertexCount = (uint32_t)unique.size() - baseVertex;
+    }
+
+    mesh.vertices = std::move(unique);
+    mesh.indices = std::move(indices);
+    packIndices(mesh);
+}
+
+void packIndices(MeshData& mesh) {
+    size_t totalBytes = 0;
+    auto place = [&totalBytes](uint32_t indexCount, uint32_t indexSize) {
+        //pastram offset-urile aliniate la 4 pentru grupurile pe 32 de biti
+        totalBytes = (totalBytes + 3) & ~(size_t)3;
+        uint32_t offset = (uint32_t)totalBytes;
+        totalBytes += (size_t)indexCount * indexSize;
+        return offset;
+    };
+    for (auto& group : mesh.groups) {
+        group.indexSize = group.vertexCount <= 65536 ? 2 : 4;
+        group.indexByteOffset = place(group.indexCount, group.indexSize);
+    }
+    //LOD-urile folosesc aceleasi varfuri, deci si aceeasi marime de index ca grupul
+    for (auto& lod : mesh.lods) {
+        for (size_t g = 0; g < lod.groups.size(); g++) {
+            lod.groups[g].indexByteOffset = place(lod.groups[g].indexCount, mesh.groups[g].indexSize);
+        }
+    }
+
+    mesh.indexBytes.assign(totalBytes, 0);
+    auto write = [&mesh](uint32_t startIndex, uint32_t indexCount, uint32_t indexByteOffset, uint32_t indexSize) {
+        uint8_t* dst = mesh.indexBytes.data() + indexByteOffset;
+        const uint32_t* src = mesh.indices.data() + startIndex;
+        if (indexSize == 2) {
+            for (uint32_t i = 0; i < indexCount; i++) {
+                uint16_t idx = (uint16_t)src[i];
+                std::memcpy(dst + i * 2, &idx, 2);
+            }
+        } else {
+            std::memcpy(dst, src, (size_t)indexCount * 4);
+        }
+    };
+    for (const auto& group : mesh.groups) {
+        write(group.startIndex, group.indexCount, group.indexByteOffset, group.indexSize);
+    }
+    for (const auto& lod : mesh.lods) {
+        for (size_t g = 0; g < lod.groups.size(); g++) {
+            const MeshLodRange& range = lod.groups[g];
+            write(range.startIndex, range.indexCount, range.indexByteOffset, mesh.groups[g].indexSize);
+        }
+    }
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "MeshData.h"
+
+//sudeaza varfurile identice (pos, normal, uv) din fiecare grup si construieste
+//lista de indici; varfurile sunt renumerotate in ordinea primei folosiri
+void weldVertices(MeshData& mesh);
+
+//scrie indicii in indexBytes: 16 biti cand grupul are cel mult 65536 de varfuri
+void packIndices(MeshData& mesh);
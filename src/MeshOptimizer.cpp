@@ -0,0 +1,342 @@
+#include "MeshOptimizer.h"
+#include "MeshIndexing.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+//parametrii din "Linear-Speed Vertex Cache Optimisation" (Tom Forsyth)
+constexpr int kForsythCacheSize = 32;
+constexpr float kCacheDecayPower = 1.5f;
+constexpr float kLastTriScore = 0.75f;
+constexpr float kValenceBoostScale = 2.0f;
+constexpr float kValenceBoostPower = 0.5f;
+constexpr int kMaxValence = 32;
+
+struct ForsythTables {
+    float cache[kForsythCacheSize];
+    float valence[kMaxValence + 1];
+
+    ForsythTables() {
+        for (int i = 0; i < kForsythCacheSize; i++) {
+            if (i < 3) {
+                cache[i] = kLastTriScore;
+            } else {
+                float scaler = 1.0f / (kForsythCacheSize - 3);
+                cache[i] = std::pow(1.0f - (i - 3) * scaler, kCacheDecayPower);
+            }
+        }
+        valence[0] = 0.0f;
+        for (int i = 1; i <= kMaxValence; i++) {
+            valence[i] = kValenceBoostScale * std::pow((float)i, -kValenceBoostPower);
+        }
+    }
+};
+
+float vertexScore(const ForsythTables& tables, int cachePosition, uint32_t liveTriangles) {
+    //varful nu mai e folosit de niciun triunghi ramas
+    if (liveTriangles == 0) return -1.0f;
+    float score = cachePosition >= 0 ? tables.cache[cachePosition] : 0.0f;
+    return score + tables.valence[std::min<uint32_t>(liveTriangles, kMaxValence)];
+}
+
+//FIFO simulat cu timestamp-uri: un varf e in cache daca a fost adaugat
+//in ultimele cacheSize ratari; restart-ul goleste cache-ul sarind timpul inainte
+struct FifoCache {
+    std::vector<uint32_t> insertTime;
+    uint32_t time;
+    unsigned size;
+
+    FifoCache(size_t vertexCount, unsigned cacheSize)
+        : insertTime(vertexCount, 0), time(cacheSize + 1), size(cacheSize) {}
+
+    unsigned access(uint32_t v) {
+        if (time - insertTime[v] > size) {
+            insertTime[v] = time++;
+            return 1;
+        }
+        return 0;
+    }
+
+    void flush() { time += size + 1; }
+};
+
+glm::vec3 triangleCross(const ObjVertex* vertices, const uint32_t* tri) {
+    glm::vec3 a = vertices[tri[0]].pos;
+    glm::vec3 b = vertices[tri[1]].pos;
+    glm::vec3 c = vertices[tri[2]].pos;
+    return glm::cross(b - a, c - a);
+}
+
+} // namespace
+
+VertexCacheStats analyzeVertexCache(const uint32_t* indices, size_t indexCount,
+                                    size_t vertexCount, unsigned cacheSize) {
+    VertexCacheStats stats;
+    stats.triangles = indexCount / 3;
+
+    std::vector<bool> used(vertexCount, false);
+    FifoCache cache(vertexCount, cacheSize);
+    for (size_t i = 0; i < indexCount; i++) {
+        uint32_t v = indices[i];
+        if (!used[v]) {
+            used[v] = true;
+            stats.uniqueVertices++;
+        }
+        stats.transformedVertices += cache.access(v);
+    }
+    return stats;
+}
+
+void optimizeVertexCache(uint32_t* indices, size_t indexCount, size_t vertexCount) {
+    static const ForsythTables tables;
+    size_t triangleCount = indexCount / 3;
+    if (triangleCount == 0) return;
+
+    //lista de triunghiuri pentru fiecare varf; primele liveCount sunt cele neemise
+    std::vector<uint32_t> adjacencyOffset(vertexCount + 1, 0);
+    for (size_t i = 0; i < indexCount; i++) adjacencyOffset[indices[i] + 1]++;
+    for (size_t v = 0; v < vertexCount; v++) adjacencyOffset[v + 1] += adjacencyOffset[v];
+    std::vector<uint32_t> liveCount(vertexCount, 0);
+    std::vector<uint32_t> adjacency(indexCount);
+    for (size_t i = 0; i < indexCount; i++) {
+        uint32_t v = indices[i];
+        adjacency[adjacencyOffset[v] + liveCount[v]++] = (uint32_t)(i / 3);
+    }
+
+    std::vector<int> cachePosition(vertexCount, -1);
+    std::vector<float> score(vertexCount);
+    for (size_t v = 0; v < vertexCount; v++) score[v] = vertexScore(tables, -1, liveCount[v]);
+
+    std::vector<float> triangleScore(triangleCount);
+    std::vector<bool> emitted(triangleCount, false);
+    uint32_t best = 0;
+    for (size_t t = 0; t < triangleCount; t++) {
+        const uint32_t* tri = indices + t * 3;
+        triangleScore[t] = score[tri[0]] + score[tri[1]] + score[tri[2]];
+        if (triangleScore[t] > triangleScore[best]) best = (uint32_t)t;
+    }
+
+    std::vector<uint32_t> result;
+    result.reserve(indexCount);
+    std::vector<uint32_t> cache;
+    std::vector<uint32_t> newCache;
+    cache.reserve(kForsythCacheSize + 3);
+    newCache.reserve(kForsythCacheSize + 3);
+    size_t cursor = 0;
+
+    for (size_t emittedCount = 0; emittedCount < triangleCount; emittedCount++) {
+        //fundatura: luam urmatorul triunghi neemis in ordinea originala
+        if (best == UINT32_MAX) {
+            while (emitted[cursor]) cursor++;
+            best = (uint32_t)cursor;
+        }
+
+        const uint32_t* tri = indices + (size_t)best * 3;
+        emitted[best] = true;
+        newCache.clear();
+        for (int k = 0; k < 3; k++) {
+            uint32_t v = tri[k];
+            result.push_back(v);
+            newCache.push_back(v);
+
+            uint32_t* list = adjacency.data() + adjacencyOffset[v];
+            for (uint32_t j = 0; j < liveCount[v]; j++) {
+                if (list[j] == best) {
+                    list[j] = list[liveCount[v] - 1];
+                    liveCount[v]--;
+                    break;
+                }
+            }
+        }
+        for (uint32_t v : cache) {
+            if (v != tri[0] && v != tri[1] && v != tri[2]) newCache.push_back(v);
+        }
+
+        //actualizam scorurile varfurilor din cache si ale triunghiurilor lor
+        best = UINT32_MAX;
+        float bestScore = -1.0f;
+        for (size_t i = 0; i < newCache.size(); i++) {
+            uint32_t v = newCache[i];
+            int position = i < (size_t)kForsythCacheSize ? (int)i : -1;
+            cachePosition[v] = position;
+            float newScore = vertexScore(tables, position, liveCount[v]);
+            float delta = newScore - score[v];
+            score[v] = newScore;
+
+            const uint32_t* list = adjacency.data() + adjacencyOffset[v];
+            for (uint32_t j = 0; j < liveCount[v]; j++) {
+                uint32_t t = list[j];
+                triangleScore[t] += delta;
+                if (triangleScore[t] > bestScore) {
+                    bestScore = triangleScore[t];
+                    best = t;
+                }
+            }
+        }
+        if (newCache.size() > (size_t)kForsythCacheSize) newCache.resize(kForsythCacheSize);
+        cache.swap(newCache);
+    }
+
+    std::copy(result.begin(), result.end(), indices);
+}
+
+void optimizeOverdraw(uint32_t* indices, size_t indexCount, const ObjVertex* vertices,
+                      size_t vertexCount, float threshold) {
+    size_t triangleCount = indexCount / 3;
+    if (triangleCount < 2) return;
+
+    //granite dure: triunghiuri la care toate cele 3 varfuri rateaza cache-ul
+    std::vector<size_t> clusters;
+    {
+        FifoCache cache(vertexCount, kVertexCacheSimSize);
+        for (size_t t = 0; t < triangleCount; t++) {
+            const uint32_t* tri = indices + t * 3;
+            unsigned misses = cache.access(tri[0]) + cache.access(tri[1]) + cache.access(tri[2]);
+            if (t == 0 || misses == 3) clusters.push_back(t);
+        }
+    }
+
+    //granite moi: taiem mai departe cat timp ACMR-ul local ramane sub prag
+    std::vector<size_t> softClusters;
+    FifoCache cache(vertexCount, kVertexCacheSimSize);
+    for (size_t c = 0; c < clusters.size(); c++) {
+        size_t start = clusters[c];
+        size_t end = c + 1 < clusters.size() ? clusters[c + 1] : triangleCount;
+
+        cache.flush();
+        unsigned clusterMisses = 0;
+        for (size_t t = start; t < end; t++) {
+            const uint32_t* tri = indices + t * 3;
+            clusterMisses += cache.access(tri[0]) + cache.access(tri[1]) + cache.access(tri[2]);
+        }
+        float clusterThreshold = threshold * (float)clusterMisses / (float)(end - start);
+
+        softClusters.push_back(start);
+        cache.flush();
+        unsigned runningMisses = 0;
+        unsigned runningTriangles = 0;
+        for (size_t t = start; t < end; t++) {
+            const uint32_t* tri = indices + t * 3;
+            runningMisses += cache.access(tri[0]) + cache.access(tri[1]) + cache.access(tri[2]);
+            runningTriangles++;
+            if (t + 1 < end && (float)runningMisses / runningTriangles <= clusterThreshold) {
+                softClusters.push_back(t + 1);
+                cache.flush();
+                runningMisses = 0;
+                runningTriangles = 0;
+            }
+        }
+    }
+
+    //centrul mesh-ului, ponderat cu aria triunghiurilor
+    glm::vec3 meshCenter(0.0f);
+    float meshArea = 0.0f;
+    for (size_t t = 0; t < triangleCount; t++) {
+        const uint32_t* tri = indices + t * 3;
+        float area = glm::length(triangleCross(vertices, tri));
+        meshCenter += (vertices[tri[0]].pos + vertices[tri[1]].pos + vertices[tri[2]].pos) * (area / 3.0f);
+        meshArea += area;
+    }
+    if (meshArea > 0.0f) meshCenter /= meshArea;
+
+    //clusterele orientate spre exterior si aflate departe de centru se deseneaza primele
+    struct ClusterSort {
+        float key;
+        size_t start;
+        size_t end;
+    };
+    std::vector<ClusterSort> sorted;
+    sorted.reserve(softClusters.size());
+    for (size_t c = 0; c < softClusters.size(); c++) {
+        size_t start = softClusters[c];
+        size_t end = c + 1 < softClusters.size() ? softClusters[c + 1] : triangleCount;
+
+        glm::vec3 center(0.0f);
+        glm::vec3 normal(0.0f);
+        float area = 0.0f;
+        for (size_t t = start; t < end; t++) {
+            const uint32_t* tri = indices + t * 3;
+            glm::vec3 cross = triangleCross(vertices, tri);
+            float triArea = glm::length(cross);
+            center += (vertices[tri[0]].pos + vertices[tri[1]].pos + vertices[tri[2]].pos) * (triArea / 3.0f);
+            normal += cross;
+            area += triArea;
+        }
+        float key = 0.0f;
+        float normalLength = glm::length(normal);
+        if (area > 0.0f && normalLength > 0.0f) {
+            key = glm::dot(center / area - meshCenter, normal / normalLength);
+        }
+        sorted.push_back({ key, start, end });
+    }
+    std::stable_sort(sorted.begin(), sorted.end(),
+                     [](const ClusterSort& a, const ClusterSort& b) { return a.key > b.key; });
+
+    std::vector<uint32_t> result;
+    result.reserve(indexCount);
+    for (const auto& cluster : sorted) {
+        result.insert(result.end(), indices + cluster.start * 3, indices + cluster.end * 3);
+    }
+    std::copy(result.begin(), result.end(), indices);
+}
+
+void optimizeVertexFetch(MeshData& mesh) {
+    std::vector<ObjVertex> vertices;
+    vertices.reserve(mesh.vertices.size());
+    std::vector<uint32_t> remap;
+
+    for (size_t g = 0; g < mesh.groups.size(); g++) {
+        MeshGroupData& group = mesh.groups[g];
+        remap.assign(group.vertexCount, UINT32_MAX);
+        uint32_t baseVertex = (uint32_t)vertices.size();
+        uint32_t* indices = mesh.indices.data() + group.startIndex;
+        for (uint32_t i = 0; i < group.indexCount; i++) {
+            uint32_t& local = remap[indices[i]];
+            if (local == UINT32_MAX) {
+                local = (uint32_t)vertices.size() - baseVertex;
+                vertices.push_back(mesh.vertices[group.baseVertex + indices[i]]);
+            }
+            indices[i] = local;
+        }
+        //LOD-urile folosesc un subset din varfurile nivelului 0
+        for (auto& lod : mesh.lods) {
+            uint32_t* lodIndices = mesh.indices.data() + lod.groups[g].startIndex;
+            for (uint32_t i = 0; i < lod.groups[g].indexCount; i++) lodIndices[i] = remap[lodIndices[i]];
+        }
+        group.baseVertex = baseVertex;
+        group.vertexCount = (uint32_t)vertices.size() - baseVertex;
+    }
+
+    mesh.vertices = std::move(vertices);
+}
+
+void optimizeMesh(MeshData& mesh, MeshOptimizeStats* stats) {
+    auto accumulate = [&mesh](VertexCacheStats& total) {
+        for (const auto& group : mesh.groups) {
+            VertexCacheStats s = analyzeVertexCache(mesh.indices.data() + group.startIndex,
+                                                    group.indexCount, group.vertexCount);
+            total.triangles += s.triangles;
+            total.uniqueVertices += s.uniqueVertices;
+            total.transformedVertices += s.transformedVertices;
+        }
+    };
+
+    if (stats) {
+        *stats = MeshOptimizeStats();
+        accumulate(stats->before);
+    }
+
+    for (const auto& group : mesh.groups) {
+        uint32_t* indices = mesh.indices.data() + group.startIndex;
+        const ObjVertex* vertices = mesh.vertices.data() + group.baseVertex;
+        optimizeVertexCache(indices, group.indexCount, group.vertexCount);
+        optimizeOverdraw(indices, group.indexCount, vertices, group.vertexCount);
+    }
+    optimizeVertexFetch(mesh);
+    packIndices(mesh);
+
+    if (stats) accumulate(stats->after);
+}
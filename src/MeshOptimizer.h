@@ -0,0 +1,43 @@
+#pragma once
+
+#include "MeshData.h"
+
+#include <cstddef>
+#include <cstdint>
+
+//statistici pentru cache-ul post-transform simulat ca FIFO
+//ACMR = varfuri transformate / triunghi, ATVR = varfuri transformate / varfuri unice
+struct VertexCacheStats {
+    size_t triangles = 0;
+    size_t uniqueVertices = 0;
+    size_t transformedVertices = 0;
+
+    float acmr() const { return triangles ? (float)transformedVertices / triangles : 0.0f; }
+    float atvr() const { return uniqueVertices ? (float)transformedVertices / uniqueVertices : 0.0f; }
+};
+
+struct MeshOptimizeStats {
+    VertexCacheStats before;
+    VertexCacheStats after;
+};
+
+//marimea FIFO-ului folosit la masuratori (ordinul de marime al GPU-urilor actuale)
+constexpr unsigned kVertexCacheSimSize = 16;
+
+VertexCacheStats analyzeVertexCache(const uint32_t* indices, size_t indexCount,
+                                    size_t vertexCount, unsigned cacheSize = kVertexCacheSimSize);
+
+//reordoneaza triunghiurile pentru reutilizarea cache-ului (algoritmul lui Forsyth, LRU de 32)
+void optimizeVertexCache(uint32_t* indices, size_t indexCount, size_t vertexCount);
+
+//imparte lista in clustere la granitele dure ale cache-ului si le sorteaza
+//din exterior spre interior, ca sa scada overdraw-ul; threshold limiteaza cat
+//ACMR acceptam sa pierdem cand mai taiem clustere
+void optimizeOverdraw(uint32_t* indices, size_t indexCount, const ObjVertex* vertices,
+                      size_t vertexCount, float threshold = 1.05f);
+
+//renumeroteaza varfurile in ordinea primei folosiri (localitate la fetch)
+void optimizeVertexFetch(MeshData& mesh);
+
+//ruleaza toate etapele pe fiecare grup al unui mesh sudat si reimpacheteaza indicii
+void optimizeMesh(MeshData& mesh, MeshOptimizeStats* stats = nullptr);
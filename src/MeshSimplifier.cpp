@@ -0,0 +1,292 @@
+#include "MeshSimplifier.h"
+#include "MeshIndexing.h"
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace {
+
+//eroarea maxima a unui LOD, relativa la diagonala cutiei mesh-ului
+constexpr float kMaxRelativeLodError = 0.05f;
+//un nivel care pastreaza mai mult de atat din indicii celui anterior nu merita
+constexpr float kMinLodGain = 0.85f;
+
+//forma quadrica simetrica (A, b, c) pentru suma distantelor la patrat fata de plane
+struct Quadric {
+    double a00 = 0, a01 = 0, a02 = 0, a11 = 0, a12 = 0, a22 = 0;
+    double b0 = 0, b1 = 0, b2 = 0;
+    double c = 0;
+    double weight = 0;
+
+    void addPlane(glm::dvec3 n, double d, double w) {
+        a00 += w * n.x * n.x; a01 += w * n.x * n.y; a02 += w * n.x * n.z;
+        a11 += w * n.y * n.y; a12 += w * n.y * n.z; a22 += w * n.z * n.z;
+        b0 += w * n.x * d; b1 += w * n.y * d; b2 += w * n.z * d;
+        c += w * d * d;
+        weight += w;
+    }
+
+    void add(const Quadric& q) {
+        a00 += q.a00; a01 += q.a01; a02 += q.a02;
+        a11 += q.a11; a12 += q.a12; a22 += q.a22;
+        b0 += q.b0; b1 += q.b1; b2 += q.b2;
+        c += q.c;
+        weight += q.weight;
+    }
+
+    //distanta medie la patrat a punctului fata de planele acumulate
+    double error(glm::dvec3 p) const {
+        double e = a00 * p.x * p.x + a11 * p.y * p.y + a22 * p.z * p.z
+                 + 2.0 * (a01 * p.x * p.y + a02 * p.x * p.z + a12 * p.y * p.z)
+                 + 2.0 * (b0 * p.x + b1 * p.y + b2 * p.z) + c;
+        return weight > 0 ? std::max(e, 0.0) / weight : 0.0;
+    }
+};
+
+struct PositionHash {
+    size_t operator()(const glm::vec3& p) const {
+        uint32_t bits[3];
+        std::memcpy(bits, &p, sizeof(bits));
+        return (size_t)bits[0] * 73856093u ^ (size_t)bits[1] * 19349663u ^ (size_t)bits[2] * 83492791u;
+    }
+};
+
+struct Collapse {
+    uint32_t from;
+    uint32_t to;
+    double cost;
+};
+
+//marcheaza varfurile care nu au voie sa se mute: cusaturi si margini
+std::vector<bool> findLockedVertices(const uint32_t* indices, size_t indexCount,
+                                     const ObjVertex* vertices, size_t vertexCount) {
+    //varfurile cu aceeasi pozitie sunt unite intr-un singur varf "geometric"
+    std::vector<uint32_t> position(vertexCount);
+    std::vector<uint32_t> wedges;
+    std::unordered_map<glm::vec3, uint32_t, PositionHash> lookup;
+    lookup.reserve(vertexCount);
+    for (size_t v = 0; v < vertexCount; v++) {
+        auto it = lookup.emplace(vertices[v].pos, (uint32_t)wedges.size()).first;
+        if (it->second == wedges.size()) wedges.push_back(0);
+        position[v] = it->second;
+        wedges[it->second]++;
+    }
+
+    //o muchie fara pereche in sens invers e pe margine
+    std::unordered_set<uint64_t> edges;
+    edges.reserve(indexCount);
+    for (size_t i = 0; i < indexCount; i += 3) {
+        for (int k = 0; k < 3; k++) {
+            uint32_t a = position[indices[i + k]];
+            uint32_t b = position[indices[i + (k + 1) % 3]];
+            edges.insert((uint64_t)a << 32 | b);
+        }
+    }
+    std::vector<bool> borderPosition(wedges.size(), false);
+    for (size_t i = 0; i < indexCount; i += 3) {
+        for (int k = 0; k < 3; k++) {
+            uint32_t a = position[indices[i + k]];
+            uint32_t b = position[indices[i + (k + 1) % 3]];
+            if (!edges.count((uint64_t)b << 32 | a)) {
+                borderPosition[a] = true;
+                borderPosition[b] = true;
+            }
+        }
+    }
+
+    std::vector<bool> locked(vertexCount);
+    for (size_t v = 0; v < vertexCount; v++) {
+        locked[v] = wedges[position[v]] > 1 || borderPosition[position[v]];
+    }
+    return locked;
+}
+
+} // namespace
+
+float simplifyIndices(const uint32_t* indices, size_t indexCount,
+                      const ObjVertex* vertices, size_t vertexCount,
+                      size_t targetIndexCount, float maxError,
+                      std::vector<uint32_t>& out) {
+    out.assign(indices, indices + indexCount);
+    if (indexCount <= targetIndexCount) return 0.0f;
+
+    std::vector<bool> locked = findLockedVertices(indices, indexCount, vertices, vertexCount);
+
+    //quadrica fiecarui varf, din planele triunghiurilor vecine ponderate cu aria
+    std::vector<Quadric> quadrics(vertexCount);
+    for (size_t i = 0; i < indexCount; i += 3) {
+        glm::dvec3 p0 = vertices[indices[i]].pos;
+        glm::dvec3 p1 = vertices[indices[i + 1]].pos;
+        glm::dvec3 p2 = vertices[indices[i + 2]].pos;
+        glm::dvec3 n = glm::cross(p1 - p0, p2 - p0);
+        double area = glm::length(n);
+        if (area <= 0.0) continue;
+        n /= area;
+        double d = -glm::dot(n, p0);
+        for (int k = 0; k < 3; k++) quadrics[indices[i + k]].addPlane(n, d, area);
+    }
+
+    double maxCost = (double)maxError * maxError;
+    double resultError = 0.0;
+    std::vector<uint32_t> adjacencyOffset(vertexCount + 1);
+    std::vector<uint32_t> adjacency;
+    std::vector<Collapse> collapses;
+    std::vector<bool> touched(vertexCount);
+
+    while (out.size() > targetIndexCount) {
+        size_t triangleCount = out.size() / 3;
+
+        //triunghiurile fiecarui varf, refacute la fiecare trecere
+        std::fill(adjacencyOffset.begin(), adjacencyOffset.end(), 0);
+        for (uint32_t v : out) adjacencyOffset[v + 1]++;
+        for (size_t v = 0; v < vertexCount; v++) adjacencyOffset[v + 1] += adjacencyOffset[v];
+        adjacency.resize(out.size());
+        {
+            std::vector<uint32_t> fill(adjacencyOffset.begin(), adjacencyOffset.end() - 1);
+            for (size_t i = 0; i < out.size(); i++) adjacency[fill[out[i]]++] = (uint32_t)(i / 3);
+        }
+
+        collapses.clear();
+        for (size_t i = 0; i < out.size(); i += 3) {
+            for (int k = 0; k < 3; k++) {
+                uint32_t a = out[i + k];
+                uint32_t b = out[i + (k + 1) % 3];
+                if (!locked[a]) collapses.push_back({ a, b, quadrics[a].error(vertices[b].pos) });
+                if (!locked[b]) collapses.push_back({ b, a, quadrics[b].error(vertices[a].pos) });
+            }
+        }
+        if (collapses.empty()) break;
+        std::sort(collapses.begin(), collapses.end(),
+                  [](const Collapse& x, const Collapse& y) { return x.cost < y.cost; });
+
+        //in aceeasi trecere un varf si vecinii lui participa la cel mult o colapsare
+        std::fill(touched.begin(), touched.end(), false);
+        size_t removedTriangles = 0;
+        size_t neededTriangles = triangleCount - targetIndexCount / 3;
+        bool errorLimitReached = false;
+        for (const Collapse& c : collapses) {
+            if (removedTriangles >= neededTriangles) break;
+            if (c.cost > maxCost) {
+                errorLimitReached = true;
+                break;
+            }
+            if (touched[c.from] || touched[c.to]) continue;
+
+            //respingem colapsarile care ar intoarce vreun triunghi pe dos
+            glm::vec3 target = vertices[c.to].pos;
+            bool flips = false;
+            size_t collapsing = 0;
+            for (uint32_t j = adjacencyOffset[c.from]; j < adjacencyOffset[c.from + 1] && !flips; j++) {
+                const uint32_t* tri = out.data() + (size_t)adjacency[j] * 3;
+                if (tri[0] == c.to || tri[1] == c.to || tri[2] == c.to) {
+                    collapsing++;
+                    continue;
+                }
+                glm::vec3 p[3];
+                glm::vec3 q[3];
+                for (int k = 0; k < 3; k++) {
+                    p[k] = vertices[tri[k]].pos;
+                    q[k] = tri[k] == c.from ? target : p[k];
+                }
+                glm::vec3 before = glm::cross(p[1] - p[0], p[2] - p[0]);
+                glm::vec3 after = glm::cross(q[1] - q[0], q[2] - q[0]);
+                if (glm::dot(before, after) <= 0.0f) flips = true;
+            }
+            if (flips || collapsing == 0) continue;
+
+            for (uint32_t j = adjacencyOffset[c.from]; j < adjacencyOffset[c.from + 1]; j++) {
+                uint32_t* tri = out.data() + (size_t)adjacency[j] * 3;
+                for (int k = 0; k < 3; k++) {
+                    touched[tri[k]] = true;
+                    if (tri[k] == c.from) tri[k] = c.to;
+                }
+            }
+            quadrics[c.to].add(quadrics[c.from]);
+            resultError = std::max(resultError, c.cost);
+            removedTriangles += collapsing;
+        }
+
+        //scoatem triunghiurile degenerate ramase dupa colapsari
+        size_t write = 0;
+        for (size_t i = 0; i < out.size(); i += 3) {
+            uint32_t a = out[i], b = out[i + 1], c = out[i + 2];
+            if (a == b || b == c || a == c) continue;
+            out[write++] = a;
+            out[write++] = b;
+            out[write++] = c;
+        }
+        out.resize(write);
+
+        if (removedTriangles == 0 || errorLimitReached) break;
+    }
+
+    return (float)std::sqrt(resultError);
+}
+
+void generateLods(MeshData& mesh, unsigned maxLevels) {
+    mesh.lods.clear();
+    if (mesh.vertices.empty()) return;
+
+    glm::vec3 minPos = mesh.vertices[0].pos;
+    glm::vec3 maxPos = mesh.vertices[0].pos;
+    for (const auto& v : mesh.vertices) {
+        minPos = glm::min(minPos, v.pos);
+        maxPos = glm::max(maxPos, v.pos);
+    }
+    float maxError = glm::length(maxPos - minPos) * kMaxRelativeLodError;
+
+    //nivelul anterior, pornind de la cel complet
+    std::vector<MeshLodRange> previous(mesh.groups.size());
+    size_t previousTotal = 0;
+    for (size_t g = 0; g < mesh.groups.size(); g++) {
+        previous[g].startIndex = mesh.groups[g].startIndex;
+        previous[g].indexCount = mesh.groups[g].indexCount;
+        previousTotal += mesh.groups[g].indexCount;
+    }
+    float previousError = 0.0f;
+
+    std::vector<uint32_t> simplified;
+    for (unsigned level = 1; level < maxLevels; level++) {
+        MeshLodData lod;
+        lod.groups.resize(mesh.groups.size());
+        size_t levelStart = mesh.indices.size();
+        size_t total = 0;
+        float levelError = 0.0f;
+
+        for (size_t g = 0; g < mesh.groups.size(); g++) {
+            const MeshGroupData& group = mesh.groups[g];
+            size_t target = (size_t)(previous[g].indexCount * kLodReduction) / 3 * 3;
+            //copiem sursa, pentru ca insert-ul de mai jos poate realoca indices
+            std::vector<uint32_t> source(mesh.indices.begin() + previous[g].startIndex,
+                                         mesh.indices.begin() + previous[g].startIndex + previous[g].indexCount);
+            float error = simplifyIndices(source.data(), source.size(),
+                                          mesh.vertices.data() + group.baseVertex, group.vertexCount,
+                                          target, maxError - previousError, simplified);
+            optimizeVertexCache(simplified.data(), simplified.size(), group.vertexCount);
+
+            lod.groups[g].startIndex = (uint32_t)mesh.indices.size();
+            lod.groups[g].indexCount = (uint32_t)simplified.size();
+            mesh.indices.insert(mesh.indices.end(), simplified.begin(), simplified.end());
+            total += simplified.size();
+            levelError = std::max(levelError, error);
+        }
+
+        if (total == 0 || (float)total > previousTotal * kMinLodGain) {
+            mesh.indices.resize(levelStart);
+            break;
+        }
+
+        //erorile se aduna de la un nivel la altul, deci pastram o margine superioara
+        lod.error = previousError + levelError;
+        previous = lod.groups;
+        previousTotal = total;
+        previousError = lod.error;
+        mesh.lods.push_back(std::move(lod));
+    }
+
+    packIndices(mesh);
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "MeshData.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//simplificare prin colapsarea muchiilor (u -> v), ordonate dupa eroarea quadrica
+//varfurile de pe cusaturi (aceeasi pozitie, normala/uv diferite) si de pe margini
+//nu se muta, deci UV-urile si contururile raman intacte
+//intoarce eroarea obtinuta (distanta aproximativa, in unitatile modelului)
+float simplifyIndices(const uint32_t* indices, size_t indexCount,
+                      const ObjVertex* vertices, size_t vertexCount,
+                      size_t targetIndexCount, float maxError,
+                      std::vector<uint32_t>& out);
+
+//cate niveluri generam cel mult si cat de mult vrem sa scada fiecare
+constexpr unsigned kMaxLodLevels = 4;
+constexpr float kLodReduction = 0.5f;
+
+//construieste lantul de LOD-uri in mesh.lods, fiecare nivel pornind de la cel anterior;
+//se opreste cand un nivel nu mai castiga destul sau eroarea ar deveni prea mare
+void generateLods(MeshData& mesh, unsigned maxLevels = kMaxLodLevels);
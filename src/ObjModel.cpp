@@ -1,193 +1,508 @@
 #include "ObjModel.h"
+#include "AssetRegistry.h"
+#include "GeometryArena.h"
+#include "MaterialArrays.h"
+#include "MeshCache.h"
+#include "MeshCook.h"
+#include "MemoryStats.h"
+#include "ObjParser.h"
+#include "Profiler.h"
+#include "RenderStats.h"
 
-#include <tiny_obj_loader.h>
-#include <stb_image.h>
+#include "Texture.h"
+#include "TextureStreamer.h"
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <cmath>
 
-static glm::vec3 calcNormal(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c) {
-    return glm::normalize(glm::cross(b - a, c - a));
+//datele pregatite pe CPU: fie mapate din cache, fie construite acum
+struct ObjModel::PreparedMesh {
+    MeshCacheView cached;
+    MeshData mesh;
+    bool fromCache = false;
+    size_t soupVertices = 0;
+    size_t triangles = 0;
+    std::vector<float> uvDensity;   //cate una pentru fiecare grup
+};
+
+//starea incarcarii in flux, trece prin worker -> GL (mapare) -> worker -> GL (unmap)
+struct ObjModel::StreamedMesh {
+    std::string path;
+    std::string baseDir;
+    MeshHandle target;
+    int maxTextureDimension = -1;
+
+    ObjStreamReader reader;
+    Arena arena;
+    std::vector<MeshGroupData> groups;  //cu indicii 0..n-1 din fiecare grup
+    size_t vertexBytes = 0;
+    size_t indexBytes = 0;
+    ObjVertex* vertices = nullptr;      //VBO-ul mapat
+    uint8_t* indices = nullptr;         //EBO-ul mapat
+    std::string error;
+    size_t rssBefore = 0;
+};
+
+namespace {
+
+std::string directoryOf(const std::string& path) {
+    std::string baseDir = ".";
+    auto slash = path.find_last_of("/\\");
+    if (slash != std::string::npos) baseDir = path.substr(0, slash + 1);
+    return baseDir;
 }
 
-GLuint ObjModel::loadTextureFromFile(const std::string& filename) {
-    if (filename.empty()) return 0;
+//varianta din registru, separata de VertexFormat ca sa nu amestecam buffer-ele
+constexpr int kStreamedVariant = 0x100;
+
+//maparea nu tine de VAO; tinta de copiere nu strica legaturile GL_ARRAY_BUFFER/VAO curente
+void* mapWholeBuffer(GLuint buffer, size_t size) {
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    void* ptr = glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, (GLsizeiptr)size,
+                                 GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    return ptr;
+}
+
+//false inseamna ca datele s-au pierdut cat timp bufferul era mapat
+bool unmapBuffer(GLuint buffer) {
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    GLboolean ok = glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    return ok == GL_TRUE;
+}
 
-    std::string fullPath = basePath + filename;
-    //incarca imaginea folosind stb_image
-    int width, height, channels;
-    stbi_set_flip_vertically_on_load(true);
-    unsigned char* data = stbi_load(fullPath.c_str(), &width, &height, &channels, 0);
+const TextureAsset* readyTexture(const TextureHandle& texture) {
+    return texture && texture->state == AssetState::Ready && texture->id ? texture.get() : nullptr;
+}
 
-    if (!data) {
-        std::cerr << "Failed to load texture: " << fullPath << "\n";
-        return 0;
+//sqrt(aria UV / aria geometrica) peste triunghiurile grupului; cat de des se repeta textura
+float groupUvDensity(const ObjVertex* vertices, const uint8_t* indexBytes, const MeshGroupData& group) {
+    auto index = [&](uint32_t i) -> uint32_t {
+        const uint8_t* p = indexBytes + group.indexByteOffset + (size_t)i * group.indexSize;
+        if (group.indexSize == 2) {
+            uint16_t v;
+            std::memcpy(&v, p, 2);
+            return group.baseVertex + v;
+        }
+        uint32_t v;
+        std::memcpy(&v, p, 4);
+        return group.baseVertex + v;
+    };
+    double uvArea = 0.0, worldArea = 0.0;
+    for (uint32_t i = 0; i + 2 < group.indexCount; i += 3) {
+        const ObjVertex& a = vertices[index(i)];
+        const ObjVertex& b = vertices[index(i + 1)];
+        const ObjVertex& c = vertices[index(i + 2)];
+        worldArea += 0.5 * glm::length(glm::cross(b.pos - a.pos, c.pos - a.pos));
+        glm::vec2 e1 = b.uv - a.uv, e2 = c.uv - a.uv;
+        uvArea += 0.5 * std::fabs(e1.x * e2.y - e1.y * e2.x);
     }
-    //formatul texturii
-    GLenum format = (channels == 4) ? GL_RGBA : GL_RGB;
+    if (worldArea <= 0.0) return 0.0f;
+    return (float)std::sqrt(uvArea / worldArea);
+}
+
+} // namespace
+
+TextureHandle ObjModel::loadMaterialTexture(const std::string& baseDir, const std::string& filename,
+                                            AssetLoader* loader, int maxDimension) {
+    if (filename.empty()) return nullptr;
+
+    std::string fullPath = baseDir + filename;
+    if (loader) return loader->loadTexture(fullPath, TextureUsage::Material, maxDimension);
 
-    GLuint textureID;
-    glGenTextures(1, &textureID);
-    glBindTexture(GL_TEXTURE_2D, textureID);
-    //paremetrii texturii
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    //incarca datele in textura OpenGL
-    glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-    glGenerateMipmap(GL_TEXTURE_2D);
+    TextureLoadOptions options = queryTextureLoadOptions();
+    options.maxDimension = std::max(maxDimension, 0);
+    bool created = false;
+    TextureHandle texture = assetRegistry().acquireTexture(
+        fullPath, textureVariant(TextureUsage::Material, options.maxDimension), created);
+    if (!created) return texture;
 
-    stbi_image_free(data);
+    //incarca imaginea (din cache-ul comprimat sau cu stb_image)
+    PreparedTexture prepared;
+    if (!prepareTexture(fullPath, TextureUsage::Material, options, prepared)) {
+        texture->state = AssetState::Failed;
+        return texture;
+    }
+    texture->id = uploadPreparedTexture(prepared, options.immutableStorage, texture->gpuBytes);
+    texture->state = AssetState::Ready;
     std::cout << "Loaded material texture: " << fullPath << "\n";
-    return textureID;
+    return texture;
 }
 
-bool ObjModel::load(const std::string& path) {
-    //diferenenta intre atribut si uniform este ca atributele sunt specifice fiecarui varf, uniformele sunt constante pentru toate varfurile
-    tinyobj::attrib_t attrib;
-    std::vector<tinyobj::shape_t> shapes;
-    std::vector<tinyobj::material_t> materials;
-    std::string warn, err;
+bool ObjModel::load(const std::string& path, VertexFormat format) {
+    basePath = directoryOf(path);
 
-    std::string baseDir = ".";
-    auto slash = path.find_last_of("/\\");
-    if (slash != std::string::npos) baseDir = path.substr(0, slash + 1);
-    basePath = baseDir;
+    bool created = false;
+    mesh = assetRegistry().acquireMesh(path, (int)format, created);
+    if (!created) return mesh->state != AssetState::Failed;
+    mesh->vertexFormat = format;
+
+    PreparedMesh prepared;
+    if (!prepareMesh(path, basePath, prepared)) {
+        mesh->state = AssetState::Failed;
+        return false;
+    }
+    finishLoad(path, basePath, prepared, *mesh, nullptr, maxTextureDimension);
+    return true;
+}
 
-    bool ok = tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &err,
-                              path.c_str(), baseDir.c_str(), true);
+void ObjModel::loadAsync(AssetLoader& loader, const std::string& path, VertexFormat format) {
+    basePath = directoryOf(path);
 
-    if (!warn.empty()) std::cout << "OBJ warn: " << warn << "\n";
-    if (!err.empty())  std::cerr << "OBJ err: " << err << "\n";
-    if (!ok) return false;
+    bool created = false;
+    mesh = assetRegistry().acquireMesh(path, (int)format, created);
+    //deja incarcat sau in incarcare pentru alt model
+    if (!created) return;
+    mesh->vertexFormat = format;
 
-    vertices.clear();
-    vertices.reserve(200000);
-    materialGroups.clear();
+    //handle-ul tine buffer-ele in viata pana la upload, chiar daca modelul dispare intre timp
+    MeshHandle target = mesh;
+    std::string baseDir = basePath;
+    int maxDimension = maxTextureDimension;
+    loader.submit([target, &loader, path, baseDir, maxDimension]() -> AssetLoader::UploadTask {
+        PROFILE_ZONE("prepare mesh");
+        auto prepared = std::make_shared<PreparedMesh>();
+        if (!prepareMesh(path, baseDir, *prepared)) {
+            return [target] { target->state = AssetState::Failed; };
+        }
+        return [target, &loader, path, baseDir, prepared, maxDimension] {
+            finishLoad(path, baseDir, *prepared, *target, &loader, maxDimension);
+        };
+    });
+}
 
-    std::map<int, std::vector<ObjVertex>> materialVertices;
+void ObjModel::loadStreaming(AssetLoader& loader, const std::string& path) {
+    basePath = directoryOf(path);
 
-    for (const auto& shape : shapes) {
-        size_t idxOffset = 0;
-        for (size_t f = 0; f < shape.mesh.num_face_vertices.size(); f++) {
-            int fv = shape.mesh.num_face_vertices[f];
-            if (fv != 3) {
-                idxOffset += fv;
-                continue;
-            }
+    bool created = false;
+    mesh = assetRegistry().acquireMesh(path, kStreamedVariant, created);
+    if (!created) return;
+    mesh->vertexFormat = VertexFormat::Float;
 
-            int materialID = shape.mesh.material_ids[f];
-            ObjVertex v[3];
-            bool hasNormals = true;
-
-            for (int k = 0; k < 3; k++) {
-                tinyobj::index_t idx = shape.mesh.indices[idxOffset + k];
-
-                v[k].pos = glm::vec3(
-                    attrib.vertices[3*idx.vertex_index + 0],
-                    attrib.vertices[3*idx.vertex_index + 1],
-                    attrib.vertices[3*idx.vertex_index + 2]
-                );
-
-                if (idx.normal_index >= 0) {
-                    v[k].normal = glm::vec3(
-                        attrib.normals[3*idx.normal_index + 0],
-                        attrib.normals[3*idx.normal_index + 1],
-                        attrib.normals[3*idx.normal_index + 2]
-                    );
-                } else {
-                    hasNormals = false;
-                    v[k].normal = glm::vec3(0, 1, 0);
-                }
+    auto streamed = std::make_shared<StreamedMesh>();
+    streamed->path = path;
+    streamed->baseDir = basePath;
+    streamed->target = mesh;
+    streamed->maxTextureDimension = maxTextureDimension;
+    streamed->rssBefore = currentResidentBytes();
+    loader.submit([streamed, &loader]() -> AssetLoader::UploadTask {
+        //prima trecere: doar numaratori si MTL-uri
+        StreamedMesh& s = *streamed;
+        if (!s.reader.open(s.path, s.baseDir, s.error) || s.reader.vertexCount() == 0) {
+            std::cerr << "Failed to stream OBJ: " << s.path << "\n" << s.error;
+            MeshHandle target = s.target;
+            return [target] { target->state = AssetState::Failed; };
+        }
+        //indicii sunt consecutivi in fiecare grup, pe 16 biti cand incap
+        s.groups = s.reader.groups();
+        size_t offset = 0;
+        for (auto& group : s.groups) {
+            group.indexCount = group.vertexCount;
+            group.indexSize = group.vertexCount <= 65536 ? 2 : 4;
+            group.indexByteOffset = (uint32_t)offset;
+            offset = (offset + (size_t)group.indexCount * group.indexSize + 3) & ~(size_t)3;
+        }
+        s.indexBytes = offset;
+        s.vertexBytes = (size_t)s.reader.vertexCount() * sizeof(ObjVertex);
+        return [streamed, &loader] { mapStreamedBuffers(loader, streamed); };
+    });
+}
 
-                if (idx.texcoord_index >= 0) {
-                    float u = attrib.texcoords[2 * idx.texcoord_index + 0];
-                    float vv = attrib.texcoords[2 * idx.texcoord_index + 1];
-                    v[k].uv = glm::vec2(u, vv);
+void ObjModel::mapStreamedBuffers(AssetLoader& loader, const std::shared_ptr<StreamedMesh>& streamed) {
+    StreamedMesh& s = *streamed;
+    MeshAsset& mesh = *s.target;
+    //buffer-e de trecere: la final continutul lor se copiaza pe GPU in arena si ele se sterg
+    glGenBuffers(1, &mesh.VBO);
+    glGenBuffers(1, &mesh.EBO);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, mesh.VBO);
+    glBufferData(GL_COPY_WRITE_BUFFER, (GLsizeiptr)s.vertexBytes, nullptr, GL_STREAM_COPY);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, mesh.EBO);
+    glBufferData(GL_COPY_WRITE_BUFFER, (GLsizeiptr)s.indexBytes, nullptr, GL_STREAM_COPY);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    //buffer-ele raman mapate cat lucreaza worker-ul; nimeni nu le deseneaza pana la Ready
+    s.vertices = static_cast<ObjVertex*>(mapWholeBuffer(mesh.VBO, s.vertexBytes));
+    s.indices = static_cast<uint8_t*>(mapWholeBuffer(mesh.EBO, s.indexBytes));
+    if (!s.vertices || !s.indices) {
+        std::cerr << "Failed to map buffers for OBJ: " << s.path << "\n";
+        if (s.vertices) unmapBuffer(mesh.VBO);
+        if (s.indices) unmapBuffer(mesh.EBO);
+        mesh.state = AssetState::Failed;
+        return;
+    }
+
+    //a doua trecere scrie direct in memoria driver-ului
+    loader.submit([streamed, &loader]() -> AssetLoader::UploadTask {
+        StreamedMesh& s = *streamed;
+        if (s.reader.read(s.vertices, s.arena, s.error)) {
+            for (const auto& group : s.groups) {
+                uint8_t* dst = s.indices + group.indexByteOffset;
+                if (group.indexSize == 2) {
+                    uint16_t* out = reinterpret_cast<uint16_t*>(dst);
+                    for (uint32_t i = 0; i < group.indexCount; i++) out[i] = (uint16_t)i;
                 } else {
-                    v[k].uv = glm::vec2(0.0f, 0.0f);
+                    uint32_t* out = reinterpret_cast<uint32_t*>(dst);
+                    for (uint32_t i = 0; i < group.indexCount; i++) out[i] = i;
                 }
             }
+        } else if (s.error.empty()) {
+            s.error = "read failed\n";
+        }
+        return [streamed, &loader] { finishStreaming(loader, *streamed); };
+    });
+}
 
-            if (!hasNormals) {
-                glm::vec3 n = calcNormal(v[0].pos, v[1].pos, v[2].pos);
-                v[0].normal = v[1].normal = v[2].normal = n;
-            }
-            materialVertices[materialID].push_back(v[0]);
-            materialVertices[materialID].push_back(v[1]);
-            materialVertices[materialID].push_back(v[2]);
-            idxOffset += 3;
+void ObjModel::finishStreaming(AssetLoader& loader, StreamedMesh& s) {
+    MeshAsset& mesh = *s.target;
+    bool verticesOk = unmapBuffer(mesh.VBO);
+    bool indicesOk = unmapBuffer(mesh.EBO);
+    size_t arenaPeak = s.arena.peakBytes();
+    s.arena.release();
+    if (!s.error.empty() || !verticesOk || !indicesOk) {
+        std::cerr << "Failed to stream OBJ: " << s.path << "\n" << s.error;
+        mesh.state = AssetState::Failed;
+        return;
+    }
+
+    if (!s.reader.warnings().empty()) std::cout << "OBJ warn: " << s.reader.warnings() << "\n";
+
+    std::vector<float> uvDensity;
+    for (size_t i = 0; i < s.groups.size(); i++) uvDensity.push_back(s.reader.uvDensity(i));
+    createMaterialGroups(mesh, s.baseDir, s.groups, {}, uvDensity, &loader, s.maxTextureDimension);
+    mesh.quantization = QuantizationBounds();
+    mesh.boundsCenter = (s.reader.boundsMin() + s.reader.boundsMax()) * 0.5f;
+    mesh.boundsRadius = glm::length(s.reader.boundsMax() - s.reader.boundsMin()) * 0.5f;
+    //in arena ca orice mesh static: acelasi VAO, indexul desenarii din baseInstance, loturi indirecte
+    GeometryArena& arena = geometryArena(VertexFormat::Float);
+    arena.allocateCopy(mesh.VBO, s.reader.vertexCount(), mesh.EBO, s.indexBytes, mesh.arenaRange);
+    glDeleteBuffers(1, &mesh.VBO);
+    glDeleteBuffers(1, &mesh.EBO);
+    mesh.VBO = mesh.EBO = 0;
+    placeInArena(mesh, arena);
+    mesh.gpuBytes = s.vertexBytes + s.indexBytes;
+    mesh.state = AssetState::Ready;
+
+    size_t peakRss = peakResidentBytes();
+    std::cout << "Streamed OBJ: " << s.path << " verts=" << s.reader.vertexCount()
+              << " materials=" << s.groups.size() << " arena peak=" << arenaPeak / 1024 << " KB"
+              << " peak RSS=" << peakRss / (1024 * 1024) << " MB (+"
+              << (peakRss > s.rssBefore ? (peakRss - s.rssBefore) / (1024 * 1024) : 0) << " MB)\n";
+}
+
+bool ObjModel::prepareMesh(const std::string& path, const std::string& baseDir, PreparedMesh& prepared) {
+    //daca avem un cache valid il mapam si il trimitem direct la GPU
+    if (openMeshCache(path, prepared.cached)) {
+        prepared.fromCache = true;
+        const MeshCacheView& cached = prepared.cached;
+        for (const auto& group : cached.groups) {
+            prepared.uvDensity.push_back(groupUvDensity(cached.vertices, cached.indexBytes, group));
         }
+        return true;
+    }
+
+    MeshData& mesh = prepared.mesh;
+    MeshCookStats stats;
+    if (!cookMesh(path, baseDir, mesh, stats)) return false;
+    prepared.soupVertices = stats.soupVertices;
+    prepared.triangles = stats.triangles;
+    for (const auto& group : mesh.groups) {
+        prepared.uvDensity.push_back(groupUvDensity(mesh.vertices.data(), mesh.indexBytes.data(), group));
     }
-    for (auto& pair : materialVertices) {
-        int matID = pair.first;
-        std::vector<ObjVertex>& matVerts = pair.second;
+    return true;
+}
+
+void ObjModel::finishLoad(const std::string& path, const std::string& baseDir, PreparedMesh& prepared,
+                          MeshAsset& mesh, AssetLoader* loader, int maxTextureDimension) {
+    if (prepared.fromCache) {
+        const MeshCacheView& cached = prepared.cached;
+        createMaterialGroups(mesh, baseDir, cached.groups, cached.lods, prepared.uvDensity,
+                             loader, maxTextureDimension);
+        uploadToGPU(mesh, cached.vertices, cached.vertexCount, cached.indexBytes, cached.indexByteCount);
+        std::cout << "Loaded OBJ (cache): " << path << " verts=" << cached.vertexCount
+                  << " materials=" << cached.groups.size() << " lods=" << mesh.lodLevels.size() << "\n";
+    } else {
+        const MeshData& data = prepared.mesh;
+        createMaterialGroups(mesh, baseDir, data.groups, data.lods, prepared.uvDensity,
+                             loader, maxTextureDimension);
+        std::cout << "Loaded OBJ: " << path << " verts=" << data.vertices.size()
+                  << " (from " << prepared.soupVertices << ") tris=" << prepared.triangles
+                  << " materials=" << data.groups.size() << " lods=" << mesh.lodLevels.size() << "\n";
+        uploadToGPU(mesh, data.vertices.data(), data.vertices.size(),
+                    data.indexBytes.data(), data.indexBytes.size());
+    }
+    mesh.state = AssetState::Ready;
+}
+
+void ObjModel::createMaterialGroups(MeshAsset& mesh, const std::string& baseDir,
+                                    const std::vector<MeshGroupData>& groups,
+                                    const std::vector<MeshLodData>& lods,
+                                    const std::vector<float>& uvDensity, AssetLoader* loader,
+                                    int maxTextureDimension) {
+    std::vector<LodLevel>& lodLevels = mesh.lodLevels;
+    lodLevels.clear();
+    LodLevel full;
+    full.error = 0.0f;
+    for (size_t i = 0; i < groups.size(); i++) {
+        const MeshGroupData& g = groups[i];
         MaterialGroup group;
-        group.startIndex = vertices.size();
-        group.vertexCount = matVerts.size();
-        if (matID >= 0 && matID < materials.size()) {
-            const auto& mat = materials[matID];
-            if (!mat.diffuse_texname.empty()) {
-                group.textureID = loadTextureFromFile(mat.diffuse_texname);
-            } else {
-                group.textureID = 0;
-            }
-        } else {
-            group.textureID = 0;
+        group.indexCount = (GLsizei)g.indexCount;
+        group.indexType = g.indexSize == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+        group.indexOffset = g.indexByteOffset;
+        group.baseVertex = (GLint)g.baseVertex;
+        group.texture = loadMaterialTexture(baseDir, g.diffuseTexture, loader, maxTextureDimension);
+        group.uvDensity = i < uvDensity.size() ? uvDensity[i] : 0.0f;
+        full.groups.push_back(group);
+    }
+    lodLevels.push_back(full);
+
+    //LOD-urile au aceleasi texturi si varfuri, doar alt interval din EBO
+    for (const auto& lod : lods) {
+        LodLevel level;
+        level.error = lod.error;
+        level.groups = full.groups;
+        for (size_t i = 0; i < level.groups.size() && i < lod.groups.size(); i++) {
+            level.groups[i].indexCount = (GLsizei)lod.groups[i].indexCount;
+            level.groups[i].indexOffset = lod.groups[i].indexByteOffset;
+        }
+        lodLevels.push_back(level);
+    }
+}
+
+void ObjModel::placeInArena(MeshAsset& mesh, GeometryArena& arena) {
+    mesh.arena = &arena;
+    mesh.VAO = arena.vao();
+    //grupurile tuturor LOD-urilor trec de la offset-uri in mesh la offset-uri in arena
+    for (LodLevel& level : mesh.lodLevels) {
+        for (MaterialGroup& group : level.groups) {
+            group.indexOffset += mesh.arenaRange.indexOffset;
+            group.baseVertex += (GLint)mesh.arenaRange.firstVertex;
         }
-        materialGroups.push_back(group);
-        vertices.insert(vertices.end(), matVerts.begin(), matVerts.end());
     }
-    std::cout << "Loaded OBJ: " << path << " verts=" << vertices.size()
-              << " materials=" << materialGroups.size() << "\n";
-    uploadToGPU();
-    return true;
 }
 // incarcare date in GPU
 //aplicam mai multe materiale pt un singur obiect
-void ObjModel::uploadToGPU() {
-    //VBO este folosit pentru a stoca datele varfurilor
-    //VAO retine configuratia atributelor varfurilor
-    if (VAO == 0) glGenVertexArrays(1, &VAO);
-    if (VBO == 0) glGenBuffers(1, &VBO);
-    glBindVertexArray(VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER,
-                 (GLsizeiptr)(vertices.size() * sizeof(ObjVertex)),
-                 vertices.data(),
-                 GL_STATIC_DRAW);
-    //vertexAttribPointer configureaza modul in care datele varfurilor sunt interpretate de shader
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(ObjVertex), (void*)0);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(ObjVertex), (void*)offsetof(ObjVertex, normal));
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(ObjVertex), (void*)offsetof(ObjVertex, uv));
-    glEnableVertexAttribArray(2);
-    glBindVertexArray(0);
+//varfurile si indicii intra in arena formatului, impartita cu celelalte mesh-uri statice
+void ObjModel::uploadToGPU(MeshAsset& mesh, const ObjVertex* data, size_t count,
+                           const uint8_t* indexBytes, size_t indexByteCount) {
+    if (count > 0) {
+        glm::vec3 minPos = data[0].pos;
+        glm::vec3 maxPos = data[0].pos;
+        for (size_t i = 1; i < count; i++) {
+            minPos = glm::min(minPos, data[i].pos);
+            maxPos = glm::max(maxPos, data[i].pos);
+        }
+        mesh.boundsCenter = (minPos + maxPos) * 0.5f;
+        mesh.boundsRadius = glm::length(maxPos - minPos) * 0.5f;
+    }
+    const void* vertexData = data;
+    std::vector<PackedVertex> packed;
+    if (mesh.vertexFormat == VertexFormat::Packed) {
+        mesh.quantization = computeQuantizationBounds(data, count);
+        packVertices(data, count, mesh.quantization, packed);
+        vertexData = packed.data();
+    } else {
+        mesh.quantization = QuantizationBounds();
+    }
+    if (mesh.arena) mesh.arena->free(mesh.arenaRange);
+    GeometryArena& arena = geometryArena(mesh.vertexFormat);
+    arena.allocate(vertexData, count, indexBytes, indexByteCount, mesh.arenaRange);
+    placeInArena(mesh, arena);
+    mesh.gpuBytes = count * arena.vertexStride() + indexByteCount;
+}
+void ObjModel::release() {
+    mesh.reset();
+    texture.reset();
 }
 void ObjModel::setTexture(GLuint texID) {
-    textureID = texID;
+    texture = makeReadyTexture(texID);
+}
+void ObjModel::setTexture(TextureHandle tex) {
+    texture = std::move(tex);
 }
+
+int ObjModel::selectLod(const glm::mat4& model, const glm::vec3& cameraPos,
+                        float lodScale, float maxPixelError) const {
+    //scara maxima a matricei model, ca eroarea sa nu fie subestimata
+    float scale = std::max({ glm::length(glm::vec3(model[0])),
+                             glm::length(glm::vec3(model[1])),
+                             glm::length(glm::vec3(model[2])) });
+    if (!mesh) return 0;
+    glm::vec3 center = glm::vec3(model * glm::vec4(mesh->boundsCenter, 1.0f));
+    //distanta pana la marginea sferei; din interiorul ei folosim modelul complet
+    float distance = glm::length(center - cameraPos) - mesh->boundsRadius * scale;
+    if (distance <= 0.0f) return 0;
+
+    const std::vector<LodLevel>& lodLevels = mesh->lodLevels;
+    int lod = 0;
+    for (int i = 1; i < (int)lodLevels.size(); i++) {
+        float pixelError = lodLevels[i].error * scale / distance * lodScale;
+        if (pixelError > maxPixelError) break;
+        lod = i;
+    }
+    return lod;
+}
+
+void ObjModel::requestTextureDetail(TextureStreamer& streamer, const glm::mat4& model,
+                                    const glm::vec3& cameraPos, float lodScale) const {
+    if (!isReady() || mesh->lodLevels.empty()) return;
+    float scale = std::max({ glm::length(glm::vec3(model[0])),
+                             glm::length(glm::vec3(model[1])),
+                             glm::length(glm::vec3(model[2])) });
+    glm::vec3 center = glm::vec3(model * glm::vec4(mesh->boundsCenter, 1.0f));
+    //din interiorul sferei cerem ca de foarte aproape
+    float distance = std::max(glm::length(center - cameraPos) - mesh->boundsRadius * scale, 0.05f);
+    //cati pixeli acopera o unitate a modelului la distanta asta
+    float pixelsPerUnit = lodScale * scale / distance;
+    float priority = mesh->boundsRadius * pixelsPerUnit;
+    for (const auto& group : mesh->lodLevels[0].groups) {
+        const TextureHandle& tex = group.texture ? group.texture : texture;
+        streamer.request(tex, group.uvDensity / pixelsPerUnit, priority);
+    }
+}
+
 //aplicam numai o singura textura pentru tot obiectul
 //sau un textura grup pentru fiecare obiect
-void ObjModel::draw() const {
-    glBindVertexArray(VAO);
-    if (materialGroups.empty()) {
-        if (textureID) {
+const LodLevel& ObjModel::lodLevel(int lod) const {
+    const std::vector<LodLevel>& lodLevels = mesh->lodLevels;
+    return lodLevels[std::clamp(lod, 0, (int)lodLevels.size() - 1)];
+}
+
+const TextureAsset* ObjModel::groupTexture(const MaterialGroup& group) const {
+    //texturile inca in incarcare sunt sarite, ca la un model fara textura
+    const TextureAsset* texToUse = readyTexture(group.texture);
+    if (!texToUse) texToUse = readyTexture(texture);
+    return texToUse;
+}
+
+void ObjModel::materialTextures(std::vector<TextureHandle>& textures) const {
+    if (texture) textures.push_back(texture);
+    if (!mesh || mesh->lodLevels.empty()) return;
+    //LOD-urile refolosesc texturile grupurilor din nivelul 0
+    for (const auto& group : mesh->lodLevels[0].groups) {
+        if (group.texture) textures.push_back(group.texture);
+    }
+}
+
+void ObjModel::draw(int lod) const {
+    if (!meshAsset()) return;
+    const LodLevel& level = lodLevel(lod);
+    glBindVertexArray(mesh->VAO);
+    //fara RenderQueue desenarea foloseste prima inregistrare (si prima instanta) a cadrului,
+    //deci si stratul ei din array-ul de materiale
+    glVertexAttribI1ui(kDrawIndexAttribute, 0);
+    for (const auto& group : level.groups) {
+        if (const TextureAsset* texToUse = groupTexture(group)) {
+            glActiveTexture(texToUse->target == GL_TEXTURE_2D ? GL_TEXTURE0 : GL_TEXTURE0 + kMaterialArrayUnit);
+            glBindTexture(texToUse->target, texToUse->id);
             glActiveTexture(GL_TEXTURE0);
-            glBindTexture(GL_TEXTURE_2D, textureID);
-        }
-        glDrawArrays(GL_TRIANGLES, 0, (GLsizei)vertices.size());
-    } else {
-        for (const auto& group : materialGroups) {
-            GLuint texToUse = group.textureID ? group.textureID : textureID;
-            if (texToUse) {
-                glActiveTexture(GL_TEXTURE0);
-                glBindTexture(GL_TEXTURE_2D, texToUse);
-            }
-            glDrawArrays(GL_TRIANGLES, group.startIndex, group.vertexCount);
         }
+        glDrawElementsBaseVertex(GL_TRIANGLES, group.indexCount, group.indexType,
+                                 (void*)group.indexOffset, group.baseVertex);
+        renderStats().drawCalls++;
+        renderStats().triangles += group.indexCount / 3;
     }
     glBindVertexArray(0);
 }
@@ -7,37 +7,91 @@
 #include <vector>
 #include <map>
 
-struct ObjVertex {
-    glm::vec3 pos;
-    glm::vec3 normal;
-    glm::vec2 uv;
-};
+#include "AssetLoader.h"
+#include "AssetTypes.h"
+#include "MeshData.h"
+#include "VertexPacking.h"
 
-struct MaterialGroup {
-    int startIndex;
-    int vertexCount;
-    GLuint textureID;
-};
+class TextureStreamer;
 
 class ObjModel {
 public:
-    bool load(const std::string& path);
+    //Packed injumatateste VBO-ul; shaderele decodeaza cu scara si offset-ul din datele instantei
+    bool load(const std::string& path, VertexFormat format = VertexFormat::Float);
+    //parsarea ruleaza pe worker-ii loader-ului, upload-ul in processUploads/wait pe thread-ul GL
+    //acelasi OBJ (si format) incarcat de mai multe ori foloseste aceleasi buffere din registru
+    void loadAsync(AssetLoader& loader, const std::string& path, VertexFormat format = VertexFormat::Float);
+    //pentru modele mari, cand conteaza memoria de varf: o trecere numara triunghiurile pe material,
+    //a doua scrie varfurile direct in VBO-ul mapat; temporarele stau intr-o arena eliberata la final
+    //nu foloseste cache-ul, nu sudeaza varfurile si nu face LOD-uri; doar VertexFormat::Float
+    //la final varfurile se copiaza pe GPU in arena, ca la celelalte mesh-uri
+    void loadStreaming(AssetLoader& loader, const std::string& path);
+    bool isReady() const { return mesh && mesh->state == AssetState::Ready; }
+    bool hasFailed() const { return mesh && mesh->state == AssetState::Failed; }
+
+    //renunta la handle-uri; buffer-ele se sterg daca nimeni altcineva nu le mai foloseste
+    //(trebuie apelat cat timp contextul GL exista)
+    void release();
+
+    //limita de rezolutie pentru texturile din MTL, setata inainte de load/loadAsync
+    //(< 0 foloseste limita globala a loader-ului; la incarcarea sincrona nu limiteaza)
+    void setMaxTextureDimension(int maxDimension) { maxTextureDimension = maxDimension; }
+
     void setTexture(GLuint texID);
-    void draw() const;
+    void setTexture(TextureHandle texture);
+    //lod 0 e modelul complet; indicii prea mari sunt limitati la cel mai simplu nivel
+    //un model care nu e inca urcat nu deseneaza nimic
+    void draw(int lod = 0) const;
+
+    //alege cel mai simplu LOD a carui eroare proiectata ramane sub maxPixelError
+    //lodScale = inaltimea viewport-ului / (2 * tan(fovy / 2)), in pixeli
+    int selectLod(const glm::mat4& model, const glm::vec3& cameraPos,
+                  float lodScale, float maxPixelError) const;
+    int lodCount() const { return mesh ? (int)mesh->lodLevels.size() : 0; }
+
+    //pentru RenderQueue, care desface modelul in grupuri: nullptr cat timp modelul nu e urcat
+    const MeshAsset* meshAsset() const { return isReady() && !mesh->lodLevels.empty() ? mesh.get() : nullptr; }
+    //acelasi clamp ca la draw; doar pentru un model urcat
+    const LodLevel& lodLevel(int lod) const;
+    //textura din MTL a grupului sau, daca lipseste ori nu e gata, cea a modelului; nullptr daca niciuna nu e gata
+    const TextureAsset* groupTexture(const MaterialGroup& group) const;
+    //texturile modelului si ale grupurilor, pentru MaterialArrays (pot aparea de mai multe ori)
+    void materialTextures(std::vector<TextureHandle>& textures) const;
+
+    //cere streamer-ului nivelul de mip de care au nevoie texturile modelului in cadrul curent
+    //(acelasi lodScale ca la selectLod)
+    void requestTextureDetail(TextureStreamer& streamer, const glm::mat4& model,
+                              const glm::vec3& cameraPos, float lodScale) const;
 
 private:
-    std::vector<ObjVertex> vertices;
     //ca sa pot  desene mai mult materiale din acelasi obiect
     //unifrom exemple, model, view, projection apllicam pentru toate la fel
     //la attribute aplicam diferit pentru fiecare
-    std::vector<MaterialGroup> materialGroups;
-
-    GLuint VAO = 0;
-    GLuint VBO = 0;
-    GLuint textureID = 0;
+    //buffer-ele si grupurile sunt in registru, impartite cu celelalte modele din acelasi OBJ
+    MeshHandle mesh;
+    TextureHandle texture;
 
     std::string basePath;
+    int maxTextureDimension = -1;
 
-    void uploadToGPU();
-    GLuint loadTextureFromFile(const std::string& filename);
+    //partea de CPU a incarcarii (cache sau parsare + optimizare), fara OpenGL
+    struct PreparedMesh;
+    static bool prepareMesh(const std::string& path, const std::string& baseDir, PreparedMesh& prepared);
+    //partea de pe thread-ul GL; loader == nullptr incarca texturile sincron
+    static void finishLoad(const std::string& path, const std::string& baseDir, PreparedMesh& prepared,
+                           MeshAsset& mesh, AssetLoader* loader, int maxTextureDimension);
+    static void createMaterialGroups(MeshAsset& mesh, const std::string& baseDir,
+                                     const std::vector<MeshGroupData>& groups,
+                                     const std::vector<MeshLodData>& lods,
+                                     const std::vector<float>& uvDensity, AssetLoader* loader,
+                                     int maxTextureDimension);
+    struct StreamedMesh;
+    static void mapStreamedBuffers(AssetLoader& loader, const std::shared_ptr<StreamedMesh>& streamed);
+    static void finishStreaming(AssetLoader& loader, StreamedMesh& streamed);
+    //dupa ce arenaRange e alocat: VAO-ul arenei si offset-urile grupurilor in buffer-ele ei
+    static void placeInArena(MeshAsset& mesh, GeometryArena& arena);
+    static void uploadToGPU(MeshAsset& mesh, const ObjVertex* data, size_t count,
+                            const uint8_t* indexBytes, size_t indexByteCount);
+    static TextureHandle loadMaterialTexture(const std::string& baseDir, const std::string& filename,
+                                             AssetLoader* loader, int maxDimension);
 };
@@ -0,0 +1,958 @@
+#include "ObjParser.h"
+#include "MappedFile.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <set>
+#include <thread>
+
+namespace {
+
+//sub aceasta dimensiune nu merita sa pornim mai multe thread-uri
+constexpr size_t kMinChunkBytes = 256 * 1024;
+
+//indicii negativi sunt relativi la numarul de varfuri de pana atunci, pe care
+//o bucata nu il stie; ii tinem relativ la inceputul bucatii si ii corectam la unire
+enum RelativeBits : uint8_t {
+    RelV = 1,
+    RelVt = 2,
+    RelVn = 4
+};
+
+struct RawCorner {
+    int v;
+    int vt;
+    int vn;
+    uint8_t relative;
+};
+
+struct Directive {
+    enum Kind { MtlLib, UseMtl } kind;
+    std::string arg;
+    uint32_t faceIndex;
+};
+
+struct MaterialRun {
+    uint32_t faceIndex;
+    int material;
+};
+
+struct Chunk {
+    const char* begin = nullptr;
+    const char* end = nullptr;
+    size_t firstLine = 0;
+
+    std::vector<float> v, vn, vt;
+    std::vector<RawCorner> corners;
+    std::vector<uint32_t> faceSizes;
+    std::vector<Directive> directives;
+    std::string warnings;
+    std::string error;
+
+    //completate dupa unire
+    size_t vBase = 0, vnBase = 0, vtBase = 0;
+    std::vector<MaterialRun> materialRuns;
+    std::vector<ObjIndex> triIndices;
+    std::vector<int> triMaterials;
+};
+
+//pozitiile xyz vazute la triangulare: vectorul final sau array-ul din arena la incarcarea in flux
+struct FloatSpan {
+    const float* ptr = nullptr;
+    size_t length = 0;
+
+    size_t size() const { return length; }
+    float operator[](size_t i) const { return ptr[i]; }
+};
+
+inline bool isSpace(char c) { return c == ' ' || c == '\t'; }
+inline bool isTokenEnd(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+inline const char* skipSpaces(const char* p, const char* end) {
+    while (p < end && isSpace(*p)) p++;
+    return p;
+}
+
+//acelasi comportament ca parseReal din tinyobj: tokenul se termina la spatiu,
+//iar daca nu se poate citi valoarea ramane cea implicita
+inline float parseFloat(const char*& p, const char* end, float defaultValue = 0.0f) {
+    p = skipSpaces(p, end);
+    const char* tokEnd = p;
+    while (tokEnd < end && !isTokenEnd(*tokEnd)) tokEnd++;
+
+    const char* s = p;
+    if (s < tokEnd && *s == '+') s++;
+    double value = defaultValue;
+    std::from_chars(s, tokEnd, value);
+    p = tokEnd;
+    return (float)value;
+}
+
+//ca atoi: semn optional urmat de cifre, 0 daca nu exista cifre
+inline int parseInt(const char*& p, const char* end) {
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        p++;
+    }
+    int value = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        value = value * 10 + (*p - '0');
+        p++;
+    }
+    return negative ? -value : value;
+}
+
+inline void skipToSeparator(const char*& p, const char* end) {
+    while (p < end && *p != '/' && !isTokenEnd(*p)) p++;
+}
+
+//echivalentul lui fixIndex din tinyobj
+inline bool fixIndex(int idx, int localCount, bool allowZero, int& out, bool& relative, bool& zeroFound) {
+    relative = false;
+    if (idx > 0) {
+        out = idx - 1;
+        return true;
+    }
+    if (idx == 0) {
+        zeroFound = true;
+        out = -1;
+        return allowZero;
+    }
+    out = localCount + idx;
+    relative = true;
+    return true;
+}
+
+//localV/Vn/Vt: cate varfuri de fiecare fel au aparut pana aici (in bucata sau in fisier)
+bool parseFaceCorner(const char*& p, const char* end, int localV, int localVn, int localVt,
+                     RawCorner& c, bool& zeroFound) {
+    bool rel = false;
+
+    c.v = c.vt = c.vn = -1;
+    c.relative = 0;
+
+    if (!fixIndex(parseInt(p, end), localV, false, c.v, rel, zeroFound)) return false;
+    if (rel) c.relative |= RelV;
+    skipToSeparator(p, end);
+    if (p >= end || *p != '/') return true;
+    p++;
+
+    //i//k
+    if (p < end && *p == '/') {
+        p++;
+        if (!fixIndex(parseInt(p, end), localVn, true, c.vn, rel, zeroFound)) return false;
+        if (rel) c.relative |= RelVn;
+        skipToSeparator(p, end);
+        return true;
+    }
+
+    //i/j/k sau i/j
+    if (!fixIndex(parseInt(p, end), localVt, true, c.vt, rel, zeroFound)) return false;
+    if (rel) c.relative |= RelVt;
+    skipToSeparator(p, end);
+    if (p >= end || *p != '/') return true;
+    p++;
+
+    if (!fixIndex(parseInt(p, end), localVn, true, c.vn, rel, zeroFound)) return false;
+    if (rel) c.relative |= RelVn;
+    skipToSeparator(p, end);
+    return true;
+}
+
+void parseChunk(Chunk& chunk) {
+    const char* p = chunk.begin;
+    const char* end = chunk.end;
+    size_t lineNum = chunk.firstLine;
+
+    while (p < end) {
+        const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', (size_t)(end - p)));
+        if (!lineEnd) lineEnd = end;
+        const char* next = lineEnd < end ? lineEnd + 1 : end;
+        if (lineEnd > p && lineEnd[-1] == '\r') lineEnd--;
+        lineNum++;
+
+        const char* t = skipSpaces(p, lineEnd);
+        p = next;
+        if (t >= lineEnd || *t == '#') continue;
+        size_t len = (size_t)(lineEnd - t);
+
+        if (len >= 2 && t[0] == 'v' && isSpace(t[1])) {
+            t += 2;
+            float x = parseFloat(t, lineEnd);
+            float y = parseFloat(t, lineEnd);
+            float z = parseFloat(t, lineEnd);
+            chunk.v.push_back(x);
+            chunk.v.push_back(y);
+            chunk.v.push_back(z);
+            continue;
+        }
+        if (len >= 3 && t[0] == 'v' && t[1] == 'n' && isSpace(t[2])) {
+            t += 3;
+            float x = parseFloat(t, lineEnd);
+            float y = parseFloat(t, lineEnd);
+            float z = parseFloat(t, lineEnd);
+            chunk.vn.push_back(x);
+            chunk.vn.push_back(y);
+            chunk.vn.push_back(z);
+            continue;
+        }
+        if (len >= 3 && t[0] == 'v' && t[1] == 't' && isSpace(t[2])) {
+            t += 3;
+            float x = parseFloat(t, lineEnd);
+            float y = parseFloat(t, lineEnd);
+            chunk.vt.push_back(x);
+            chunk.vt.push_back(y);
+            continue;
+        }
+        if (len >= 2 && t[0] == 'f' && isSpace(t[1])) {
+            t = skipSpaces(t + 2, lineEnd);
+            uint32_t count = 0;
+            bool zeroFound = false;
+            while (t < lineEnd && *t != '#') {
+                RawCorner c;
+                if (!parseFaceCorner(t, lineEnd, (int)(chunk.v.size() / 3), (int)(chunk.vn.size() / 3),
+                                     (int)(chunk.vt.size() / 2), c, zeroFound)) {
+                    chunk.error = "Failed to parse `f' line (e.g. a zero value for vertex index "
+                                  "or invalid relative vertex index). Line " + std::to_string(lineNum) + ").\n";
+                    return;
+                }
+                chunk.corners.push_back(c);
+                count++;
+                while (t < lineEnd && isTokenEnd(*t)) t++;
+            }
+            if (zeroFound) {
+                chunk.warnings += "A zero value index found (will have a value of -1 for normal and "
+                                  "tex indices. Line " + std::to_string(lineNum) + ").\n";
+            }
+            chunk.faceSizes.push_back(count);
+            continue;
+        }
+        if (len >= 6 && std::strncmp(t, "usemtl", 6) == 0) {
+            t = skipSpaces(t + 6, lineEnd);
+            const char* nameEnd = t;
+            while (nameEnd < lineEnd && !isTokenEnd(*nameEnd)) nameEnd++;
+            chunk.directives.push_back({ Directive::UseMtl, std::string(t, nameEnd),
+                                         (uint32_t)chunk.faceSizes.size() });
+            continue;
+        }
+        if (len >= 7 && std::strncmp(t, "mtllib", 6) == 0 && isSpace(t[6])) {
+            chunk.directives.push_back({ Directive::MtlLib, std::string(t + 7, lineEnd),
+                                         (uint32_t)chunk.faceSizes.size() });
+            continue;
+        }
+        //o, g, s, l, p si restul nu ne intereseaza
+    }
+}
+
+//acelasi split ca in tinyobj (spatiu ca separator, '\' ca escape)
+std::vector<std::string> splitMtlLib(const std::string& s) {
+    std::vector<std::string> elems;
+    std::string token;
+    bool escaping = false;
+    for (char ch : s) {
+        if (escaping) {
+            escaping = false;
+        } else if (ch == '\\') {
+            escaping = true;
+            continue;
+        } else if (ch == ' ') {
+            if (!token.empty()) elems.push_back(token);
+            token.clear();
+            continue;
+        }
+        token += ch;
+    }
+    elems.push_back(token);
+    return elems;
+}
+
+std::string mtlDirectory(const std::string& mtlBaseDir) {
+    std::string baseDir = mtlBaseDir;
+    if (!baseDir.empty()) {
+#ifndef _WIN32
+        const char dirsep = '/';
+#else
+        const char dirsep = '\\';
+#endif
+        if (baseDir[baseDir.length() - 1] != dirsep) baseDir += dirsep;
+    }
+    return baseDir;
+}
+
+//MTL-urile deja citite si numele materialelor din ele, in ordinea din fisier
+struct MaterialLibrary {
+    std::vector<tinyobj::material_t> materials;
+    std::map<std::string, int> materialMap;
+    std::set<std::string> loadedFiles;
+};
+
+//o linie mtllib: primul fisier care se poate citi (sau unul deja citit) e de ajuns
+void loadMtlLib(const std::string& arg, tinyobj::MaterialFileReader& reader, MaterialLibrary& library,
+                std::string& warnings) {
+    std::vector<std::string> filenames = splitMtlLib(arg);
+    bool found = false;
+    for (const auto& name : filenames) {
+        if (library.loadedFiles.count(name) > 0) {
+            found = true;
+            continue;
+        }
+        std::string warnMtl, errMtl;
+        bool ok = reader(name, &library.materials, &library.materialMap, &warnMtl, &errMtl);
+        warnings += warnMtl;
+        if (ok) {
+            found = true;
+            library.loadedFiles.insert(name);
+            break;
+        }
+    }
+    if (!found) {
+        warnings += "Failed to load material file(s). Use default material.\n";
+    }
+}
+
+int findMaterial(const MaterialLibrary& library, const std::string& name, std::string& warnings) {
+    auto it = library.materialMap.find(name);
+    if (it != library.materialMap.end()) return it->second;
+    warnings += "material [ '" + name + "' ] not found in .mtl\n";
+    return -1;
+}
+
+//rezolva mtllib/usemtl in ordinea din fisier si calculeaza materialul fiecarei fete
+void resolveMaterials(std::vector<Chunk>& chunks, const std::string& mtlBaseDir, ObjParseResult& out) {
+    tinyobj::MaterialFileReader reader(mtlDirectory(mtlBaseDir));
+    MaterialLibrary library;
+    int material = -1;
+
+    for (auto& chunk : chunks) {
+        chunk.materialRuns.push_back({ 0, material });
+        for (const auto& d : chunk.directives) {
+            if (d.kind == Directive::UseMtl) {
+                material = findMaterial(library, d.arg, out.warnings);
+                chunk.materialRuns.push_back({ d.faceIndex, material });
+                continue;
+            }
+            loadMtlLib(d.arg, reader, library, out.warnings);
+        }
+    }
+    out.materials = std::move(library.materials);
+}
+
+//ear clipping identic cu cel din tinyobj (fara earcut), ca sa avem aceleasi triunghiuri
+template <typename T>
+int pnpoly(int nvert, const T* vertx, const T* verty, T testx, T testy) {
+    int c = 0;
+    for (int i = 0, j = nvert - 1; i < nvert; j = i++) {
+        if (((verty[i] > testy) != (verty[j] > testy)) &&
+            (testx < (vertx[j] - vertx[i]) * (testy - verty[i]) / (verty[j] - verty[i]) + vertx[i]))
+            c = !c;
+    }
+    return c;
+}
+
+void emitTriangle(Chunk& chunk, const ObjIndex& a, const ObjIndex& b, const ObjIndex& c, int material) {
+    chunk.triIndices.push_back(a);
+    chunk.triIndices.push_back(b);
+    chunk.triIndices.push_back(c);
+    chunk.triMaterials.push_back(material);
+}
+
+template <typename Emit>
+void triangulatePolygon(std::vector<ObjIndex> face, FloatSpan v, Emit emit) {
+    size_t npolys = face.size();
+    size_t axes[2] = { 1, 2 };
+    for (size_t k = 0; k < npolys; ++k) {
+        size_t vi0 = (size_t)face[(k + 0) % npolys].v;
+        size_t vi1 = (size_t)face[(k + 1) % npolys].v;
+        size_t vi2 = (size_t)face[(k + 2) % npolys].v;
+        if ((3 * vi0 + 2) >= v.size() || (3 * vi1 + 2) >= v.size() || (3 * vi2 + 2) >= v.size()) continue;
+
+        float e0x = v[vi1 * 3 + 0] - v[vi0 * 3 + 0];
+        float e0y = v[vi1 * 3 + 1] - v[vi0 * 3 + 1];
+        float e0z = v[vi1 * 3 + 2] - v[vi0 * 3 + 2];
+        float e1x = v[vi2 * 3 + 0] - v[vi1 * 3 + 0];
+        float e1y = v[vi2 * 3 + 1] - v[vi1 * 3 + 1];
+        float e1z = v[vi2 * 3 + 2] - v[vi1 * 3 + 2];
+        float cx = std::fabs(e0y * e1z - e0z * e1y);
+        float cy = std::fabs(e0z * e1x - e0x * e1z);
+        float cz = std::fabs(e0x * e1y - e0y * e1x);
+        const float epsilon = std::numeric_limits<float>::epsilon();
+        if (cx > epsilon || cy > epsilon || cz > epsilon) {
+            if (!(cx > cy && cx > cz)) {
+                axes[0] = 0;
+                if (cz > cx && cz > cy) axes[1] = 1;
+            }
+            break;
+        }
+    }
+
+    size_t guessVert = 0;
+    ObjIndex ind[3];
+    float vx[3];
+    float vy[3];
+    size_t remainingIterations = face.size();
+    size_t previousRemaining = face.size();
+
+    while (face.size() > 3 && remainingIterations > 0) {
+        npolys = face.size();
+        if (guessVert >= npolys) guessVert -= npolys;
+
+        if (previousRemaining != npolys) {
+            previousRemaining = npolys;
+            remainingIterations = npolys;
+        } else {
+            remainingIterations--;
+        }
+
+        for (size_t k = 0; k < 3; k++) {
+            ind[k] = face[(guessVert + k) % npolys];
+            size_t vi = (size_t)ind[k].v;
+            if ((vi * 3 + axes[0]) >= v.size() || (vi * 3 + axes[1]) >= v.size()) {
+                vx[k] = 0.0f;
+                vy[k] = 0.0f;
+            } else {
+                vx[k] = v[vi * 3 + axes[0]];
+                vy[k] = v[vi * 3 + axes[1]];
+            }
+        }
+
+        float e0x = vx[1] - vx[0];
+        float e0y = vy[1] - vy[0];
+        float e1x = vx[2] - vx[1];
+        float e1y = vy[2] - vy[1];
+        float cross = e0x * e1y - e0y * e1x;
+        float area = (vx[0] * vy[1] - vy[0] * vx[1]) * 0.5f;
+        if (cross * area < 0.0f) {
+            guessVert += 1;
+            continue;
+        }
+
+        bool overlap = false;
+        for (size_t otherVert = 3; otherVert < npolys; ++otherVert) {
+            size_t idx = (guessVert + otherVert) % npolys;
+            size_t ovi = (size_t)face[idx].v;
+            if ((ovi * 3 + axes[0]) >= v.size() || (ovi * 3 + axes[1]) >= v.size()) continue;
+            float tx = v[ovi * 3 + axes[0]];
+            float ty = v[ovi * 3 + axes[1]];
+            if (pnpoly(3, vx, vy, tx, ty)) {
+                overlap = true;
+                break;
+            }
+        }
+        if (overlap) {
+            guessVert += 1;
+            continue;
+        }
+
+        emit(ind[0], ind[1], ind[2]);
+        face.erase(face.begin() + (long)((guessVert + 1) % npolys));
+    }
+
+    if (face.size() == 3) {
+        emit(face[0], face[1], face[2]);
+    }
+}
+
+//imparte o fata in triunghiuri ca tinyobj; emit(a, b, c) primeste fiecare triunghi
+template <typename Emit>
+void triangulateFace(const std::vector<ObjIndex>& face, FloatSpan v, std::string& warnings, Emit emit) {
+    size_t n = face.size();
+    if (n < 3) {
+        warnings += "Degenerated face found\n.";
+        return;
+    }
+    if (n == 3) {
+        emit(face[0], face[1], face[2]);
+        return;
+    }
+    if (n == 4) {
+        size_t vi0 = (size_t)face[0].v, vi1 = (size_t)face[1].v;
+        size_t vi2 = (size_t)face[2].v, vi3 = (size_t)face[3].v;
+        if ((3 * vi0 + 2) >= v.size() || (3 * vi1 + 2) >= v.size() ||
+            (3 * vi2 + 2) >= v.size() || (3 * vi3 + 2) >= v.size()) {
+            warnings += "Face with invalid vertex index found.\n";
+            return;
+        }
+        //alegem diagonala mai scurta, ca tinyobj
+        float e02x = v[vi2 * 3 + 0] - v[vi0 * 3 + 0];
+        float e02y = v[vi2 * 3 + 1] - v[vi0 * 3 + 1];
+        float e02z = v[vi2 * 3 + 2] - v[vi0 * 3 + 2];
+        float e13x = v[vi3 * 3 + 0] - v[vi1 * 3 + 0];
+        float e13y = v[vi3 * 3 + 1] - v[vi1 * 3 + 1];
+        float e13z = v[vi3 * 3 + 2] - v[vi1 * 3 + 2];
+        float sqr02 = e02x * e02x + e02y * e02y + e02z * e02z;
+        float sqr13 = e13x * e13x + e13y * e13y + e13z * e13z;
+        if (sqr02 < sqr13) {
+            emit(face[0], face[1], face[2]);
+            emit(face[0], face[2], face[3]);
+        } else {
+            emit(face[0], face[1], face[3]);
+            emit(face[1], face[2], face[3]);
+        }
+        return;
+    }
+    triangulatePolygon(face, v, emit);
+}
+
+//corecteaza indicii relativi si imparte fetele in triunghiuri
+void triangulateChunk(Chunk& chunk, const std::vector<float>& v) {
+    size_t corner = 0;
+    size_t run = 0;
+    std::vector<ObjIndex> face;
+    FloatSpan positions = { v.data(), v.size() };
+    chunk.triIndices.reserve(chunk.corners.size() * 2);
+
+    for (size_t f = 0; f < chunk.faceSizes.size(); f++) {
+        while (run + 1 < chunk.materialRuns.size() && chunk.materialRuns[run + 1].faceIndex <= f) run++;
+        int material = chunk.materialRuns[run].material;
+
+        uint32_t n = chunk.faceSizes[f];
+        face.resize(n);
+        for (uint32_t k = 0; k < n; k++) {
+            const RawCorner& c = chunk.corners[corner + k];
+            ObjIndex& idx = face[k];
+            idx.v = c.v + ((c.relative & RelV) ? (int)chunk.vBase : 0);
+            idx.vt = c.vt + ((c.relative & RelVt) ? (int)chunk.vtBase : 0);
+            idx.vn = c.vn + ((c.relative & RelVn) ? (int)chunk.vnBase : 0);
+            if (idx.v < 0 || idx.vt < -1 || idx.vn < -1 ||
+                ((c.relative & RelVt) && idx.vt < 0) || ((c.relative & RelVn) && idx.vn < 0)) {
+                chunk.error = "Failed to parse `f' line (e.g. a zero value for vertex index "
+                              "or invalid relative vertex index).\n";
+                return;
+            }
+        }
+        corner += n;
+
+        triangulateFace(face, positions, chunk.warnings,
+                        [&](const ObjIndex& a, const ObjIndex& b, const ObjIndex& c) {
+                            emitTriangle(chunk, a, b, c, material);
+                        });
+    }
+}
+
+template <typename Fn>
+void runParallel(std::vector<Chunk>& chunks, Fn fn) {
+    if (chunks.size() == 1) {
+        fn(chunks[0]);
+        return;
+    }
+    std::vector<std::thread> workers;
+    workers.reserve(chunks.size() - 1);
+    for (size_t i = 1; i < chunks.size(); i++) {
+        workers.emplace_back([&fn, &chunks, i] { fn(chunks[i]); });
+    }
+    fn(chunks[0]);
+    for (auto& w : workers) w.join();
+}
+
+} // namespace
+
+std::vector<std::string> objMtlLibraries(const char* data, size_t size, const std::string& mtlBaseDir) {
+    std::vector<std::string> paths;
+    std::string baseDir = mtlDirectory(mtlBaseDir);
+    const char* p = data;
+    const char* end = data + size;
+    while (p < end) {
+        const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', (size_t)(end - p)));
+        if (!lineEnd) lineEnd = end;
+        const char* next = lineEnd < end ? lineEnd + 1 : end;
+        if (lineEnd > p && lineEnd[-1] == '\r') lineEnd--;
+        const char* t = skipSpaces(p, lineEnd);
+        p = next;
+        size_t len = (size_t)(lineEnd - t);
+        if (len < 7 || std::strncmp(t, "mtllib", 6) != 0 || !isSpace(t[6])) continue;
+        for (const auto& name : splitMtlLib(std::string(t + 7, lineEnd))) {
+            if (name.empty()) continue;
+            std::string path = baseDir + name;
+            if (std::find(paths.begin(), paths.end(), path) == paths.end()) paths.push_back(path);
+        }
+    }
+    return paths;
+}
+
+bool parseObjBuffer(const char* data, size_t size, const std::string& mtlBaseDir,
+                    ObjParseResult& out, std::string& err, unsigned threadCount) {
+    out = ObjParseResult();
+
+    //BOM UTF-8
+    if (size >= 3 && (unsigned char)data[0] == 0xEF && (unsigned char)data[1] == 0xBB &&
+        (unsigned char)data[2] == 0xBF) {
+        data += 3;
+        size -= 3;
+    }
+
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    size_t maxChunks = std::max<size_t>(1, size / kMinChunkBytes);
+    size_t chunkCount = std::min<size_t>(threadCount, maxChunks);
+
+    //bucatile incep mereu dupa un '\n'
+    std::vector<Chunk> chunks(chunkCount);
+    const char* end = data + size;
+    const char* cursor = data;
+    for (size_t i = 0; i < chunkCount; i++) {
+        chunks[i].begin = cursor;
+        const char* target = (i + 1 == chunkCount) ? end : data + size * (i + 1) / chunkCount;
+        if (target < cursor) target = cursor;
+        if (target < end) {
+            const char* nl = static_cast<const char*>(std::memchr(target, '\n', (size_t)(end - target)));
+            target = nl ? nl + 1 : end;
+        }
+        chunks[i].end = target;
+        cursor = target;
+    }
+
+    runParallel(chunks, parseChunk);
+
+    //numerele de linie in mesaje sunt aproximative pentru bucatile de dupa prima
+    for (auto& chunk : chunks) {
+        out.warnings += chunk.warnings;
+        chunk.warnings.clear();
+        if (!chunk.error.empty()) {
+            err += chunk.error;
+            return false;
+        }
+    }
+
+    size_t vCount = 0, vnCount = 0, vtCount = 0;
+    for (auto& chunk : chunks) {
+        chunk.vBase = vCount / 3;
+        chunk.vnBase = vnCount / 3;
+        chunk.vtBase = vtCount / 2;
+        vCount += chunk.v.size();
+        vnCount += chunk.vn.size();
+        vtCount += chunk.vt.size();
+    }
+    out.positions.reserve(vCount);
+    out.normals.reserve(vnCount);
+    out.texcoords.reserve(vtCount);
+    for (auto& chunk : chunks) {
+        out.positions.insert(out.positions.end(), chunk.v.begin(), chunk.v.end());
+        out.normals.insert(out.normals.end(), chunk.vn.begin(), chunk.vn.end());
+        out.texcoords.insert(out.texcoords.end(), chunk.vt.begin(), chunk.vt.end());
+        std::vector<float>().swap(chunk.v);
+        std::vector<float>().swap(chunk.vn);
+        std::vector<float>().swap(chunk.vt);
+    }
+
+    resolveMaterials(chunks, mtlBaseDir, out);
+
+    const std::vector<float>& positions = out.positions;
+    runParallel(chunks, [&positions](Chunk& chunk) { triangulateChunk(chunk, positions); });
+
+    size_t triCount = 0;
+    for (auto& chunk : chunks) {
+        out.warnings += chunk.warnings;
+        if (!chunk.error.empty()) {
+            err += chunk.error;
+            return false;
+        }
+        triCount += chunk.triMaterials.size();
+    }
+    out.indices.reserve(triCount * 3);
+    out.triangleMaterials.reserve(triCount);
+    for (auto& chunk : chunks) {
+        out.indices.insert(out.indices.end(), chunk.triIndices.begin(), chunk.triIndices.end());
+        out.triangleMaterials.insert(out.triangleMaterials.end(), chunk.triMaterials.begin(), chunk.triMaterials.end());
+    }
+    return true;
+}
+
+bool parseObjFile(const std::string& path, const std::string& mtlBaseDir,
+                  ObjParseResult& out, std::string& err, unsigned threadCount) {
+    MappedFile file;
+    if (!file.open(path)) {
+        err = "Cannot open file [" + path + "]\n";
+        return false;
+    }
+    return parseObjBuffer(reinterpret_cast<const char*>(file.data()), file.size(),
+                          mtlBaseDir, out, err, threadCount);
+}
+
+namespace {
+
+glm::vec3 calcNormal(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c) {
+    return glm::normalize(glm::cross(b - a, c - a));
+}
+
+//varfurile unui triunghi; indicii in afara listelor dau valori implicite,
+//iar daca lipseste vreo normala tot triunghiul primeste normala fetei
+void buildTriangle(FloatSpan positions, FloatSpan normals, FloatSpan texcoords, const ObjIndex* idx,
+                   ObjVertex v[3]) {
+    size_t vCount = positions.size() / 3;
+    size_t vnCount = normals.size() / 3;
+    size_t vtCount = texcoords.size() / 2;
+    bool hasNormals = true;
+    for (int k = 0; k < 3; k++) {
+        if ((size_t)idx[k].v < vCount) {
+            v[k].pos = glm::vec3(positions[3 * idx[k].v + 0],
+                                 positions[3 * idx[k].v + 1],
+                                 positions[3 * idx[k].v + 2]);
+        } else {
+            v[k].pos = glm::vec3(0.0f);
+        }
+        if (idx[k].vn >= 0 && (size_t)idx[k].vn < vnCount) {
+            v[k].normal = glm::vec3(normals[3 * idx[k].vn + 0],
+                                    normals[3 * idx[k].vn + 1],
+                                    normals[3 * idx[k].vn + 2]);
+        } else {
+            hasNormals = false;
+            v[k].normal = glm::vec3(0, 1, 0);
+        }
+        if (idx[k].vt >= 0 && (size_t)idx[k].vt < vtCount) {
+            v[k].uv = glm::vec2(texcoords[2 * idx[k].vt + 0], texcoords[2 * idx[k].vt + 1]);
+        } else {
+            v[k].uv = glm::vec2(0.0f, 0.0f);
+        }
+    }
+    if (!hasNormals) {
+        glm::vec3 n = calcNormal(v[0].pos, v[1].pos, v[2].pos);
+        v[0].normal = v[1].normal = v[2].normal = n;
+    }
+}
+
+} // namespace
+
+void buildMeshData(const ObjParseResult& obj, MeshData& mesh) {
+    mesh = MeshData();
+
+    //numaram triunghiurile pe material ca sa scriem direct la pozitia finala
+    //materialul -1 (fara material) ocupa slotul 0
+    size_t slotCount = obj.materials.size() + 1;
+    std::vector<uint32_t> trianglesPerSlot(slotCount, 0);
+    for (int m : obj.triangleMaterials) {
+        size_t slot = (m >= 0 && m < (int)obj.materials.size()) ? (size_t)m + 1 : 0;
+        trianglesPerSlot[slot]++;
+    }
+
+    std::vector<uint32_t> writeOffset(slotCount, 0);
+    uint32_t total = 0;
+    for (size_t slot = 0; slot < slotCount; slot++) {
+        if (trianglesPerSlot[slot] == 0) continue;
+        MeshGroupData group;
+        group.baseVertex = total;
+        group.vertexCount = trianglesPerSlot[slot] * 3;
+        if (slot > 0) {
+            group.diffuseTexture = obj.materials[slot - 1].diffuse_texname;
+        }
+        writeOffset[slot] = total;
+        total += group.vertexCount;
+        mesh.groups.push_back(group);
+    }
+    mesh.vertices.resize(total);
+
+    FloatSpan positions = { obj.positions.data(), obj.positions.size() };
+    FloatSpan normals = { obj.normals.data(), obj.normals.size() };
+    FloatSpan texcoords = { obj.texcoords.data(), obj.texcoords.size() };
+    for (size_t t = 0; t < obj.triangleMaterials.size(); t++) {
+        ObjVertex v[3];
+        buildTriangle(positions, normals, texcoords, &obj.indices[t * 3], v);
+        int m = obj.triangleMaterials[t];
+        uint32_t& offset = writeOffset[(m >= 0 && m < (int)obj.materials.size()) ? (size_t)m + 1 : 0];
+        mesh.vertices[offset++] = v[0];
+        mesh.vertices[offset++] = v[1];
+        mesh.vertices[offset++] = v[2];
+    }
+}
+
+namespace {
+
+//apeleaza fn(inceput, sfarsit, numar) pentru fiecare linie care nu e goala sau comentariu
+template <typename Fn>
+bool forEachLine(const char* p, const char* end, Fn fn) {
+    size_t lineNum = 0;
+    while (p < end) {
+        const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', (size_t)(end - p)));
+        if (!lineEnd) lineEnd = end;
+        const char* next = lineEnd < end ? lineEnd + 1 : end;
+        if (lineEnd > p && lineEnd[-1] == '\r') lineEnd--;
+        lineNum++;
+
+        const char* t = skipSpaces(p, lineEnd);
+        p = next;
+        if (t >= lineEnd || *t == '#') continue;
+        if (!fn(t, lineEnd, lineNum)) return false;
+    }
+    return true;
+}
+
+inline bool isDirective(const char* t, const char* lineEnd, const char* name, size_t nameLength) {
+    return (size_t)(lineEnd - t) > nameLength && std::strncmp(t, name, nameLength) == 0 && isSpace(t[nameLength]);
+}
+
+inline size_t materialSlot(int material) {
+    return material >= 0 ? (size_t)material + 1 : 0;
+}
+
+} // namespace
+
+bool ObjStreamReader::open(const std::string& path, const std::string& mtlBaseDir, std::string& err) {
+    if (!file.open(path)) {
+        err = "Cannot open file [" + path + "]\n";
+        return false;
+    }
+    dataBegin = reinterpret_cast<const char*>(file.data());
+    dataEnd = dataBegin + file.size();
+    if (file.size() >= 3 && (unsigned char)dataBegin[0] == 0xEF && (unsigned char)dataBegin[1] == 0xBB &&
+        (unsigned char)dataBegin[2] == 0xBF) {
+        dataBegin += 3;
+    }
+
+    tinyobj::MaterialFileReader reader(mtlDirectory(mtlBaseDir));
+    MaterialLibrary library;
+    int material = -1;
+    std::vector<uint32_t> trianglesPerSlot(1, 0);
+
+    forEachLine(dataBegin, dataEnd, [&](const char* t, const char* lineEnd, size_t) {
+        if (isDirective(t, lineEnd, "v", 1)) {
+            positionFloats += 3;
+        } else if (isDirective(t, lineEnd, "vn", 2)) {
+            normalFloats += 3;
+        } else if (isDirective(t, lineEnd, "vt", 2)) {
+            texcoordFloats += 2;
+        } else if (isDirective(t, lineEnd, "f", 1)) {
+            //fiecare fata da cel mult n - 2 triunghiuri
+            t = skipSpaces(t + 2, lineEnd);
+            uint32_t corners = 0;
+            while (t < lineEnd && *t != '#') {
+                corners++;
+                while (t < lineEnd && !isTokenEnd(*t)) t++;
+                while (t < lineEnd && isTokenEnd(*t)) t++;
+            }
+            if (corners >= 3) {
+                size_t slot = materialSlot(material);
+                if (slot >= trianglesPerSlot.size()) trianglesPerSlot.resize(slot + 1, 0);
+                trianglesPerSlot[slot] += corners - 2;
+            }
+        } else if (isDirective(t, lineEnd, "usemtl", 6)) {
+            t = skipSpaces(t + 6, lineEnd);
+            const char* nameEnd = t;
+            while (nameEnd < lineEnd && !isTokenEnd(*nameEnd)) nameEnd++;
+            material = findMaterial(library, std::string(t, nameEnd), warningText);
+            useMtlMaterials.push_back(material);
+        } else if (isDirective(t, lineEnd, "mtllib", 6)) {
+            loadMtlLib(std::string(t + 7, lineEnd), reader, library, warningText);
+        }
+        return true;
+    });
+
+    size_t slotCount = library.materials.size() + 1;
+    trianglesPerSlot.resize(std::max(slotCount, trianglesPerSlot.size()), 0);
+    slotGroup.assign(trianglesPerSlot.size(), -1);
+    for (size_t slot = 0; slot < trianglesPerSlot.size(); slot++) {
+        if (trianglesPerSlot[slot] == 0) continue;
+        MeshGroupData group;
+        group.baseVertex = totalVertices;
+        group.vertexCount = trianglesPerSlot[slot] * 3;
+        if (slot > 0 && slot - 1 < library.materials.size()) {
+            group.diffuseTexture = library.materials[slot - 1].diffuse_texname;
+        }
+        slotGroup[slot] = (int)groupList.size();
+        totalVertices += group.vertexCount;
+        groupList.push_back(group);
+    }
+    return true;
+}
+
+bool ObjStreamReader::read(ObjVertex* dst, Arena& arena, std::string& err) {
+    float* positions = arena.allocateArray<float>(positionFloats);
+    float* normals = arena.allocateArray<float>(normalFloats);
+    float* texcoords = arena.allocateArray<float>(texcoordFloats);
+    size_t pv = 0, pvn = 0, pvt = 0;
+
+    std::vector<uint32_t> cursor(groupList.size());
+    std::vector<double> uvArea(groupList.size(), 0.0), worldArea(groupList.size(), 0.0);
+    for (size_t g = 0; g < groupList.size(); g++) cursor[g] = groupList[g].baseVertex;
+    minPos = glm::vec3(std::numeric_limits<float>::max());
+    maxPos = glm::vec3(-std::numeric_limits<float>::max());
+
+    size_t nextUseMtl = 0;
+    int material = -1;
+    std::vector<ObjIndex> face;
+
+    bool ok = forEachLine(dataBegin, dataEnd, [&](const char* t, const char* lineEnd, size_t lineNum) {
+        if (isDirective(t, lineEnd, "v", 1)) {
+            t += 2;
+            if (pv + 3 > positionFloats) return true;
+            float* p = positions + pv;
+            p[0] = parseFloat(t, lineEnd);
+            p[1] = parseFloat(t, lineEnd);
+            p[2] = parseFloat(t, lineEnd);
+            pv += 3;
+            glm::vec3 pos(p[0], p[1], p[2]);
+            minPos = glm::min(minPos, pos);
+            maxPos = glm::max(maxPos, pos);
+        } else if (isDirective(t, lineEnd, "vn", 2)) {
+            t += 3;
+            if (pvn + 3 > normalFloats) return true;
+            for (int k = 0; k < 3; k++) normals[pvn++] = parseFloat(t, lineEnd);
+        } else if (isDirective(t, lineEnd, "vt", 2)) {
+            t += 3;
+            if (pvt + 2 > texcoordFloats) return true;
+            for (int k = 0; k < 2; k++) texcoords[pvt++] = parseFloat(t, lineEnd);
+        } else if (isDirective(t, lineEnd, "f", 1)) {
+            //indicii relativi sunt deja finali, stim cate varfuri au aparut pana aici
+            t = skipSpaces(t + 2, lineEnd);
+            face.clear();
+            bool zeroFound = false;
+            while (t < lineEnd && *t != '#') {
+                RawCorner c;
+                if (!parseFaceCorner(t, lineEnd, (int)(pv / 3), (int)(pvn / 3), (int)(pvt / 2), c, zeroFound) ||
+                    c.v < 0 || ((c.relative & RelVt) && c.vt < 0) || ((c.relative & RelVn) && c.vn < 0)) {
+                    err = "Failed to parse `f' line (e.g. a zero value for vertex index "
+                          "or invalid relative vertex index). Line " + std::to_string(lineNum) + ").\n";
+                    return false;
+                }
+                face.push_back({ c.v, c.vt, c.vn });
+                while (t < lineEnd && isTokenEnd(*t)) t++;
+            }
+            if (zeroFound) {
+                warningText += "A zero value index found (will have a value of -1 for normal and "
+                               "tex indices. Line " + std::to_string(lineNum) + ").\n";
+            }
+
+            size_t slot = materialSlot(material);
+            int g = slot < slotGroup.size() ? slotGroup[slot] : -1;
+            if (g < 0) return true;
+            uint32_t groupEnd = groupList[g].baseVertex + groupList[g].vertexCount;
+            FloatSpan posSpan = { positions, pv };
+            FloatSpan normalSpan = { normals, pvn };
+            FloatSpan texcoordSpan = { texcoords, pvt };
+            triangulateFace(face, posSpan, warningText, [&](const ObjIndex& a, const ObjIndex& b, const ObjIndex& c) {
+                if (cursor[g] + 3 > groupEnd) return;
+                ObjIndex idx[3] = { a, b, c };
+                ObjVertex v[3];
+                buildTriangle(posSpan, normalSpan, texcoordSpan, idx, v);
+                worldArea[g] += 0.5 * glm::length(glm::cross(v[1].pos - v[0].pos, v[2].pos - v[0].pos));
+                glm::vec2 e1 = v[1].uv - v[0].uv, e2 = v[2].uv - v[0].uv;
+                uvArea[g] += 0.5 * std::fabs(e1.x * e2.y - e1.y * e2.x);
+                std::memcpy(dst + cursor[g], v, sizeof(v));
+                cursor[g] += 3;
+            });
+        } else if (isDirective(t, lineEnd, "usemtl", 6)) {
+            material = nextUseMtl < useMtlMaterials.size() ? useMtlMaterials[nextUseMtl++] : -1;
+        }
+        return true;
+    });
+    if (!ok) return false;
+
+    ObjVertex zero;
+    zero.pos = glm::vec3(0.0f);
+    zero.normal = glm::vec3(0.0f, 1.0f, 0.0f);
+    zero.uv = glm::vec2(0.0f);
+    groupUvDensity.assign(groupList.size(), 0.0f);
+    for (size_t g = 0; g < groupList.size(); g++) {
+        uint32_t groupEnd = groupList[g].baseVertex + groupList[g].vertexCount;
+        for (uint32_t i = cursor[g]; i < groupEnd; i++) dst[i] = zero;
+        if (worldArea[g] > 0.0) groupUvDensity[g] = (float)std::sqrt(uvArea[g] / worldArea[g]);
+    }
+    if (pv == 0) {
+        minPos = maxPos = glm::vec3(0.0f);
+    }
+    return true;
+}
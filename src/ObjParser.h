@@ -0,0 +1,85 @@
+#pragma once
+
+#include "Arena.h"
+#include "MappedFile.h"
+#include "MeshData.h"
+
+#include <tiny_obj_loader.h>
+
+#include <string>
+#include <vector>
+
+//parser OBJ propriu: fisierul e impartit in bucati aliniate la linii care sunt
+//parsate in paralel, apoi fluxurile v/vn/vt/f sunt unite in ordinea din fisier
+//rezultatul e identic cu tinyobj::LoadObj(..., triangulate=true)
+//MTL-urile sunt citite tot cu tinyobj (sunt fisiere mici)
+struct ObjIndex {
+    int v;
+    int vt;
+    int vn;
+};
+
+struct ObjParseResult {
+    std::vector<float> positions;   //xyz
+    std::vector<float> normals;     //xyz
+    std::vector<float> texcoords;   //uv
+    std::vector<ObjIndex> indices;  //3 pe triunghi, deja triangulat
+    std::vector<int> triangleMaterials;
+    std::vector<tinyobj::material_t> materials;
+    std::string warnings;
+};
+
+//threadCount = 0 alege automat in functie de marimea fisierului
+bool parseObjFile(const std::string& path, const std::string& mtlBaseDir,
+                  ObjParseResult& out, std::string& err, unsigned threadCount = 0);
+bool parseObjBuffer(const char* data, size_t size, const std::string& mtlBaseDir,
+                    ObjParseResult& out, std::string& err, unsigned threadCount = 0);
+
+//fisierele numite in liniile mtllib, ca baseDir + nume, in ordinea din fisier si fara duplicate
+//(inclusiv alternativele care nu exista); tabela de materiale a unui OBJ depinde si de ele
+std::vector<std::string> objMtlLibraries(const char* data, size_t size, const std::string& mtlBaseDir);
+
+//transforma triunghiurile in varfuri grupate pe material, ca in ObjModel
+//rezultatul e neindexat (3 varfuri pe triunghi), vezi weldVertices
+void buildMeshData(const ObjParseResult& obj, MeshData& mesh);
+
+//incarcare in flux pentru modele mari, fara ObjParseResult si fara MeshData
+//open numara varfurile si triunghiurile pe material (citeste si MTL-urile), read parseaza
+//v/vn/vt intr-o arena si scrie fiecare triunghi direct la pozitia lui finala
+//grupurile si triangularea sunt ca in buildMeshData; fata poate folosi doar varfuri definite
+//inaintea ei (cazul obisnuit), altfel triunghiurile ei ies degenerate
+class ObjStreamReader {
+public:
+    bool open(const std::string& path, const std::string& mtlBaseDir, std::string& err);
+
+    //baseVertex/vertexCount/diffuseTexture pe material, fara indici
+    const std::vector<MeshGroupData>& groups() const { return groupList; }
+    uint32_t vertexCount() const { return totalVertices; }
+
+    //dst are vertexCount() varfuri si e doar scris, deci poate fi un buffer GL mapat
+    //locurile ramase libere (fete care nu s-au putut triangula) se umplu cu varfuri 0
+    bool read(ObjVertex* dst, Arena& arena, std::string& err);
+
+    //valabile dupa read
+    glm::vec3 boundsMin() const { return minPos; }
+    glm::vec3 boundsMax() const { return maxPos; }
+    //sqrt(arie UV / arie), ca la PreparedMesh::uvDensity
+    float uvDensity(size_t group) const { return groupUvDensity[group]; }
+    const std::string& warnings() const { return warningText; }
+
+private:
+    MappedFile file;
+    const char* dataBegin = nullptr;
+    const char* dataEnd = nullptr;
+    size_t positionFloats = 0;
+    size_t normalFloats = 0;
+    size_t texcoordFloats = 0;
+    std::vector<int> useMtlMaterials;   //materialul fiecarui usemtl, in ordinea din fisier
+    std::vector<int> slotGroup;         //slot (material + 1) -> grup
+    std::vector<MeshGroupData> groupList;
+    uint32_t totalVertices = 0;
+    glm::vec3 minPos = glm::vec3(0.0f);
+    glm::vec3 maxPos = glm::vec3(0.0f);
+    std::vector<float> groupUvDensity;
+    std::string warningText;
+};
@@ -0,0 +1,156 @@
+#include "Profiler.h"
+
+#include <iostream>
+
+#ifdef PROFILER_ENABLED
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+struct ProfileEvent {
+    const char* name;
+    int64_t start;
+    int64_t end;
+};
+
+//un singur thread scrie; exportul citeste doar pana la written
+struct ThreadBuffer {
+    uint32_t id = 0;
+    std::string name;
+    std::unique_ptr<ProfileEvent[]> events{ new ProfileEvent[kProfileEventsPerThread] };
+    std::atomic<uint64_t> written{ 0 };
+};
+
+static_assert((kProfileEventsPerThread & (kProfileEventsPerThread - 1)) == 0, "power of two");
+
+//buffer-ele raman dupa ce thread-ul se termina, ca worker-ii opriti sa apara in export
+struct ThreadRegistry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> threads;
+};
+
+ThreadRegistry& registry() {
+    static ThreadRegistry instance;
+    return instance;
+}
+
+const std::chrono::steady_clock::time_point& epoch() {
+    static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    return start;
+}
+
+//buffer-ul se aloca la prima zona, deci thread-urile care nu inregistreaza nimic nu costa memorie
+struct ThreadState {
+    ThreadBuffer* buffer = nullptr;
+    std::string name;
+};
+
+thread_local ThreadState threadState;
+
+ThreadBuffer& threadBuffer() {
+    if (!threadState.buffer) {
+        ThreadRegistry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.threads.push_back(std::make_unique<ThreadBuffer>());
+        ThreadBuffer* buffer = r.threads.back().get();
+        buffer->id = (uint32_t)r.threads.size();
+        buffer->name = threadState.name.empty() ? "thread " + std::to_string(buffer->id) : threadState.name;
+        threadState.buffer = buffer;
+    }
+    return *threadState.buffer;
+}
+
+void writeJsonString(std::ostream& out, const std::string& s) {
+    out << '"';
+    for (char c : s) {
+        if (c == '"' || c == '\\') out << '\\';
+        if ((unsigned char)c >= 0x20) out << c;
+    }
+    out << '"';
+}
+
+} // namespace
+
+namespace profiler_detail {
+
+std::atomic<bool> enabled{ false };
+
+int64_t now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch()).count();
+}
+
+void record(const char* name, int64_t start, int64_t end) {
+    ThreadBuffer& buffer = threadBuffer();
+    uint64_t index = buffer.written.load(std::memory_order_relaxed);
+    buffer.events[index & (kProfileEventsPerThread - 1)] = { name, start, end };
+    buffer.written.store(index + 1, std::memory_order_release);
+}
+
+} // namespace profiler_detail
+
+void profilerSetEnabled(bool enabled) {
+    epoch();
+    profiler_detail::enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void profilerSetThreadName(const std::string& name) {
+    threadState.name = name;
+    if (threadState.buffer) {
+        std::lock_guard<std::mutex> lock(registry().mutex);
+        threadState.buffer->name = name;
+    }
+}
+
+bool writeChromeTrace(const std::string& path) {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "Cannot write trace: " << path << "\n";
+        return false;
+    }
+    out << std::fixed << std::setprecision(3);
+    //evenimente complete ("X"), timpii in microsecunde
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    ThreadRegistry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    bool first = true;
+    size_t events = 0;
+    uint64_t lost = 0;
+    for (const auto& thread : r.threads) {
+        out << (first ? "" : ",\n") << "{\"ph\":\"M\",\"pid\":1,\"tid\":" << thread->id
+            << ",\"name\":\"thread_name\",\"args\":{\"name\":";
+        writeJsonString(out, thread->name);
+        out << "}}";
+        first = false;
+
+        uint64_t written = thread->written.load(std::memory_order_acquire);
+        uint64_t begin = written > kProfileEventsPerThread ? written - kProfileEventsPerThread : 0;
+        lost += begin;
+        for (uint64_t i = begin; i < written; i++) {
+            const ProfileEvent& e = thread->events[i & (kProfileEventsPerThread - 1)];
+            out << ",\n{\"ph\":\"X\",\"pid\":1,\"tid\":" << thread->id << ",\"name\":";
+            writeJsonString(out, e.name);
+            out << ",\"ts\":" << (double)e.start / 1000.0 << ",\"dur\":" << (double)(e.end - e.start) / 1000.0 << "}";
+            events++;
+        }
+    }
+    out << "\n]}\n";
+    std::cout << "Trace: " << events << " zones from " << r.threads.size() << " threads to " << path;
+    if (lost > 0) std::cout << " (" << lost << " older zones overwritten)";
+    std::cout << "\n";
+    return (bool)out;
+}
+
+#else
+
+bool writeChromeTrace(const std::string& path) {
+    std::cerr << "Cannot write trace " << path << ": profiler compiled out (LAB2_PROFILER=OFF)\n";
+    return false;
+}
+
+#endif
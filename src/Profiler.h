@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+//zone CPU cu scope: fiecare thread scrie intr-un buffer circular propriu (fara lock-uri pe calea zonei),
+//iar la final totul se exporta in formatul Chrome trace (chrome://tracing sau ui.perfetto.dev)
+//fara PROFILER_ENABLED (optiunea CMake LAB2_PROFILER) zonele nu genereaza cod deloc
+//numele zonelor trebuie sa traiasca pana la export; in practica sunt literali
+
+//evenimentele pastrate pe thread; cele mai vechi se suprascriu
+constexpr uint32_t kProfileEventsPerThread = 1u << 16;
+
+#ifdef PROFILER_ENABLED
+
+namespace profiler_detail {
+extern std::atomic<bool> enabled;
+int64_t now();
+void record(const char* name, int64_t start, int64_t end);
+} // namespace profiler_detail
+
+//inregistrarea e oprita implicit; zonele costa atunci doar citirea unui atomic
+void profilerSetEnabled(bool enabled);
+//numele thread-ului curent in trace ("main", "asset worker 2")
+void profilerSetThreadName(const std::string& name);
+//exporta ce e in buffere; thread-urile care mai scriu pot pierde cateva evenimente din export
+bool writeChromeTrace(const std::string& path);
+
+class ProfileZone {
+public:
+    explicit ProfileZone(const char* name) {
+        if (profiler_detail::enabled.load(std::memory_order_relaxed)) {
+            this->name = name;
+            start = profiler_detail::now();
+        }
+    }
+    ~ProfileZone() { end(); }
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+    //inchide zona inainte de sfarsitul scope-ului (pentru sectiuni consecutive din acelasi bloc)
+    void end() {
+        if (!name) return;
+        profiler_detail::record(name, start, profiler_detail::now());
+        name = nullptr;
+    }
+
+private:
+    const char* name = nullptr;
+    int64_t start = 0;
+};
+
+#else
+
+inline void profilerSetEnabled(bool) {}
+inline void profilerSetThreadName(const std::string&) {}
+bool writeChromeTrace(const std::string& path);
+
+class ProfileZone {
+public:
+    explicit ProfileZone(const char*) {}
+    void end() {}
+};
+
+#endif
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#ifdef PROFILER_ENABLED
+#define PROFILE_ZONE(name) ProfileZone PROFILE_CONCAT(profileZone, __LINE__)(name)
+#else
+#define PROFILE_ZONE(name) ((void)0)
+#endif
@@ -0,0 +1,167 @@
+#include "RenderQueue.h"
+
+#include <algorithm>
+#include <iostream>
+
+#include "GeometryArena.h"
+#include "GpuProfiler.h"
+#include "MaterialArrays.h"
+#include "ObjModel.h"
+#include "RenderStats.h"
+#include "ShaderProgram.h"
+
+namespace {
+
+constexpr int kPassShift = 62;
+constexpr int kProgramShift = 54;
+constexpr int kTextureShift = 38;
+constexpr int kVaoShift = 25;
+constexpr int kIndexTypeShift = 24;
+constexpr uint64_t kDepthMask = (1ull << 24) - 1;
+//distanta la care adancimea se satureaza; peste planul far al camerei (200)
+constexpr float kMaxDepth = 256.0f;
+
+uint64_t field(uint64_t value, int bits, int shift) {
+    return (value & ((1ull << bits) - 1)) << shift;
+}
+
+uint64_t depthBits(float distance) {
+    float t = std::clamp(distance / kMaxDepth, 0.0f, 1.0f);
+    return (uint64_t)(t * (float)kDepthMask);
+}
+
+uint32_t indexSize(GLenum indexType) {
+    return indexType == GL_UNSIGNED_SHORT ? 2 : 4;
+}
+
+} // namespace
+
+void RenderQueue::setPass(RenderPass pass, ShaderProgram& program, const glm::vec3& eye) {
+    passes[pass].program = &program;
+    passes[pass].eye = eye;
+}
+
+void RenderQueue::submit(const RenderRecord& record) {
+    const MeshAsset* mesh = record.model->meshAsset();
+    if (!mesh) return;
+    glm::vec3 center = glm::vec3(*record.transform * glm::vec4(mesh->boundsCenter, 1.0f));
+    for (uint32_t pass = 0; pass < kRenderPassCount; pass++) {
+        if (!(record.passMask & (1u << pass))) continue;
+        const PassState& state = passes[pass];
+        //doar pase opace: cele apropiate primele, ca depth test-ul sa respinga restul devreme
+        uint64_t depth = depthBits(glm::length(center - state.eye));
+        uint64_t passKey = field(pass, 2, kPassShift) | field(state.program ? state.program->id() : 0, 8, kProgramShift) |
+                           field(mesh->VAO, 13, kVaoShift) | depth;
+        for (const MaterialGroup& group : record.model->lodLevel(record.lod[pass]).groups) {
+            //texturile dintr-un array de materiale au acelasi id, deci aceeasi cheie; difera doar stratul
+            const TextureAsset* texture = record.model->groupTexture(group);
+            GLuint textureId = texture ? texture->id : 0;
+            uint64_t key = passKey | field(textureId, 16, kTextureShift) |
+                           field(group.indexType == GL_UNSIGNED_INT ? 1 : 0, 1, kIndexTypeShift);
+            Item item{ key, mesh, &group, textureId, GL_TEXTURE_2D, kNoMaterialLayer, record.instance, record.label };
+            if (texture && texture->target == GL_TEXTURE_2D_ARRAY) {
+                item.textureTarget = GL_TEXTURE_2D_ARRAY;
+                item.materialLayer = (uint32_t)texture->layer;
+            }
+            items.push_back(item);
+        }
+    }
+}
+
+uint32_t RenderQueue::prepare(UniformRing& uniformRing) {
+    std::sort(items.begin(), items.end(), [](const Item& a, const Item& b) { return a.key < b.key; });
+    //indexul desenarii trebuie sa incapa in buffer-ul 0, 1, 2, ... al arenelor
+    if (items.size() > kMaxDrawsPerFrame) {
+        if (!overflowReported) {
+            std::cerr << "Render queue has " << items.size() << " draws, only " << kMaxDrawsPerFrame
+                      << " are drawn\n";
+            overflowReported = true;
+        }
+        items.resize(kMaxDrawsPerFrame);
+    }
+    records.resize(items.size());
+    for (size_t i = 0; i < items.size(); i++) {
+        records[i] = DrawRecord{ items[i].instance, items[i].materialLayer, { 0, 0 } };
+    }
+    uint32_t recordOffset = uniformRing.push(records.data(), records.size() * sizeof(DrawRecord));
+
+    indirect = multiDrawIndirectSupported();
+    if (indirect) {
+        commands.resize(items.size());
+        for (size_t i = 0; i < items.size(); i++) {
+            const MaterialGroup& group = *items[i].group;
+            commands[i] = DrawElementsIndirectCommand{ (uint32_t)group.indexCount, 1,
+                                                       (uint32_t)(group.indexOffset / indexSize(group.indexType)),
+                                                       group.baseVertex, (uint32_t)i };
+        }
+        commandOffset = uniformRing.push(commands.data(), commands.size() * sizeof(DrawElementsIndirectCommand));
+    }
+    return recordOffset;
+}
+
+void RenderQueue::execute(RenderPass pass, const UniformRing& uniformRing, GpuProfiler* drawProfiler) const {
+    uint64_t first = field(pass, 2, kPassShift);
+    auto begin = std::lower_bound(items.begin(), items.end(), first,
+                                  [](const Item& item, uint64_t key) { return item.key < key; });
+    auto end = begin;
+    while (end != items.end() && (end->key >> kPassShift) == pass) ++end;
+    if (begin == end) return;
+    if (passes[pass].program) passes[pass].program->use();
+
+    //zonele per desenare au nevoie de desenari separate
+    bool batched = indirect && !drawProfiler;
+    if (batched) glBindBuffer(GL_DRAW_INDIRECT_BUFFER, uniformRing.id());
+    GLuint boundVao = 0;
+    GLuint boundTexture = 0;
+    GLuint boundArray = 0;
+    for (auto it = begin; it != end;) {
+        const Item& item = *it;
+        const MaterialGroup& group = *item.group;
+        if (item.mesh->VAO != boundVao) {
+            glBindVertexArray(item.mesh->VAO);
+            boundVao = item.mesh->VAO;
+        }
+        //ca la ObjModel::draw, o textura care nu e gata lasa legata textura de dinainte
+        //array-ul sta pe unitatea lui, ca desenarile cu texturi 2D sa nu-l dezlege
+        if (item.texture && item.textureTarget == GL_TEXTURE_2D && item.texture != boundTexture) {
+            glActiveTexture(GL_TEXTURE0);
+            glBindTexture(GL_TEXTURE_2D, item.texture);
+            boundTexture = item.texture;
+        } else if (item.texture && item.textureTarget == GL_TEXTURE_2D_ARRAY && item.texture != boundArray) {
+            glActiveTexture(GL_TEXTURE0 + kMaterialArrayUnit);
+            glBindTexture(GL_TEXTURE_2D_ARRAY, item.texture);
+            boundArray = item.texture;
+        }
+        //straturile diferite ale aceluiasi array raman in acelasi lot
+        auto runEnd = it + 1;
+        if (batched && item.mesh->arena) {
+            while (runEnd != end && runEnd->mesh->arena == item.mesh->arena && runEnd->texture == item.texture &&
+                   runEnd->group->indexType == group.indexType) ++runEnd;
+        }
+        uint32_t drawIndex = (uint32_t)(it - items.begin());
+        if (batched && item.mesh->arena) {
+            size_t offset = commandOffset + drawIndex * sizeof(DrawElementsIndirectCommand);
+            glMultiDrawElementsIndirect(GL_TRIANGLES, group.indexType, (void*)offset, (GLsizei)(runEnd - it), 0);
+            renderStats().drawCalls++;
+            for (auto run = it; run != runEnd; ++run) renderStats().triangles += run->group->indexCount / 3;
+        } else {
+            GpuZone drawZone(drawProfiler, item.label);
+            //VAO-urile arenelor citesc indexul din baseInstance, celelalte folosesc constanta
+            glVertexAttribI1ui(kDrawIndexAttribute, drawIndex);
+            if (indirect) {
+                glDrawElementsInstancedBaseVertexBaseInstance(GL_TRIANGLES, group.indexCount, group.indexType,
+                                                              (void*)group.indexOffset, 1, group.baseVertex,
+                                                              drawIndex);
+            } else {
+                glDrawElementsBaseVertex(GL_TRIANGLES, group.indexCount, group.indexType,
+                                         (void*)group.indexOffset, group.baseVertex);
+            }
+            renderStats().drawCalls++;
+            renderStats().triangles += group.indexCount / 3;
+        }
+        it = runEnd;
+    }
+    if (batched) glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    glBindVertexArray(0);
+    glActiveTexture(GL_TEXTURE0);
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include "AssetTypes.h"
+#include "UniformRing.h"
+
+class GpuProfiler;
+class ObjModel;
+class ShaderProgram;
+
+enum RenderPass : uint32_t {
+    kShadowPass = 0,
+    kMainPass = 1,
+    kRenderPassCount
+};
+
+enum RenderPassMask : uint8_t {
+    kShadowPassBit = 1 << kShadowPass,
+    kMainPassBit = 1 << kMainPass
+};
+
+//ce trimite scena pentru o instanta; datele ei (model, normalMatrix, cuantizare) sunt deja in UniformRing
+struct RenderRecord {
+    const ObjModel* model;
+    const glm::mat4* transform;     //pentru adancime; trebuie sa traiasca pana la sort()
+    uint32_t instance;              //indexul in InstanceData-ul cadrului
+    uint8_t passMask;
+    int lod[kRenderPassCount];
+    const char* label;              //zona GPU per desenare (--gpu-profile-draws), poate fi nullptr
+};
+
+//o singura trimitere a scenei produce desenarile tuturor paselor
+//fiecare grup de material devine un element cu o cheie de 64 de biti:
+//  pasa (2) | program (8) | textura (16) | VAO (13) | tip index (1) | adancime fata-spate (24)
+//sortarea dupa cheie pune laolalta desenarile cu aceeasi stare; execute() schimba doar ce difera
+//program/textura/VAO intra in cheie prin numele GL trunchiate: o coliziune strica doar gruparea,
+//starea legata se compara oricum dupa valorile reale
+//elementele consecutive din aceeasi arena, cu aceeasi textura si acelasi tip de index, pleaca intr-un singur
+//glMultiDrawElementsIndirect; fara suport (GL 3.3) sau cu zone GPU per desenare se deseneaza grup cu grup
+//materialele impachetate de MaterialArrays au aceeasi textura (array-ul), stratul merge in DrawRecord
+class RenderQueue {
+public:
+    //programul si punctul de vedere al pasei (camera, respectiv lumina) pentru cadrul curent
+    void setPass(RenderPass pass, ShaderProgram& program, const glm::vec3& eye);
+
+    void clear() { items.clear(); }
+    void submit(const RenderRecord& record);
+    //sorteaza si scrie in ring inregistrarile desenarilor (si comenzile indirecte);
+    //intoarce offset-ul inregistrarilor, pentru FrameConstants::drawParams
+    uint32_t prepare(UniformRing& uniformRing);
+    void execute(RenderPass pass, const UniformRing& uniformRing, GpuProfiler* drawProfiler) const;
+
+    size_t size() const { return items.size(); }
+
+private:
+    struct Item {
+        uint64_t key;
+        const MeshAsset* mesh;
+        const MaterialGroup* group;
+        GLuint texture;
+        GLenum textureTarget;       //GL_TEXTURE_2D sau GL_TEXTURE_2D_ARRAY (MaterialArrays)
+        uint32_t materialLayer;     //ajunge in DrawRecord; kNoMaterialLayer pentru texturile 2D
+        uint32_t instance;
+        const char* label;
+    };
+
+    struct PassState {
+        ShaderProgram* program = nullptr;
+        glm::vec3 eye = glm::vec3(0.0f);
+    };
+
+    PassState passes[kRenderPassCount];
+    std::vector<Item> items;
+    bool overflowReported = false;
+    //refolosite de la un cadru la altul
+    std::vector<DrawRecord> records;
+    std::vector<DrawElementsIndirectCommand> commands;
+    uint32_t commandOffset = 0;
+    bool indirect = false;
+};
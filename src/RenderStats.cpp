@@ -0,0 +1,6 @@
+#include "RenderStats.h"
+
+RenderStats& renderStats() {
+    static RenderStats stats;
+    return stats;
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstdint>
+
+//contoare pentru cadrul curent; main le reseteaza la inceputul fiecarui cadru
+//se folosesc doar de pe thread-ul GL
+struct RenderStats {
+    uint32_t drawCalls = 0;
+    uint64_t triangles = 0;
+};
+
+RenderStats& renderStats();
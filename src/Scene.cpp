@@ -0,0 +1,251 @@
+#include "Scene.h"
+#include "AssetPack.h"
+#include "Hash.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+const char kSceneCacheMagic[4] = { 'S', 'C', 'N', 'B' };
+
+//inregistrarile se citesc direct din mapare, deci dimensiunile fac parte din format
+static_assert(sizeof(SceneMesh) == 16, "SceneMesh layout");
+static_assert(sizeof(SceneInstance) == 96, "SceneInstance layout");
+static_assert(sizeof(SceneLight) == 48, "SceneLight layout");
+static_assert(sizeof(SceneFloor) == 16, "SceneFloor layout");
+static_assert(sizeof(SceneSlope) == 80, "SceneSlope layout");
+static_assert(sizeof(SceneWall) == 64, "SceneWall layout");
+static_assert(sizeof(SceneInteractable) == 96, "SceneInteractable layout");
+static_assert(sizeof(glm::vec2) == 8, "scene point layout");
+
+struct SceneSectionRange {
+    uint32_t offset;
+    uint32_t count;     //numar de inregistrari (bytes pentru siruri)
+};
+
+struct SceneCacheHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t sourceSize;
+    int64_t sourceMtime;
+    uint64_t sourceHash;
+    SceneSectionRange sections[SceneSectionCount];
+};
+
+constexpr size_t kSectionAlignment = 16;
+
+const size_t kRecordSize[SceneSectionCount] = {
+    sizeof(SceneMesh),
+    sizeof(SceneInstance),
+    sizeof(SceneLight),
+    sizeof(SceneFloor),
+    sizeof(SceneSlope),
+    sizeof(SceneWall),
+    sizeof(SceneInteractable),
+    sizeof(glm::vec2),
+    1
+};
+
+size_t alignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+bool statSource(const std::string& scenePath, uint64_t& size, int64_t& mtime) {
+    std::error_code ec;
+    auto fileSize = std::filesystem::file_size(scenePath, ec);
+    if (ec) return false;
+    auto writeTime = std::filesystem::last_write_time(scenePath, ec);
+    if (ec) return false;
+    size = (uint64_t)fileSize;
+    mtime = (int64_t)writeTime.time_since_epoch().count();
+    return true;
+}
+
+bool hashSource(const std::string& scenePath, uint64_t& hash) {
+    MappedFile src;
+    if (!src.open(scenePath)) return false;
+    hash = hashBytes(src.data(), src.size());
+    return true;
+}
+
+//un sir optional e kSceneNoString sau un offset in tabela de siruri
+bool validString(uint32_t offset, uint32_t stringBytes, bool optional) {
+    return offset < stringBytes || (optional && offset == kSceneNoString);
+}
+
+bool validPoints(uint32_t firstPoint, uint32_t count, uint32_t pointCount) {
+    return (uint64_t)firstPoint + count <= pointCount;
+}
+
+//main foloseste indicii direct; un fisier trunchiat, editat sau ramas de la alt compilator
+//nu trebuie sa ajunga la citiri in afara tablourilor, ci la recompilare
+bool validRecords(const SceneView& view) {
+    if (view.stringBytes > 0 && view.strings[view.stringBytes - 1] != '\0') return false;
+    for (uint32_t i = 0; i < view.meshCount; i++) {
+        const SceneMesh& mesh = view.meshes[i];
+        if (!validString(mesh.path, view.stringBytes, false) ||
+            !validString(mesh.texture, view.stringBytes, true)) return false;
+    }
+    for (uint32_t i = 0; i < view.instanceCount; i++) {
+        const SceneInstance& instance = view.instances[i];
+        if (instance.mesh >= view.meshCount || !validString(instance.name, view.stringBytes, true)) return false;
+    }
+    for (uint32_t i = 0; i < view.lightCount; i++) {
+        const SceneLight& light = view.lights[i];
+        if (light.type != SceneLightType::Directional && light.type != SceneLightType::Point) return false;
+        if (!validString(light.name, view.stringBytes, true)) return false;
+    }
+    for (uint32_t i = 0; i < view.floorCount; i++) {
+        if (!validPoints(view.floors[i].firstPoint, view.floors[i].pointCount, view.pointCount)) return false;
+    }
+    for (uint32_t i = 0; i < view.slopeCount; i++) {
+        if (!validPoints(view.slopes[i].firstPoint, view.slopes[i].pointCount, view.pointCount)) return false;
+    }
+    for (uint32_t i = 0; i < view.interactableCount; i++) {
+        const SceneInteractable& interactable = view.interactables[i];
+        switch (interactable.kind) {
+        case SceneInteractableKind::Door:
+        case SceneInteractableKind::Movable:
+            if (interactable.target >= view.instanceCount) return false;
+            break;
+        case SceneInteractableKind::LightSwitch:
+            if (interactable.target >= view.lightCount) return false;
+            break;
+        default:
+            return false;
+        }
+    }
+    return true;
+}
+
+//antetul, limitele sectiunilor si indicii din inregistrari; false trimite la recompilare
+bool parseSceneCache(const uint8_t* data, size_t size, SceneCacheHeader& header, SceneView& view) {
+    if (size < sizeof(SceneCacheHeader)) return false;
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, kSceneCacheMagic, 4) != 0) return false;
+    if (header.version != kSceneCacheVersion) return false;
+    if (reinterpret_cast<uintptr_t>(data) % kSectionAlignment != 0) return false;
+
+    for (uint32_t s = 0; s < SceneSectionCount; s++) {
+        const SceneSectionRange& range = header.sections[s];
+        if (range.offset % kSectionAlignment != 0 || range.offset < sizeof(SceneCacheHeader)) return false;
+        if ((uint64_t)range.offset + (uint64_t)range.count * kRecordSize[s] > size) return false;
+    }
+    auto section = [&](SceneSection s) { return data + header.sections[s].offset; };
+    view.meshes = reinterpret_cast<const SceneMesh*>(section(SceneSectionMeshes));
+    view.meshCount = header.sections[SceneSectionMeshes].count;
+    view.instances = reinterpret_cast<const SceneInstance*>(section(SceneSectionInstances));
+    view.instanceCount = header.sections[SceneSectionInstances].count;
+    view.lights = reinterpret_cast<const SceneLight*>(section(SceneSectionLights));
+    view.lightCount = header.sections[SceneSectionLights].count;
+    view.floors = reinterpret_cast<const SceneFloor*>(section(SceneSectionFloors));
+    view.floorCount = header.sections[SceneSectionFloors].count;
+    view.slopes = reinterpret_cast<const SceneSlope*>(section(SceneSectionSlopes));
+    view.slopeCount = header.sections[SceneSectionSlopes].count;
+    view.walls = reinterpret_cast<const SceneWall*>(section(SceneSectionWalls));
+    view.wallCount = header.sections[SceneSectionWalls].count;
+    view.interactables = reinterpret_cast<const SceneInteractable*>(section(SceneSectionInteractables));
+    view.interactableCount = header.sections[SceneSectionInteractables].count;
+    view.points = reinterpret_cast<const glm::vec2*>(section(SceneSectionPoints));
+    view.pointCount = header.sections[SceneSectionPoints].count;
+    view.strings = reinterpret_cast<const char*>(section(SceneSectionStrings));
+    view.stringBytes = header.sections[SceneSectionStrings].count;
+    return validRecords(view);
+}
+
+} // namespace
+
+std::string sceneCachePath(const std::string& scenePath) {
+    return scenePath + "bin";
+}
+
+bool openSceneCache(const std::string& scenePath, SceneView& view) {
+    SceneCacheHeader header;
+    //ca la fisierul separat, intrarea din pack conteaza doar daca .scene nu s-a schimbat de la gatire (sau lipseste);
+    //altfel main recompileaza scena
+    if (assetPack().isOpen()) {
+        PackBlob blob;
+        if (assetPack().readFresh(packEntryName(sceneCachePath(scenePath)), { scenePath }, blob)) {
+            //o intrare stricata lasa loc fisierului separat, pe care main il poate recompila
+            if (parseSceneCache(blob.data, blob.size, header, view)) {
+                view.storage = std::move(blob.storage);
+                return true;
+            }
+        }
+    }
+
+    uint64_t srcSize;
+    int64_t srcMtime;
+    if (!statSource(scenePath, srcSize, srcMtime)) return false;
+
+    MappedFile file;
+    if (!file.open(sceneCachePath(scenePath))) return false;
+    if (!parseSceneCache(file.data(), file.size(), header, view)) return false;
+    if (header.sourceSize != srcSize) return false;
+    if (header.sourceMtime != srcMtime) {
+        uint64_t srcHash;
+        if (!hashSource(scenePath, srcHash) || srcHash != header.sourceHash) return false;
+    }
+    view.file = std::move(file);
+    return true;
+}
+
+bool writeSceneCache(const std::string& scenePath, const SceneData& scene) {
+    SceneCacheHeader header = {};
+    std::memcpy(header.magic, kSceneCacheMagic, 4);
+    header.version = kSceneCacheVersion;
+    if (!statSource(scenePath, header.sourceSize, header.sourceMtime) ||
+        !hashSource(scenePath, header.sourceHash)) return false;
+
+    const void* sectionData[SceneSectionCount] = {
+        scene.meshes.data(), scene.instances.data(), scene.lights.data(), scene.floors.data(),
+        scene.slopes.data(), scene.walls.data(), scene.interactables.data(), scene.points.data(),
+        scene.strings.data()
+    };
+    const size_t sectionCount[SceneSectionCount] = {
+        scene.meshes.size(), scene.instances.size(), scene.lights.size(), scene.floors.size(),
+        scene.slopes.size(), scene.walls.size(), scene.interactables.size(), scene.points.size(),
+        scene.strings.size()
+    };
+    size_t offset = alignUp(sizeof(SceneCacheHeader), kSectionAlignment);
+    for (uint32_t s = 0; s < SceneSectionCount; s++) {
+        header.sections[s].offset = (uint32_t)offset;
+        header.sections[s].count = (uint32_t)sectionCount[s];
+        offset = alignUp(offset + sectionCount[s] * kRecordSize[s], kSectionAlignment);
+    }
+
+    //scriem intr-un fisier temporar si il redenumim, ca sa nu ramana un cache pe jumatate
+    std::string finalPath = sceneCachePath(scenePath);
+    std::string tmpPath = finalPath + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            std::cerr << "Cannot write scene cache: " << tmpPath << "\n";
+            return false;
+        }
+        static const char padding[kSectionAlignment] = {};
+        size_t written = sizeof(header);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        for (uint32_t s = 0; s < SceneSectionCount; s++) {
+            out.write(padding, header.sections[s].offset - written);
+            size_t bytes = sectionCount[s] * kRecordSize[s];
+            out.write(static_cast<const char*>(sectionData[s]), (std::streamsize)bytes);
+            written = header.sections[s].offset + bytes;
+        }
+        out.write(padding, offset - written);
+        if (!out) {
+            std::cerr << "Cannot write scene cache: " << tmpPath << "\n";
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmpPath, finalPath, ec);
+    if (ec) {
+        std::filesystem::remove(tmpPath, ec);
+        return false;
+    }
+    return true;
+}
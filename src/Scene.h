@@ -0,0 +1,171 @@
+#pragma once
+
+#include "MappedFile.h"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//scena compilata (<scena>.scenebin, scris de cookScene langa fisierul text)
+//fiecare tip de inregistrare e un tablou contiguu aliniat la 16 bytes, folosit direct din
+//fisierul mapat: incarcarea verifica doar antetul, fara nicio parsare
+//inregistrarile se refera una la alta prin indici, iar sirurile prin offset-uri in tabela de siruri
+constexpr uint32_t kSceneCacheVersion = 1;
+constexpr uint32_t kSceneNoString = 0xFFFFFFFFu;
+
+enum SceneMeshFlags : uint32_t {
+    SceneMeshPacked = 1,    //VertexFormat::Packed
+    SceneMeshStream = 2     //ObjModel::loadStreaming: fara cache si LOD-uri, memorie de varf mica
+};
+
+struct SceneMesh {
+    uint32_t path;          //offset in siruri
+    uint32_t texture;       //textura pentru tot modelul sau kSceneNoString (atunci vin din MTL)
+    uint32_t flags;
+    uint32_t reserved;
+};
+
+enum SceneInstanceFlags : uint32_t {
+    SceneInstanceCastsShadow = 1,
+    SceneInstanceLod = 2,       //alege LOD-ul dupa distanta
+    SceneInstanceDynamic = 4    //se poate roti/muta in jurul pivotului (usi, obiecte mutabile)
+};
+
+struct SceneInstance {
+    glm::mat4 world;        //deja compus din translate/rotate/scale
+    glm::vec3 pivot;        //translatia din world, centrul rotatiilor de la rulare
+    uint32_t mesh;
+    uint32_t flags;
+    uint32_t name;
+    uint32_t reserved[2];
+};
+
+enum class SceneLightType : uint32_t {
+    Directional,
+    Point
+};
+
+enum SceneLightFlags : uint32_t {
+    SceneLightStartsOff = 1
+};
+
+struct SceneLight {
+    glm::vec3 vector;       //directia (Directional) sau pozitia (Point)
+    SceneLightType type;
+    glm::vec3 color;
+    uint32_t flags;
+    uint32_t name;
+    uint32_t reserved[3];
+};
+
+//podea plana: un poligon XZ la inaltimea y
+struct SceneFloor {
+    float y;
+    uint32_t firstPoint;    //in tabela de puncte XZ
+    uint32_t pointCount;
+    uint32_t reserved;
+};
+
+//panta: poligonul XZ in care se aplica si 4 puncte care dau planul
+struct ScenePlane {
+    glm::vec3 points[4];
+};
+
+struct SceneSlope {
+    ScenePlane plane;
+    glm::vec3 debugColor;
+    uint32_t firstPoint;
+    uint32_t pointCount;
+    uint32_t reserved[3];
+};
+
+enum SceneWallFlags : uint32_t {
+    SceneWallCollides = 1   //altfel e doar desenat in modul debug (ex. tocurile usilor)
+};
+
+struct SceneWall {
+    glm::vec3 corners[4];
+    glm::vec3 debugColor;
+    uint32_t flags;
+};
+
+enum class SceneInteractableKind : uint32_t {
+    Door,           //E: se roteste in jurul pivotului instantei
+    LightSwitch,    //L: aprinde/stinge lumina
+    Movable         //M: modul de mutare (sageti + rotita)
+};
+
+struct SceneInteractable {
+    SceneInteractableKind kind;
+    uint32_t target;        //instanta (Door, Movable) sau lumina (LightSwitch)
+    float proximity;        //cat de aproape trebuie sa fie camera
+    float maxAngle;         //usi: unghiul maxim de deschidere, in grade
+    glm::vec3 position;     //punctul fata de care se masoara distanta
+    uint32_t reserved0;
+    glm::vec3 normal;       //usi: partea din care se deschide
+    uint32_t reserved1;
+    glm::vec3 corners[4];   //usi: dreptunghiul de coliziune cand e inchisa
+};
+
+//intervalul din fisier al fiecarei sectiuni
+enum SceneSection : uint32_t {
+    SceneSectionMeshes,
+    SceneSectionInstances,
+    SceneSectionLights,
+    SceneSectionFloors,
+    SceneSectionSlopes,
+    SceneSectionWalls,
+    SceneSectionInteractables,
+    SceneSectionPoints,
+    SceneSectionStrings,
+    SceneSectionCount
+};
+
+//vedere peste scena mapata (fisierul separat, intrarea din pack-ul montat, sau storage)
+struct SceneView {
+    MappedFile file;
+    std::vector<uint8_t> storage;
+
+    const SceneMesh* meshes = nullptr;
+    uint32_t meshCount = 0;
+    const SceneInstance* instances = nullptr;
+    uint32_t instanceCount = 0;
+    const SceneLight* lights = nullptr;
+    uint32_t lightCount = 0;
+    const SceneFloor* floors = nullptr;
+    uint32_t floorCount = 0;
+    const SceneSlope* slopes = nullptr;
+    uint32_t slopeCount = 0;
+    const SceneWall* walls = nullptr;
+    uint32_t wallCount = 0;
+    const SceneInteractable* interactables = nullptr;
+    uint32_t interactableCount = 0;
+    const glm::vec2* points = nullptr;
+    uint32_t pointCount = 0;
+    const char* strings = nullptr;
+    uint32_t stringBytes = 0;
+
+    const char* string(uint32_t offset) const { return offset < stringBytes ? strings + offset : ""; }
+};
+
+//tablourile de inregistrari, asa cum le scrie compilatorul
+struct SceneData {
+    std::vector<SceneMesh> meshes;
+    std::vector<SceneInstance> instances;
+    std::vector<SceneLight> lights;
+    std::vector<SceneFloor> floors;
+    std::vector<SceneSlope> slopes;
+    std::vector<SceneWall> walls;
+    std::vector<SceneInteractable> interactables;
+    std::vector<glm::vec2> points;
+    std::string strings;    //siruri terminate cu '\0'
+};
+
+std::string sceneCachePath(const std::string& scenePath);
+
+//cauta intai in assetPack(), apoi langa sursa
+//intoarce false daca lipseste, e corupt sau nu corespunde sursei
+bool openSceneCache(const std::string& scenePath, SceneView& view);
+bool writeSceneCache(const std::string& scenePath, const SceneData& scene);
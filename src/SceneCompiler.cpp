@@ -0,0 +1,355 @@
+#include "SceneCompiler.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <vector>
+
+namespace {
+
+constexpr float kDefaultDoorAngle = 70.0f;
+constexpr float kDefaultDoorProximity = 2.0f;
+constexpr float kDefaultSwitchProximity = 3.0f;
+
+//cuvintele unei linii, citite in ordine
+class Tokens {
+public:
+    explicit Tokens(const std::string& line) {
+        std::istringstream in(line);
+        std::string token;
+        while (in >> token) {
+            if (token[0] == '#') break;
+            words.push_back(token);
+        }
+    }
+
+    bool empty() const { return words.empty(); }
+    bool done() const { return next >= words.size(); }
+    const std::string& word() { return words[next++]; }
+    bool accept(const char* keyword) {
+        if (done() || words[next] != keyword) return false;
+        next++;
+        return true;
+    }
+    bool peekNumber() const {
+        if (done()) return false;
+        float value;
+        const std::string& w = words[next];
+        const char* begin = w.c_str() + (w[0] == '+' ? 1 : 0);
+        auto result = std::from_chars(begin, w.c_str() + w.size(), value);
+        return result.ec == std::errc() && result.ptr == w.c_str() + w.size();
+    }
+    bool number(float& value) {
+        if (!peekNumber()) return false;
+        const std::string& w = words[next++];
+        std::from_chars(w.c_str() + (w[0] == '+' ? 1 : 0), w.c_str() + w.size(), value);
+        return true;
+    }
+    bool vec2(glm::vec2& v) { return number(v.x) && number(v.y); }
+    bool vec3(glm::vec3& v) { return number(v.x) && number(v.y) && number(v.z); }
+
+private:
+    std::vector<std::string> words;
+    size_t next = 0;
+};
+
+class SceneBuilder {
+public:
+    explicit SceneBuilder(SceneData& scene) : scene(scene) {}
+
+    //intoarce mesajul de eroare, gol daca linia e corecta
+    std::string parseLine(Tokens& t) {
+        const std::string& kind = t.word();
+        if (kind == "mesh") return parseMesh(t);
+        if (kind == "instance") return parseInstance(t);
+        if (kind == "light") return parseLight(t);
+        if (kind == "floor") return parseFloor(t);
+        if (kind == "slope") return parseSlope(t);
+        if (kind == "wall") return parseWall(t);
+        if (kind == "door") return parseDoor(t);
+        if (kind == "switch") return parseSwitch(t);
+        if (kind == "movable") return parseMovable(t);
+        return "unknown record '" + kind + "'";
+    }
+
+private:
+    uint32_t addString(const std::string& s) {
+        uint32_t offset = (uint32_t)scene.strings.size();
+        scene.strings += s;
+        scene.strings += '\0';
+        return offset;
+    }
+
+    std::string parseMesh(Tokens& t) {
+        if (t.done()) return "mesh without a name";
+        std::string name = t.word();
+        if (meshIndex.count(name)) return "duplicate mesh '" + name + "'";
+        if (t.done()) return "mesh '" + name + "' without a path";
+        SceneMesh mesh = {};
+        mesh.path = addString(t.word());
+        mesh.texture = kSceneNoString;
+        while (!t.done()) {
+            if (t.accept("packed")) {
+                mesh.flags |= SceneMeshPacked;
+            } else if (t.accept("stream")) {
+                mesh.flags |= SceneMeshStream;
+            } else if (t.accept("texture")) {
+                if (t.done()) return "texture without a path";
+                mesh.texture = addString(t.word());
+            } else {
+                return "unexpected '" + t.word() + "'";
+            }
+        }
+        //incarcarea in flux scrie doar varfuri float
+        if ((mesh.flags & SceneMeshPacked) && (mesh.flags & SceneMeshStream)) {
+            return "mesh '" + name + "' cannot be both packed and stream";
+        }
+        meshIndex[name] = (uint32_t)scene.meshes.size();
+        scene.meshes.push_back(mesh);
+        return "";
+    }
+
+    std::string parseInstance(Tokens& t) {
+        if (t.done()) return "instance without a mesh";
+        std::string meshName = t.word();
+        auto mesh = meshIndex.find(meshName);
+        if (mesh == meshIndex.end()) return "unknown mesh '" + meshName + "'";
+
+        SceneInstance inst = {};
+        inst.world = glm::mat4(1.0f);
+        inst.mesh = mesh->second;
+        inst.flags = SceneInstanceCastsShadow;
+        inst.name = kSceneNoString;
+        while (!t.done()) {
+            if (t.accept("name")) {
+                if (t.done()) return "name without a value";
+                std::string name = t.word();
+                if (instanceIndex.count(name)) return "duplicate instance '" + name + "'";
+                instanceIndex[name] = (uint32_t)scene.instances.size();
+                inst.name = addString(name);
+            } else if (t.accept("translate")) {
+                glm::vec3 v;
+                if (!t.vec3(v)) return "translate needs x y z";
+                inst.world = glm::translate(inst.world, v);
+            } else if (t.accept("rotate")) {
+                float degrees;
+                glm::vec3 axis;
+                if (!t.number(degrees) || !t.vec3(axis)) return "rotate needs degrees and an axis";
+                inst.world = glm::rotate(inst.world, glm::radians(degrees), axis);
+            } else if (t.accept("scale")) {
+                glm::vec3 v;
+                if (!t.number(v.x)) return "scale needs 1 or 3 values";
+                v.y = v.z = v.x;
+                if (t.peekNumber() && !(t.number(v.y) && t.number(v.z))) return "scale needs 1 or 3 values";
+                inst.world = glm::scale(inst.world, v);
+            } else if (t.accept("lod")) {
+                inst.flags |= SceneInstanceLod;
+            } else if (t.accept("noshadow")) {
+                inst.flags &= ~SceneInstanceCastsShadow;
+            } else {
+                return "unexpected '" + t.word() + "'";
+            }
+        }
+        //incarcarea in flux nu face LOD-uri, deci selectLod ar ramane mereu la modelul complet
+        if ((inst.flags & SceneInstanceLod) && (scene.meshes[inst.mesh].flags & SceneMeshStream)) {
+            return "stream mesh '" + meshName + "' has no LODs, drop 'lod'";
+        }
+        inst.pivot = glm::vec3(inst.world[3]);
+        scene.instances.push_back(inst);
+        return "";
+    }
+
+    std::string parseLight(Tokens& t) {
+        SceneLight light = {};
+        light.name = kSceneNoString;
+        if (t.accept("directional")) light.type = SceneLightType::Directional;
+        else if (t.accept("point")) light.type = SceneLightType::Point;
+        else return "light must be directional or point";
+        if (!t.vec3(light.vector)) return "light needs x y z";
+        light.color = glm::vec3(1.0f);
+        while (!t.done()) {
+            if (t.accept("color")) {
+                if (!t.vec3(light.color)) return "color needs r g b";
+            } else if (t.accept("name")) {
+                if (t.done()) return "name without a value";
+                std::string name = t.word();
+                if (lightIndex.count(name)) return "duplicate light '" + name + "'";
+                lightIndex[name] = (uint32_t)scene.lights.size();
+                light.name = addString(name);
+            } else if (t.accept("off")) {
+                light.flags |= SceneLightStartsOff;
+            } else {
+                return "unexpected '" + t.word() + "'";
+            }
+        }
+        if (light.type == SceneLightType::Directional) light.vector = glm::normalize(light.vector);
+        scene.lights.push_back(light);
+        return "";
+    }
+
+    //perechi x z pana la sfarsitul liniei
+    std::string parsePolygon(Tokens& t, uint32_t& first, uint32_t& count) {
+        first = (uint32_t)scene.points.size();
+        glm::vec2 p;
+        while (t.vec2(p)) scene.points.push_back(p);
+        count = (uint32_t)scene.points.size() - first;
+        if (!t.done()) return "unexpected '" + t.word() + "'";
+        if (count < 3) return "polygon needs at least 3 points";
+        return "";
+    }
+
+    std::string parseFloor(Tokens& t) {
+        SceneFloor floor = {};
+        if (!t.number(floor.y)) return "floor needs a height";
+        std::string err = parsePolygon(t, floor.firstPoint, floor.pointCount);
+        if (!err.empty()) return err;
+        scene.floors.push_back(floor);
+        return "";
+    }
+
+    std::string parseSlope(Tokens& t) {
+        SceneSlope slope = {};
+        if (!t.accept("plane")) return "slope needs 'plane'";
+        for (glm::vec3& p : slope.plane.points) {
+            if (!t.vec3(p)) return "plane needs 4 points";
+        }
+        slope.debugColor = glm::vec3(1.0f, 1.0f, 0.0f);
+        if (t.accept("color") && !t.vec3(slope.debugColor)) return "color needs r g b";
+        if (!t.accept("poly")) return "slope needs 'poly'";
+        std::string err = parsePolygon(t, slope.firstPoint, slope.pointCount);
+        if (!err.empty()) return err;
+        scene.slopes.push_back(slope);
+        return "";
+    }
+
+    std::string parseWall(Tokens& t) {
+        SceneWall wall = {};
+        for (glm::vec3& c : wall.corners) {
+            if (!t.vec3(c)) return "wall needs 4 corners";
+        }
+        wall.debugColor = glm::vec3(0.0f, 1.0f, 1.0f);
+        wall.flags = SceneWallCollides;
+        while (!t.done()) {
+            if (t.accept("color")) {
+                if (!t.vec3(wall.debugColor)) return "color needs r g b";
+            } else if (t.accept("nocollide")) {
+                wall.flags &= ~SceneWallCollides;
+            } else {
+                return "unexpected '" + t.word() + "'";
+            }
+        }
+        scene.walls.push_back(wall);
+        return "";
+    }
+
+    std::string findInstance(Tokens& t, uint32_t& index) {
+        if (t.done()) return "missing instance name";
+        std::string name = t.word();
+        auto it = instanceIndex.find(name);
+        if (it == instanceIndex.end()) return "unknown instance '" + name + "'";
+        index = it->second;
+        scene.instances[index].flags |= SceneInstanceDynamic;
+        return "";
+    }
+
+    std::string parseDoor(Tokens& t) {
+        SceneInteractable door = {};
+        door.kind = SceneInteractableKind::Door;
+        door.maxAngle = kDefaultDoorAngle;
+        door.proximity = kDefaultDoorProximity;
+        std::string err = findInstance(t, door.target);
+        if (!err.empty()) return err;
+        door.position = scene.instances[door.target].pivot;
+        if (!t.accept("corners")) return "door needs 'corners'";
+        for (glm::vec3& c : door.corners) {
+            if (!t.vec3(c)) return "door needs 4 corners";
+        }
+        if (!t.accept("normal") || !t.vec3(door.normal)) return "door needs 'normal x y z'";
+        while (!t.done()) {
+            if (t.accept("angle")) {
+                if (!t.number(door.maxAngle)) return "angle needs a value";
+            } else if (t.accept("proximity")) {
+                if (!t.number(door.proximity)) return "proximity needs a value";
+            } else {
+                return "unexpected '" + t.word() + "'";
+            }
+        }
+        scene.interactables.push_back(door);
+        return "";
+    }
+
+    std::string parseSwitch(Tokens& t) {
+        SceneInteractable sw = {};
+        sw.kind = SceneInteractableKind::LightSwitch;
+        sw.proximity = kDefaultSwitchProximity;
+        if (t.done()) return "switch without a light";
+        std::string name = t.word();
+        auto it = lightIndex.find(name);
+        if (it == lightIndex.end()) return "unknown light '" + name + "'";
+        sw.target = it->second;
+        if (!t.vec3(sw.position)) return "switch needs x y z";
+        if (t.accept("proximity") && !t.number(sw.proximity)) return "proximity needs a value";
+        if (!t.done()) return "unexpected '" + t.word() + "'";
+        scene.interactables.push_back(sw);
+        return "";
+    }
+
+    std::string parseMovable(Tokens& t) {
+        SceneInteractable movable = {};
+        movable.kind = SceneInteractableKind::Movable;
+        std::string err = findInstance(t, movable.target);
+        if (!err.empty()) return err;
+        movable.position = scene.instances[movable.target].pivot;
+        if (!t.done()) return "unexpected '" + t.word() + "'";
+        scene.interactables.push_back(movable);
+        return "";
+    }
+
+    SceneData& scene;
+    std::map<std::string, uint32_t> meshIndex;
+    std::map<std::string, uint32_t> instanceIndex;
+    std::map<std::string, uint32_t> lightIndex;
+};
+
+} // namespace
+
+bool compileScene(const std::string& path, SceneData& scene, std::string& err) {
+    scene = SceneData();
+    std::ifstream in(path);
+    if (!in.is_open()) {
+        err = "Cannot open scene: " + path + "\n";
+        return false;
+    }
+    SceneBuilder builder(scene);
+    std::string line;
+    size_t lineNum = 0;
+    while (std::getline(in, line)) {
+        lineNum++;
+        Tokens tokens(line);
+        if (tokens.empty()) continue;
+        std::string lineErr = builder.parseLine(tokens);
+        if (!lineErr.empty()) {
+            err = path + ":" + std::to_string(lineNum) + ": " + lineErr + "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+bool cookScene(const std::string& path) {
+    SceneData scene;
+    std::string err;
+    if (!compileScene(path, scene, err)) {
+        std::cerr << err;
+        return false;
+    }
+    if (!writeSceneCache(path, scene)) return false;
+    std::cout << "Compiled scene: " << path << " meshes=" << scene.meshes.size()
+              << " instances=" << scene.instances.size() << " walls=" << scene.walls.size() << "\n";
+    return true;
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Scene.h"
+
+#include <string>
+
+//descrierea text a scenei, o inregistrare pe linie ('#' incepe un comentariu):
+//  mesh <nume> <cale.obj> [packed | stream] [texture <cale>]
+//                           (stream: fara cache, LOD-uri si varfuri packed; instantele lui nu pot avea lod)
+//  instance <mesh> [name <nume>] [translate x y z] [rotate grade ax ay az] [scale s | scale x y z]
+//           [lod] [noshadow]                 (transformarile se compun in ordinea din linie)
+//  light directional|point x y z color r g b [name <nume>] [off]
+//  floor <y> x z x z x z ...
+//  slope plane x y z x y z x y z x y z [color r g b] poly x z x z ...
+//  wall x y z x y z x y z x y z [color r g b] [nocollide]
+//  door <instanta> corners x y z (x4) normal x y z [angle grade] [proximity d]
+//  switch <lumina> x y z [proximity d]
+//  movable <instanta>
+//usile si obiectele mutabile devin instante dinamice, cu pivotul in translatia lor
+bool compileScene(const std::string& path, SceneData& scene, std::string& err);
+
+//compileaza si scrie <scena>.scenebin; false (cu mesaj pe cerr) daca sursa are erori
+bool cookScene(const std::string& path);
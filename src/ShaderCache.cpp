@@ -0,0 +1,167 @@
+#include "ShaderCache.h"
+#include "Hash.h"
+#include "MappedFile.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+constexpr uint32_t kShaderBinaryMagic = 0x42444853; //"SHDB"
+
+struct ShaderBinaryHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key;
+    uint32_t format;
+    uint32_t size;
+};
+
+std::string glString(GLenum name) {
+    const GLubyte* s = glGetString(name);
+    return s ? reinterpret_cast<const char*>(s) : "";
+}
+
+GLuint startCompile(GLenum type, const std::string& source) {
+    GLuint shader = glCreateShader(type);
+    const char* src = source.c_str();
+    glShaderSource(shader, 1, &src, nullptr);
+    glCompileShader(shader);
+    return shader;
+}
+
+//false si mesajul din log daca shaderul nu s-a compilat
+bool checkShader(GLuint shader, const std::string& name, const char* stage) {
+    GLint ok;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &ok);
+    if (ok) return true;
+    char log[1024];
+    glGetShaderInfoLog(shader, 1024, nullptr, log);
+    std::cerr << "Shader compile error (" << name << ", " << stage << "):\n" << log << "\n";
+    return false;
+}
+
+} // namespace
+
+ShaderCache::ShaderCache(std::string directory) : directory(std::move(directory)) {
+    driverId = glString(GL_VENDOR) + "|" + glString(GL_RENDERER) + "|" + glString(GL_VERSION);
+
+    GLint formats = 0;
+    if (GLEW_VERSION_4_1 || GLEW_ARB_get_program_binary) {
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    }
+    binarySupported = formats > 0;
+
+    //driverul alege cate thread-uri foloseste; compilarea nu mai blocheaza la glLinkProgram
+    if (GLEW_KHR_parallel_shader_compile) {
+        glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+    } else if (GLEW_ARB_parallel_shader_compile) {
+        glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+    }
+}
+
+std::string ShaderCache::binaryPath(const std::string& name) const {
+    return directory + "/" + name + ".glbin";
+}
+
+GLuint ShaderCache::request(const std::string& name, const std::string& vertexSource,
+                            const std::string& fragmentSource) {
+    uint64_t key = hashString(vertexSource);
+    key = hashString(fragmentSource, key);
+    key = hashString(driverId, key);
+
+    GLuint program = glCreateProgram();
+    if (binarySupported && loadBinary(name, key, program)) {
+        cacheHits++;
+        return program;
+    }
+    //un glProgramBinary respins lasa programul nelegat; il refolosim pentru sursa
+    GLuint vs = startCompile(GL_VERTEX_SHADER, vertexSource);
+    GLuint fs = startCompile(GL_FRAGMENT_SHADER, fragmentSource);
+    glAttachShader(program, vs);
+    glAttachShader(program, fs);
+    if (binarySupported) glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    glLinkProgram(program);
+    pending.push_back({ name, program, vs, fs, key });
+    return program;
+}
+
+bool ShaderCache::finish() {
+    bool allLinked = true;
+    size_t compiled = pending.size();
+    for (const PendingProgram& p : pending) {
+        //blocheaza doar daca driverul nu a terminat inca programul asta
+        GLint ok;
+        glGetProgramiv(p.program, GL_LINK_STATUS, &ok);
+        if (ok) {
+            if (binarySupported) storeBinary(p.name, p.key, p.program);
+        } else {
+            checkShader(p.vertexShader, p.name, "vertex");
+            checkShader(p.fragmentShader, p.name, "fragment");
+            char log[1024];
+            glGetProgramInfoLog(p.program, 1024, nullptr, log);
+            std::cerr << "Program link error (" << p.name << "):\n" << log << "\n";
+            allLinked = false;
+        }
+        glDetachShader(p.program, p.vertexShader);
+        glDetachShader(p.program, p.fragmentShader);
+        glDeleteShader(p.vertexShader);
+        glDeleteShader(p.fragmentShader);
+    }
+    pending.clear();
+    std::cout << "Shaders: " << cacheHits << " from cache, " << compiled << " compiled\n";
+    cacheHits = 0;
+    return allLinked;
+}
+
+bool ShaderCache::loadBinary(const std::string& name, uint64_t key, GLuint program) const {
+    MappedFile file;
+    if (!file.open(binaryPath(name)) || file.size() < sizeof(ShaderBinaryHeader)) return false;
+    ShaderBinaryHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (header.magic != kShaderBinaryMagic || header.version != kShaderCacheVersion || header.key != key ||
+        header.size != file.size() - sizeof(header)) return false;
+
+    glProgramBinary(program, header.format, file.data() + sizeof(header), (GLsizei)header.size);
+    GLint ok;
+    glGetProgramiv(program, GL_LINK_STATUS, &ok);
+    return ok == GL_TRUE;
+}
+
+void ShaderCache::storeBinary(const std::string& name, uint64_t key, GLuint program) const {
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) return;
+    std::vector<char> binary((size_t)length);
+    GLenum format = 0;
+    glGetProgramBinary(program, length, &length, &format, binary.data());
+
+    ShaderBinaryHeader header = {};
+    header.magic = kShaderBinaryMagic;
+    header.version = kShaderCacheVersion;
+    header.key = key;
+    header.format = format;
+    header.size = (uint32_t)length;
+
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    std::string finalPath = binaryPath(name);
+    std::string tmpPath = finalPath + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            std::cerr << "Cannot write shader cache: " << tmpPath << "\n";
+            return;
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(binary.data(), length);
+        if (!out) {
+            std::cerr << "Cannot write shader cache: " << tmpPath << "\n";
+            return;
+        }
+    }
+    std::filesystem::rename(tmpPath, finalPath, ec);
+    if (ec) std::filesystem::remove(tmpPath, ec);
+}
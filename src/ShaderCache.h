@@ -0,0 +1,46 @@
+#pragma once
+
+#include <GL/glew.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//programele legate se pastreaza ca glGetProgramBinary in <directory>/<nume>.glbin
+//cheia e hash-ul surselor plus GL_VENDOR/GL_RENDERER/GL_VERSION; la orice nepotrivire
+//(sursa schimbata, driver nou, binar respins de glProgramBinary) se compileaza din sursa
+//si fisierul se rescrie
+constexpr uint32_t kShaderCacheVersion = 1;
+
+class ShaderCache {
+public:
+    //se construieste pe thread-ul GL, dupa glewInit
+    explicit ShaderCache(std::string directory = "shadercache");
+
+    //id-ul e valid imediat, dar programele compilate acum pot fi folosite abia dupa finish
+    //cu KHR_parallel_shader_compile driverul le compileaza in paralel intre timp
+    GLuint request(const std::string& name, const std::string& vertexSource,
+                   const std::string& fragmentSource);
+    //asteapta programele cerute, afiseaza erorile si scrie binarele noi
+    //intoarce false daca vreun program nu s-a legat
+    bool finish();
+
+private:
+    struct PendingProgram {
+        std::string name;
+        GLuint program;
+        GLuint vertexShader;
+        GLuint fragmentShader;
+        uint64_t key;
+    };
+
+    bool loadBinary(const std::string& name, uint64_t key, GLuint program) const;
+    void storeBinary(const std::string& name, uint64_t key, GLuint program) const;
+    std::string binaryPath(const std::string& name) const;
+
+    std::string directory;
+    std::string driverId;
+    bool binarySupported = false;
+    std::vector<PendingProgram> pending;
+    int cacheHits = 0;
+};
@@ -0,0 +1,106 @@
+#include "ShaderProgram.h"
+
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+//programul legat acum; contextul e unul singur, pe thread-ul GL
+GLuint boundProgram = 0;
+
+bool kindAccepts(UniformKind kind, GLenum type) {
+    switch (kind) {
+        case UniformKind::Float: return type == GL_FLOAT;
+        case UniformKind::Int:
+            return type == GL_INT || type == GL_BOOL || type == GL_SAMPLER_2D || type == GL_SAMPLER_2D_ARRAY ||
+                   type == GL_SAMPLER_2D_SHADOW || type == GL_SAMPLER_CUBE || type == GL_SAMPLER_BUFFER ||
+                   type == GL_UNSIGNED_INT_SAMPLER_BUFFER;
+        case UniformKind::Vec3: return type == GL_FLOAT_VEC3;
+        case UniformKind::Mat4: return type == GL_FLOAT_MAT4;
+    }
+    return false;
+}
+
+} // namespace
+
+void ShaderProgram::reset(GLuint id) {
+    program = id;
+    slots.clear();
+    GLint count = 0;
+    GLint maxLength = 0;
+    glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+    std::vector<char> name((size_t)maxLength + 1);
+    for (GLint i = 0; i < count; i++) {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(program, (GLuint)i, (GLsizei)name.size(), &length, &size, &type, name.data());
+        Slot slot;
+        slot.name.assign(name.data(), (size_t)length);
+        //uniformele din blocuri nu au locatie
+        slot.location = glGetUniformLocation(program, slot.name.c_str());
+        if (slot.location < 0) continue;
+        //la tablouri numele vine ca "x[0]"; folosim doar primul element
+        size_t bracket = slot.name.find('[');
+        if (bracket != std::string::npos) slot.name.resize(bracket);
+        slot.type = type;
+        slots.push_back(slot);
+    }
+}
+
+void ShaderProgram::use() const {
+    if (boundProgram == program) return;
+    glUseProgram(program);
+    boundProgram = program;
+}
+
+int32_t ShaderProgram::find(const char* name, UniformKind kind) const {
+    for (size_t i = 0; i < slots.size(); i++) {
+        if (slots[i].name != name) continue;
+        if (!kindAccepts(kind, slots[i].type)) {
+            std::cerr << "Uniform " << name << " in program " << program << " has a different type\n";
+            return -1;
+        }
+        return (int32_t)i;
+    }
+    return -1;
+}
+
+bool ShaderProgram::changed(int32_t slot, const void* data, size_t size) {
+    if (slot < 0) return false;
+    Slot& s = slots[slot];
+    if (s.known && std::memcmp(s.value, data, size) == 0) {
+        skipCount++;
+        return false;
+    }
+    std::memcpy(s.value, data, size);
+    s.known = true;
+    uploadCount++;
+    return true;
+}
+
+void ShaderProgram::set(Uniform<float> u, float value) {
+    if (changed(u.slot, &value, sizeof(value))) glUniform1f(slots[u.slot].location, value);
+}
+
+void ShaderProgram::set(Uniform<int> u, int value) {
+    if (changed(u.slot, &value, sizeof(value))) glUniform1i(slots[u.slot].location, value);
+}
+
+void ShaderProgram::set(Uniform<glm::vec3> u, const glm::vec3& value) {
+    if (changed(u.slot, &value, sizeof(value))) glUniform3fv(slots[u.slot].location, 1, &value[0]);
+}
+
+void ShaderProgram::set(Uniform<glm::mat4> u, const glm::mat4& value) {
+    if (changed(u.slot, &value, sizeof(value))) {
+        glUniformMatrix4fv(slots[u.slot].location, 1, GL_FALSE, &value[0][0]);
+    }
+}
+
+bool ShaderProgram::bindBlock(const char* name, GLuint binding) {
+    GLuint index = glGetUniformBlockIndex(program, name);
+    if (index == GL_INVALID_INDEX) return false;
+    glUniformBlockBinding(program, index, binding);
+    return true;
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//handle tipizat spre o uniforma reflectata; -1 daca uniforma lipseste (sau compilatorul a eliminat-o)
+template <typename T>
+struct Uniform {
+    int32_t slot = -1;
+    bool valid() const { return slot >= 0; }
+};
+
+enum class UniformKind { Float, Int, Vec3, Mat4 };
+
+template <typename T> struct UniformTraits;
+template <> struct UniformTraits<float> { static constexpr UniformKind kind = UniformKind::Float; };
+//int acopera si bool si sampler-ele (unitatea de textura)
+template <> struct UniformTraits<int> { static constexpr UniformKind kind = UniformKind::Int; };
+template <> struct UniformTraits<glm::vec3> { static constexpr UniformKind kind = UniformKind::Vec3; };
+template <> struct UniformTraits<glm::mat4> { static constexpr UniformKind kind = UniformKind::Mat4; };
+
+//programul legat plus uniformele lui active, enumerate o data dupa link
+//valorile trimise se pastreaza si pe CPU, iar set() sare peste glUniform* daca valoarea nu s-a schimbat
+//set() presupune ca programul e cel legat (use()); toate glUseProgram-urile trec prin use() ca sa
+//se stie programul curent
+class ShaderProgram {
+public:
+    ShaderProgram() = default;
+    //programul trebuie sa fie deja legat (dupa ShaderCache::finish)
+    explicit ShaderProgram(GLuint program) { reset(program); }
+
+    void reset(GLuint program);
+    GLuint id() const { return program; }
+    bool reflected() const { return program != 0; }
+
+    void use() const;
+
+    template <typename T>
+    Uniform<T> uniform(const char* name) const {
+        return Uniform<T>{ find(name, UniformTraits<T>::kind) };
+    }
+
+    void set(Uniform<float> u, float value);
+    void set(Uniform<int> u, int value);
+    void set(Uniform<glm::vec3> u, const glm::vec3& value);
+    void set(Uniform<glm::mat4> u, const glm::mat4& value);
+
+    //leaga blocul std140 de un punct de legare; false daca programul nu foloseste blocul
+    bool bindBlock(const char* name, GLuint binding);
+
+    //uniformele urcate si cele sarite (valoare neschimbata) de la pornire
+    uint64_t uploads() const { return uploadCount; }
+    uint64_t skipped() const { return skipCount; }
+
+private:
+    struct Slot {
+        std::string name;
+        GLenum type;
+        GLint location;
+        bool known = false;         //dupa link valorile sunt 0, dar nu ne bazam pe asta
+        float value[16] = {};       //cel mai mare tip e mat4
+    };
+
+    int32_t find(const char* name, UniformKind kind) const;
+    bool changed(int32_t slot, const void* data, size_t size);
+
+    GLuint program = 0;
+    std::vector<Slot> slots;
+    uint64_t uploadCount = 0;
+    uint64_t skipCount = 0;
+};
@@ -0,0 +1,154 @@
+#include "Texture.h"
+
+#include <cstring>
+
+TextureLoadOptions queryTextureLoadOptions() {
+    TextureLoadOptions options;
+    //RGTC (BC4/BC5) e in nucleul 3.0, S3TC e extensie (prezenta pe orice GPU desktop)
+    options.compress = GLEW_EXT_texture_compression_s3tc != 0;
+    options.allowBc7 = options.compress && (GLEW_VERSION_4_2 || GLEW_ARB_texture_compression_bptc);
+    options.immutableStorage = GLEW_VERSION_4_2 || GLEW_ARB_texture_storage;
+    return options;
+}
+
+namespace {
+
+GLenum compressedInternalFormat(BlockFormat format) {
+    switch (format) {
+    case BlockFormat::BC1: return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+    case BlockFormat::BC3: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+    case BlockFormat::BC5: return GL_COMPRESSED_RG_RGTC2;
+    case BlockFormat::BC7: return GL_COMPRESSED_RGBA_BPTC_UNORM;
+    }
+    return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+}
+
+//orfanizeaza PBO-ul (fara sa asteptam dupa upload-ul anterior) si il mapeaza;
+//intoarce nullptr (si dezleaga PBO-ul) daca maparea nu a reusit
+uint8_t* mapUnpackBuffer(GLuint pbo, size_t size) {
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo);
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, (GLsizeiptr)size, nullptr, GL_STREAM_DRAW);
+    void* dst = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, (GLsizeiptr)size,
+                                 GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    if (!dst) glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    return static_cast<uint8_t*>(dst);
+}
+
+GLuint createTexture(GLsizei levelCount) {
+    GLuint textureID;
+    glGenTextures(1, &textureID);
+    glBindTexture(GL_TEXTURE_2D, textureID);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levelCount - 1);
+    return textureID;
+}
+
+} // namespace
+
+GLuint uploadCompressedTexture(const CompressedTexture& texture, bool immutableStorage, GLuint pbo) {
+    return uploadCompressedLevels(texture, 0, immutableStorage, pbo);
+}
+
+GLuint uploadCompressedLevels(const CompressedTexture& texture, int firstLevel, bool immutableStorage, GLuint pbo) {
+    GLsizei levelCount = (GLsizei)texture.mips.size();
+    GLenum internalFormat = compressedInternalFormat(texture.format);
+    GLuint textureID = createTexture(levelCount);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, firstLevel);
+    if (immutableStorage) glTexStorage2D(GL_TEXTURE_2D, levelCount, internalFormat, texture.width, texture.height);
+
+    //cu PBO, pointerii devin offset-uri in buffer (fata de primul nivel urcat)
+    size_t start = texture.mips[firstLevel].offset;
+    size_t size = texture.dataSize - start;
+    bool usePbo = false;
+    if (pbo != 0) {
+        if (uint8_t* dst = mapUnpackBuffer(pbo, size)) {
+            std::memcpy(dst, texture.data + start, size);
+            glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+            usePbo = true;
+        }
+    }
+    for (GLsizei level = firstLevel; level < levelCount; level++) {
+        const CompressedMip& mip = texture.mips[level];
+        const void* data = usePbo ? (const void*)(mip.offset - start) : texture.data + mip.offset;
+        if (immutableStorage) {
+            glCompressedTexSubImage2D(GL_TEXTURE_2D, level, 0, 0, mip.width, mip.height, internalFormat,
+                                      (GLsizei)mip.size, data);
+        } else {
+            glCompressedTexImage2D(GL_TEXTURE_2D, level, internalFormat, mip.width, mip.height, 0,
+                                   (GLsizei)mip.size, data);
+        }
+    }
+    if (usePbo) glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    return textureID;
+}
+
+void uploadCompressedLevel(GLuint textureID, const CompressedTexture& texture, int level, const void* data) {
+    const CompressedMip& mip = texture.mips[level];
+    glBindTexture(GL_TEXTURE_2D, textureID);
+    glCompressedTexImage2D(GL_TEXTURE_2D, level, compressedInternalFormat(texture.format),
+                           mip.width, mip.height, 0, (GLsizei)mip.size, data);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, level);
+}
+
+void releaseCompressedLevel(GLuint textureID, const CompressedTexture& texture, int level) {
+    glBindTexture(GL_TEXTURE_2D, textureID);
+    //intai mutam BASE_LEVEL, ca textura sa ramana completa fara nivelul sters
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, level + 1);
+    glCompressedTexImage2D(GL_TEXTURE_2D, level, compressedInternalFormat(texture.format), 0, 0, 0, 0, nullptr);
+}
+
+GLuint uploadTexture(const std::vector<ImageLevel>& levels, bool immutableStorage, GLuint pbo) {
+    GLsizei levelCount = (GLsizei)levels.size();
+    GLuint textureID = createTexture(levelCount);
+    if (immutableStorage) glTexStorage2D(GL_TEXTURE_2D, levelCount, GL_RGBA8, levels[0].width, levels[0].height);
+
+    //toate nivelurile intr-un singur PBO, unul dupa altul
+    std::vector<size_t> offsets(levels.size());
+    size_t total = 0;
+    for (size_t i = 0; i < levels.size(); i++) {
+        offsets[i] = total;
+        total += levels[i].pixels.size();
+    }
+    bool usePbo = false;
+    if (pbo != 0) {
+        if (uint8_t* dst = mapUnpackBuffer(pbo, total)) {
+            for (size_t i = 0; i < levels.size(); i++) {
+                std::memcpy(dst + offsets[i], levels[i].pixels.data(), levels[i].pixels.size());
+            }
+            glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+            usePbo = true;
+        }
+    }
+    //randurile RGBA8 sunt mereu multiplu de 4 bytes, alinierea implicita e buna
+    for (GLsizei level = 0; level < levelCount; level++) {
+        const ImageLevel& image = levels[level];
+        const void* pixels = usePbo ? (const void*)offsets[level] : image.pixels.data();
+        if (immutableStorage) {
+            glTexSubImage2D(GL_TEXTURE_2D, level, 0, 0, image.width, image.height, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+        } else {
+            glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA8, image.width, image.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+        }
+    }
+    if (usePbo) glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    return textureID;
+}
+
+GLuint uploadPreparedTexture(const PreparedTexture& texture, bool immutableStorage, size_t& gpuBytes,
+                             GLuint pbo) {
+    if (texture.compressed) {
+        gpuBytes = texture.blocks.dataSize;
+        return uploadCompressedTexture(texture.blocks, immutableStorage, pbo);
+    }
+    gpuBytes = textureGpuBytes(texture.levels);
+    return uploadTexture(texture.levels, immutableStorage, pbo);
+}
+
+size_t textureGpuBytes(const std::vector<ImageLevel>& levels) {
+    size_t total = 0;
+    for (const auto& level : levels) total += level.pixels.size();
+    return total;
+}
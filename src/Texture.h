@@ -0,0 +1,31 @@
+#pragma once
+
+#include <GL/glew.h>
+
+#include "TextureCook.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+//ce stie GPU-ul, aflat o data pe thread-ul GL (limita de rezolutie ramane 0)
+TextureLoadOptions queryTextureLoadOptions();
+
+//urca toate nivelurile; doar pe thread-ul GL, fara glGenerateMipmap
+//immutableStorage: glTexStorage2D + glTex(Compressed)SubImage2D, altfel glTex(Compressed)Image2D pe nivel
+//pbo != 0: pixelii trec printr-un pixel unpack buffer, ca driverul sa poata copia asincron
+GLuint uploadTexture(const std::vector<ImageLevel>& levels, bool immutableStorage, GLuint pbo = 0);
+GLuint uploadCompressedTexture(const CompressedTexture& texture, bool immutableStorage, GLuint pbo = 0);
+//urca doar nivelurile firstLevel..ultimul si pune BASE_LEVEL = firstLevel (pentru streaming)
+GLuint uploadCompressedLevels(const CompressedTexture& texture, int firstLevel, bool immutableStorage,
+                              GLuint pbo = 0);
+//adauga/sterge cate un nivel dintr-o textura cu stocare mutabila, mutand BASE_LEVEL odata cu el
+//(un nivel redefinit ca 0x0 nu mai ocupa memorie, iar BASE_LEVEL il tine in afara texturii)
+void uploadCompressedLevel(GLuint textureID, const CompressedTexture& texture, int level, const void* data);
+void releaseCompressedLevel(GLuint textureID, const CompressedTexture& texture, int level);
+//alege intre cele doua si intoarce si memoria ocupata pe GPU
+GLuint uploadPreparedTexture(const PreparedTexture& texture, bool immutableStorage, size_t& gpuBytes,
+                             GLuint pbo = 0);
+
+//memoria ocupata pe GPU de un lant de mip-uri RGBA8
+size_t textureGpuBytes(const std::vector<ImageLevel>& levels);
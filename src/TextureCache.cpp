@@ -0,0 +1,291 @@
+#include "TextureCache.h"
+#include "AssetPack.h"
+#include "Hash.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+constexpr uint32_t makeFourCC(char a, char b, char c, char d) {
+    return (uint32_t)(uint8_t)a | ((uint32_t)(uint8_t)b << 8) | ((uint32_t)(uint8_t)c << 16) |
+           ((uint32_t)(uint8_t)d << 24);
+}
+
+constexpr uint32_t kDdsMagic = makeFourCC('D', 'D', 'S', ' ');
+constexpr uint32_t kFourCCDxt1 = makeFourCC('D', 'X', 'T', '1');
+constexpr uint32_t kFourCCDxt5 = makeFourCC('D', 'X', 'T', '5');
+constexpr uint32_t kFourCCDx10 = makeFourCC('D', 'X', '1', '0');
+//semnatura noastra in dwReserved1, ca sa nu confundam cu un DDS venit din alta parte
+constexpr uint32_t kCookedMagic = makeFourCC('C', 'O', 'O', 'K');
+
+constexpr uint32_t kDdsdCaps = 0x1, kDdsdHeight = 0x2, kDdsdWidth = 0x4, kDdsdPixelFormat = 0x1000;
+constexpr uint32_t kDdsdMipMapCount = 0x20000, kDdsdLinearSize = 0x80000;
+constexpr uint32_t kDdpfFourCC = 0x4;
+constexpr uint32_t kDdsCapsComplex = 0x8, kDdsCapsTexture = 0x1000, kDdsCapsMipMap = 0x400000;
+constexpr uint32_t kDxgiBc5Unorm = 83, kDxgiBc7Unorm = 98;
+constexpr uint32_t kDimensionTexture2D = 3;
+
+struct DdsPixelFormat {
+    uint32_t size;
+    uint32_t flags;
+    uint32_t fourCC;
+    uint32_t rgbBitCount;
+    uint32_t masks[4];
+};
+
+//reserved1: [0] semnatura, [1] versiunea, [2] usage, [3..4] marimea, [5..6] mtime, [7..8] hash-ul sursei,
+//[9] dimensiunea maxima folosita la gatire, [10] marimea imaginii sursa (latimea in bitii de sus)
+struct DdsHeader {
+    uint32_t size;
+    uint32_t flags;
+    uint32_t height;
+    uint32_t width;
+    uint32_t pitchOrLinearSize;
+    uint32_t depth;
+    uint32_t mipMapCount;
+    uint32_t reserved1[11];
+    DdsPixelFormat pixelFormat;
+    uint32_t caps;
+    uint32_t caps2;
+    uint32_t caps3;
+    uint32_t caps4;
+    uint32_t reserved2;
+};
+
+struct DdsHeaderDx10 {
+    uint32_t dxgiFormat;
+    uint32_t resourceDimension;
+    uint32_t miscFlag;
+    uint32_t arraySize;
+    uint32_t miscFlags2;
+};
+
+static_assert(sizeof(DdsHeader) == 124, "DDS header must be 124 bytes");
+
+bool statSource(const std::string& path, uint64_t& size, int64_t& mtime) {
+    std::error_code ec;
+    auto fileSize = std::filesystem::file_size(path, ec);
+    if (ec) return false;
+    auto writeTime = std::filesystem::last_write_time(path, ec);
+    if (ec) return false;
+    size = (uint64_t)fileSize;
+    mtime = (int64_t)writeTime.time_since_epoch().count();
+    return true;
+}
+
+bool hashSource(const std::string& path, uint64_t& hash) {
+    MappedFile src;
+    if (!src.open(path)) return false;
+    hash = hashBytes(src.data(), src.size());
+    return true;
+}
+
+void storeU64(uint32_t* dst, uint64_t value) {
+    std::memcpy(dst, &value, sizeof(value));
+}
+
+uint64_t loadU64(const uint32_t* src) {
+    uint64_t value;
+    std::memcpy(&value, src, sizeof(value));
+    return value;
+}
+
+//ca in MeshCache: dupa ce hash-ul a confirmat sursa, mtime-ul nou intra in antet (reserved1[5..6]),
+//cu fisierul nemapat; un esec doar pastreaza calea lenta
+void rewriteSourceMtime(const std::string& cachePath, int64_t mtime) {
+    uint32_t words[2];
+    storeU64(words, (uint64_t)mtime);
+    std::fstream file(cachePath, std::ios::binary | std::ios::in | std::ios::out);
+    if (!file.is_open()) return;
+    file.seekp((std::streamoff)(sizeof(kDdsMagic) + offsetof(DdsHeader, reserved1) + 5 * sizeof(uint32_t)));
+    file.write(reinterpret_cast<const char*>(words), sizeof(words));
+}
+
+} // namespace
+
+std::string textureCachePath(const std::string& imagePath, int maxDimension, TextureUsage usage) {
+    //aceeasi imagine poate fi si textura de scena si textura de material, la alta rezolutie
+    std::string suffix = usage == TextureUsage::Material ? ".material.cooked.dds" : ".cooked.dds";
+    if (maxDimension > 0) return imagePath + "." + std::to_string(maxDimension) + suffix;
+    return imagePath + suffix;
+}
+
+namespace {
+
+//verifica antetul si descrie mip-urile; out.data arata in data
+bool parseTextureCache(const uint8_t* data, size_t size, TextureUsage usage, int maxDimension, bool allowBc7,
+                       DdsHeader& header, CompressedTexture& out) {
+    if (size < 4 + sizeof(DdsHeader)) return false;
+    uint32_t magic;
+    std::memcpy(&magic, data, 4);
+    std::memcpy(&header, data + 4, sizeof(header));
+    if (magic != kDdsMagic || header.size != sizeof(DdsHeader)) return false;
+    if (header.reserved1[0] != kCookedMagic || header.reserved1[1] != kTextureCacheVersion) return false;
+    if (header.reserved1[2] != (uint32_t)usage) return false;
+    if (header.reserved1[9] != (uint32_t)std::max(maxDimension, 0)) return false;
+
+    size_t dataOffset = 4 + sizeof(DdsHeader);
+    BlockFormat format;
+    if (header.pixelFormat.fourCC == kFourCCDxt1) {
+        format = BlockFormat::BC1;
+    } else if (header.pixelFormat.fourCC == kFourCCDxt5) {
+        format = BlockFormat::BC3;
+    } else if (header.pixelFormat.fourCC == kFourCCDx10) {
+        if (size < dataOffset + sizeof(DdsHeaderDx10)) return false;
+        DdsHeaderDx10 dx10;
+        std::memcpy(&dx10, data + dataOffset, sizeof(dx10));
+        dataOffset += sizeof(dx10);
+        if (dx10.dxgiFormat == kDxgiBc5Unorm) format = BlockFormat::BC5;
+        else if (dx10.dxgiFormat == kDxgiBc7Unorm) format = BlockFormat::BC7;
+        else return false;
+    } else {
+        return false;
+    }
+    if (format == BlockFormat::BC7 && !allowBc7) return false;
+    if (header.width == 0 || header.height == 0 || header.mipMapCount == 0) return false;
+
+    out.mips.clear();
+    size_t total = 0;
+    int w = (int)header.width, h = (int)header.height;
+    for (uint32_t i = 0; i < header.mipMapCount; i++) {
+        CompressedMip mip;
+        mip.width = w;
+        mip.height = h;
+        mip.offset = total;
+        mip.size = compressedSize(format, w, h);
+        total += mip.size;
+        out.mips.push_back(mip);
+        w = std::max(1, w / 2);
+        h = std::max(1, h / 2);
+    }
+    if (dataOffset + total > size) return false;
+
+    out.format = format;
+    out.width = (int)header.width;
+    out.height = (int)header.height;
+    out.sourceWidth = header.reserved1[10] ? (int)(header.reserved1[10] >> 16) : out.width;
+    out.sourceHeight = header.reserved1[10] ? (int)(header.reserved1[10] & 0xFFFF) : out.height;
+    out.storage.clear();
+    out.data = data + dataOffset;
+    out.dataSize = total;
+    return true;
+}
+
+} // namespace
+
+bool openTextureCache(const std::string& imagePath, TextureUsage usage, int maxDimension, bool allowBc7,
+                      CompressedTexture& out) {
+    DdsHeader header;
+    //intrarea din pack e folosita doar daca imaginea nu s-a schimbat de la gatire (sau lipseste)
+    if (assetPack().isOpen()) {
+        PackBlob blob;
+        if (assetPack().readFresh(packEntryName(textureCachePath(imagePath, maxDimension, usage)), { imagePath }, blob)) {
+            if (!parseTextureCache(blob.data, blob.size, usage, maxDimension, allowBc7, header, out)) return false;
+            //data arata deja in blob.storage, iar mutarea vectorului nu muta elementele
+            out.storage = std::move(blob.storage);
+            return true;
+        }
+    }
+
+    uint64_t srcSize;
+    int64_t srcMtime;
+    if (!statSource(imagePath, srcSize, srcMtime)) return false;
+
+    std::string cachePath = textureCachePath(imagePath, maxDimension, usage);
+    MappedFile file;
+    if (!file.open(cachePath)) return false;
+    if (!parseTextureCache(file.data(), file.size(), usage, maxDimension, allowBc7, header, out)) return false;
+    if (loadU64(&header.reserved1[3]) != srcSize) return false;
+
+    //daca doar mtime-ul difera (ex. checkout), verificam continutul
+    if ((int64_t)loadU64(&header.reserved1[5]) != srcMtime) {
+        uint64_t srcHash;
+        if (!hashSource(imagePath, srcHash) || srcHash != loadU64(&header.reserved1[7])) return false;
+        file.close();
+        rewriteSourceMtime(cachePath, srcMtime);
+        if (!file.open(cachePath) ||
+            !parseTextureCache(file.data(), file.size(), usage, maxDimension, allowBc7, header, out)) return false;
+    }
+    out.file = std::move(file);
+    return true;
+}
+
+bool writeTextureCache(const std::string& imagePath, TextureUsage usage, int maxDimension,
+                       const CompressedTexture& texture) {
+    uint64_t srcSize, srcHash;
+    int64_t srcMtime;
+    if (!statSource(imagePath, srcSize, srcMtime) || !hashSource(imagePath, srcHash)) return false;
+    if (texture.mips.empty()) return false;
+
+    DdsHeader header = {};
+    header.size = sizeof(DdsHeader);
+    header.flags = kDdsdCaps | kDdsdHeight | kDdsdWidth | kDdsdPixelFormat | kDdsdMipMapCount | kDdsdLinearSize;
+    header.height = (uint32_t)texture.height;
+    header.width = (uint32_t)texture.width;
+    header.pitchOrLinearSize = (uint32_t)texture.mips[0].size;
+    header.mipMapCount = (uint32_t)texture.mips.size();
+    header.reserved1[0] = kCookedMagic;
+    header.reserved1[1] = kTextureCacheVersion;
+    header.reserved1[2] = (uint32_t)usage;
+    storeU64(&header.reserved1[3], srcSize);
+    storeU64(&header.reserved1[5], (uint64_t)srcMtime);
+    storeU64(&header.reserved1[7], srcHash);
+    header.reserved1[9] = (uint32_t)std::max(maxDimension, 0);
+    //cate 16 biti pe latura; 0 pentru sursele mai mari, care se raporteaza apoi cu marimea gatita
+    if (texture.sourceWidth <= 0xFFFF && texture.sourceHeight <= 0xFFFF) {
+        header.reserved1[10] = ((uint32_t)texture.sourceWidth << 16) | (uint32_t)texture.sourceHeight;
+    }
+    header.pixelFormat.size = sizeof(DdsPixelFormat);
+    header.pixelFormat.flags = kDdpfFourCC;
+    header.caps = kDdsCapsTexture | kDdsCapsMipMap | kDdsCapsComplex;
+
+    DdsHeaderDx10 dx10 = {};
+    bool hasDx10 = false;
+    switch (texture.format) {
+    case BlockFormat::BC1:
+        header.pixelFormat.fourCC = kFourCCDxt1;
+        break;
+    case BlockFormat::BC3:
+        header.pixelFormat.fourCC = kFourCCDxt5;
+        break;
+    case BlockFormat::BC5:
+    case BlockFormat::BC7:
+        header.pixelFormat.fourCC = kFourCCDx10;
+        dx10.dxgiFormat = texture.format == BlockFormat::BC5 ? kDxgiBc5Unorm : kDxgiBc7Unorm;
+        dx10.resourceDimension = kDimensionTexture2D;
+        dx10.arraySize = 1;
+        hasDx10 = true;
+        break;
+    }
+
+    //scriem intr-un fisier temporar si il redenumim, ca sa nu ramana un cache pe jumatate
+    std::string finalPath = textureCachePath(imagePath, maxDimension, usage);
+    std::string tmpPath = finalPath + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            std::cerr << "Cannot write texture cache: " << tmpPath << "\n";
+            return false;
+        }
+        out.write(reinterpret_cast<const char*>(&kDdsMagic), 4);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        if (hasDx10) out.write(reinterpret_cast<const char*>(&dx10), sizeof(dx10));
+        out.write(reinterpret_cast<const char*>(texture.data), (std::streamsize)texture.dataSize);
+        if (!out) {
+            std::cerr << "Cannot write texture cache: " << tmpPath << "\n";
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmpPath, finalPath, ec);
+    if (ec) {
+        std::filesystem::remove(tmpPath, ec);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "TextureCompression.h"
+
+#include <cstdint>
+#include <string>
+
+//texturile comprimate se scriu langa imaginea sursa (<imagine>.cooked.dds, sau <imagine>.<max>.cooked.dds
+//cand dimensiunea e limitata, cu .material inainte de .cooked pentru TextureUsage::Material), cu tot lantul de mip-uri
+//e un DDS obisnuit (DXT1/DXT5 sau antet DX10 pentru BC5/BC7); cheia sursei (marime, mtime, hash)
+//sta in campurile rezervate ale antetului
+//randurile sunt deja in ordinea OpenGL (intoarse pe verticala), ca la TextureData
+constexpr uint32_t kTextureCacheVersion = 3;
+
+std::string textureCachePath(const std::string& imagePath, int maxDimension = 0,
+                             TextureUsage usage = TextureUsage::Color);
+
+//cauta intai in assetPack(), apoi langa sursa
+//intoarce false daca lipseste, e corupt, nu corespunde sursei sau are BC7 cand allowBc7 e false
+//datele raman mapate in out.file (sau in pack), ori decomprimate in out.storage
+bool openTextureCache(const std::string& imagePath, TextureUsage usage, int maxDimension, bool allowBc7,
+                      CompressedTexture& out);
+bool writeTextureCache(const std::string& imagePath, TextureUsage usage, int maxDimension,
+                       const CompressedTexture& texture);
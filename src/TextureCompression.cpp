@@ -0,0 +1,389 @@
+#include "TextureCompression.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+//axa principala a unui nor de puncte cu C canale (iteratia puterii pe covarianta)
+template <int C>
+void fitEndpoints(const float (*points)[C], int count, float* e0, float* e1) {
+    float mean[C] = {};
+    for (int i = 0; i < count; i++) {
+        for (int c = 0; c < C; c++) mean[c] += points[i][c];
+    }
+    for (int c = 0; c < C; c++) mean[c] /= (float)count;
+
+    float cov[C][C] = {};
+    float lo[C], hi[C];
+    for (int c = 0; c < C; c++) lo[c] = hi[c] = points[0][c];
+    for (int i = 0; i < count; i++) {
+        float d[C];
+        for (int c = 0; c < C; c++) {
+            d[c] = points[i][c] - mean[c];
+            lo[c] = std::min(lo[c], points[i][c]);
+            hi[c] = std::max(hi[c], points[i][c]);
+        }
+        for (int a = 0; a < C; a++) {
+            for (int b = 0; b < C; b++) cov[a][b] += d[a] * d[b];
+        }
+    }
+
+    //pornim de la diagonala cutiei, care e deja aproape de axa pentru majoritatea blocurilor
+    float axis[C];
+    float len = 0.0f;
+    for (int c = 0; c < C; c++) {
+        axis[c] = hi[c] - lo[c];
+        len += axis[c] * axis[c];
+    }
+    if (len < 1e-6f) {
+        for (int c = 0; c < C; c++) e0[c] = e1[c] = mean[c];
+        return;
+    }
+    for (int iter = 0; iter < 8; iter++) {
+        float next[C] = {};
+        for (int a = 0; a < C; a++) {
+            for (int b = 0; b < C; b++) next[a] += cov[a][b] * axis[b];
+        }
+        float norm = 0.0f;
+        for (int c = 0; c < C; c++) norm = std::max(norm, std::fabs(next[c]));
+        if (norm < 1e-6f) break;
+        for (int c = 0; c < C; c++) axis[c] = next[c] / norm;
+    }
+    len = 0.0f;
+    for (int c = 0; c < C; c++) len += axis[c] * axis[c];
+    len = std::sqrt(len);
+    for (int c = 0; c < C; c++) axis[c] /= len;
+
+    float tMin = 0.0f, tMax = 0.0f;
+    for (int i = 0; i < count; i++) {
+        float t = 0.0f;
+        for (int c = 0; c < C; c++) t += (points[i][c] - mean[c]) * axis[c];
+        tMin = std::min(tMin, t);
+        tMax = std::max(tMax, t);
+    }
+    for (int c = 0; c < C; c++) {
+        e0[c] = std::clamp(mean[c] + axis[c] * tMin, 0.0f, 255.0f);
+        e1[c] = std::clamp(mean[c] + axis[c] * tMax, 0.0f, 255.0f);
+    }
+}
+
+uint16_t packRgb565(const float* c) {
+    int r = std::clamp((int)std::lround(c[0] * 31.0f / 255.0f), 0, 31);
+    int g = std::clamp((int)std::lround(c[1] * 63.0f / 255.0f), 0, 63);
+    int b = std::clamp((int)std::lround(c[2] * 31.0f / 255.0f), 0, 31);
+    return (uint16_t)((r << 11) | (g << 5) | b);
+}
+
+void unpackRgb565(uint16_t v, int* c) {
+    int r = (v >> 11) & 31, g = (v >> 5) & 63, b = v & 31;
+    c[0] = (r << 3) | (r >> 2);
+    c[1] = (g << 2) | (g >> 4);
+    c[2] = (b << 3) | (b >> 2);
+}
+
+//alege indicii pentru doua capete 565 deja ordonate (c0 > c1, modul cu 4 culori)
+int bc1Indices(const float (*points)[3], uint16_t c0, uint16_t c1, uint8_t* indices) {
+    int palette[4][3];
+    unpackRgb565(c0, palette[0]);
+    unpackRgb565(c1, palette[1]);
+    for (int c = 0; c < 3; c++) {
+        palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+        palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+    }
+    int total = 0;
+    for (int i = 0; i < 16; i++) {
+        int best = 0, bestError = 1 << 30;
+        for (int k = 0; k < 4; k++) {
+            int error = 0;
+            for (int c = 0; c < 3; c++) {
+                int d = (int)points[i][c] - palette[k][c];
+                error += d * d;
+            }
+            if (error < bestError) {
+                bestError = error;
+                best = k;
+            }
+        }
+        indices[i] = (uint8_t)best;
+        total += bestError;
+    }
+    return total;
+}
+
+//cuantizeaza capetele si intoarce eroarea; c0 == c1 inseamna bloc de o singura culoare
+int bc1Quantize(const float (*points)[3], const float* e0, const float* e1,
+                uint16_t& c0, uint16_t& c1, uint8_t* indices) {
+    c0 = packRgb565(e1);
+    c1 = packRgb565(e0);
+    if (c0 < c1) std::swap(c0, c1);
+    if (c0 == c1) {
+        //modul cu 3 culori ar face indexul 3 transparent, deci folosim doar c0
+        std::fill(indices, indices + 16, (uint8_t)0);
+        int palette[3];
+        unpackRgb565(c0, palette);
+        int total = 0;
+        for (int i = 0; i < 16; i++) {
+            for (int c = 0; c < 3; c++) {
+                int d = (int)points[i][c] - palette[c];
+                total += d * d;
+            }
+        }
+        return total;
+    }
+    return bc1Indices(points, c0, c1, indices);
+}
+
+void encodeBC1(const uint8_t* block, uint8_t* out) {
+    float points[16][3];
+    for (int i = 0; i < 16; i++) {
+        for (int c = 0; c < 3; c++) points[i][c] = block[i * 4 + c];
+    }
+    float e0[3], e1[3];
+    fitEndpoints<3>(points, 16, e0, e1);
+
+    uint16_t c0, c1;
+    uint8_t indices[16];
+    int error = bc1Quantize(points, e0, e1, c0, c1, indices);
+
+    //o iteratie de cele mai mici patrate pe capete, cu indicii gasiti
+    if (c0 != c1 && error > 0) {
+        static const float kWeight[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+        float a = 0, b = 0, d = 0;
+        float r0[3] = {}, r1[3] = {};
+        for (int i = 0; i < 16; i++) {
+            float w = kWeight[indices[i]];
+            a += w * w;
+            b += w * (1.0f - w);
+            d += (1.0f - w) * (1.0f - w);
+            for (int c = 0; c < 3; c++) {
+                r0[c] += w * points[i][c];
+                r1[c] += (1.0f - w) * points[i][c];
+            }
+        }
+        float det = a * d - b * b;
+        if (std::fabs(det) > 1e-6f) {
+            float n0[3], n1[3];
+            for (int c = 0; c < 3; c++) {
+                n1[c] = std::clamp((d * r0[c] - b * r1[c]) / det, 0.0f, 255.0f);
+                n0[c] = std::clamp((a * r1[c] - b * r0[c]) / det, 0.0f, 255.0f);
+            }
+            uint16_t q0, q1;
+            uint8_t refined[16];
+            if (bc1Quantize(points, n0, n1, q0, q1, refined) < error) {
+                c0 = q0;
+                c1 = q1;
+                std::memcpy(indices, refined, 16);
+            }
+        }
+    }
+
+    uint32_t bits = 0;
+    for (int i = 0; i < 16; i++) bits |= (uint32_t)indices[i] << (2 * i);
+    out[0] = (uint8_t)(c0 & 0xFF);
+    out[1] = (uint8_t)(c0 >> 8);
+    out[2] = (uint8_t)(c1 & 0xFF);
+    out[3] = (uint8_t)(c1 >> 8);
+    for (int i = 0; i < 4; i++) out[4 + i] = (uint8_t)(bits >> (8 * i));
+}
+
+//un canal, 8 valori interpolate intre minim si maxim
+void encodeBC4(const uint8_t* block, int channel, uint8_t* out) {
+    int lo = 255, hi = 0;
+    for (int i = 0; i < 16; i++) {
+        lo = std::min(lo, (int)block[i * 4 + channel]);
+        hi = std::max(hi, (int)block[i * 4 + channel]);
+    }
+    out[0] = (uint8_t)hi;
+    out[1] = (uint8_t)lo;
+    uint64_t bits = 0;
+    if (hi != lo) {
+        int palette[8] = { hi, lo };
+        for (int k = 1; k <= 6; k++) palette[k + 1] = ((7 - k) * hi + k * lo + 3) / 7;
+        for (int i = 0; i < 16; i++) {
+            int v = block[i * 4 + channel];
+            int best = 0, bestError = 256;
+            for (int k = 0; k < 8; k++) {
+                int error = std::abs(v - palette[k]);
+                if (error < bestError) {
+                    bestError = error;
+                    best = k;
+                }
+            }
+            bits |= (uint64_t)best << (3 * i);
+        }
+    }
+    for (int i = 0; i < 6; i++) out[2 + i] = (uint8_t)(bits >> (8 * i));
+}
+
+//scrie campuri de biti de la cel mai putin semnificativ
+struct BitWriter {
+    uint8_t* out;
+    int pos = 0;
+
+    void write(uint32_t value, int count) {
+        for (int i = 0; i < count; i++, pos++) {
+            if (value & (1u << i)) out[pos >> 3] |= (uint8_t)(1u << (pos & 7));
+        }
+    }
+};
+
+//BC7 modul 6: capete RGBA pe 7 biti + un p-bit fiecare, indici pe 4 biti
+void encodeBC7(const uint8_t* block, uint8_t* out) {
+    static const int kWeights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+    float points[16][4];
+    for (int i = 0; i < 16; i++) {
+        for (int c = 0; c < 4; c++) points[i][c] = block[i * 4 + c];
+    }
+    float e[2][4];
+    fitEndpoints<4>(points, 16, e[0], e[1]);
+
+    //pentru fiecare capat alegem p-bit-ul care reconstruieste mai bine cele 4 canale
+    int q[2][4], p[2];
+    for (int k = 0; k < 2; k++) {
+        float bestError = 1e30f;
+        for (int bit = 0; bit < 2; bit++) {
+            int cand[4];
+            float error = 0.0f;
+            for (int c = 0; c < 4; c++) {
+                cand[c] = std::clamp((int)std::lround((e[k][c] - bit) * 0.5f), 0, 127);
+                float d = (float)((cand[c] << 1) | bit) - e[k][c];
+                error += d * d;
+            }
+            if (error < bestError) {
+                bestError = error;
+                p[k] = bit;
+                std::memcpy(q[k], cand, sizeof(cand));
+            }
+        }
+    }
+
+    int palette[16][4];
+    for (int w = 0; w < 16; w++) {
+        for (int c = 0; c < 4; c++) {
+            int a = (q[0][c] << 1) | p[0];
+            int b = (q[1][c] << 1) | p[1];
+            palette[w][c] = ((64 - kWeights[w]) * a + kWeights[w] * b + 32) >> 6;
+        }
+    }
+    int indices[16];
+    for (int i = 0; i < 16; i++) {
+        int best = 0, bestError = 1 << 30;
+        for (int w = 0; w < 16; w++) {
+            int error = 0;
+            for (int c = 0; c < 4; c++) {
+                int d = block[i * 4 + c] - palette[w][c];
+                error += d * d;
+            }
+            if (error < bestError) {
+                bestError = error;
+                best = w;
+            }
+        }
+        indices[i] = best;
+    }
+    //primul index are bitul de sus implicit 0; altfel inversam capetele
+    if (indices[0] & 8) {
+        std::swap(q[0], q[1]);
+        std::swap(p[0], p[1]);
+        for (int& index : indices) index = 15 - index;
+    }
+
+    std::memset(out, 0, 16);
+    BitWriter writer{ out };
+    writer.write(1u << 6, 7);
+    for (int c = 0; c < 4; c++) {
+        writer.write((uint32_t)q[0][c], 7);
+        writer.write((uint32_t)q[1][c], 7);
+    }
+    writer.write((uint32_t)p[0], 1);
+    writer.write((uint32_t)p[1], 1);
+    writer.write((uint32_t)indices[0], 3);
+    for (int i = 1; i < 16; i++) writer.write((uint32_t)indices[i], 4);
+}
+
+} // namespace
+
+size_t blockBytes(BlockFormat format) {
+    return format == BlockFormat::BC1 ? 8 : 16;
+}
+
+size_t compressedSize(BlockFormat format, int width, int height) {
+    size_t blocksX = (size_t)(width + 3) / 4;
+    size_t blocksY = (size_t)(height + 3) / 4;
+    return blocksX * blocksY * blockBytes(format);
+}
+
+BlockFormat chooseBlockFormat(const uint8_t* pixels, int width, int height,
+                              TextureUsage usage, bool allowBc7) {
+    if (usage == TextureUsage::Normal) return BlockFormat::BC5;
+    size_t count = (size_t)width * height;
+    for (size_t i = 0; i < count; i++) {
+        if (pixels[i * 4 + 3] != 255) return allowBc7 ? BlockFormat::BC7 : BlockFormat::BC3;
+    }
+    return BlockFormat::BC1;
+}
+
+void encodeBlock(BlockFormat format, const uint8_t* blockPixels, uint8_t* out) {
+    switch (format) {
+    case BlockFormat::BC1:
+        encodeBC1(blockPixels, out);
+        break;
+    case BlockFormat::BC3:
+        encodeBC4(blockPixels, 3, out);
+        encodeBC1(blockPixels, out + 8);
+        break;
+    case BlockFormat::BC5:
+        encodeBC4(blockPixels, 0, out);
+        encodeBC4(blockPixels, 1, out + 8);
+        break;
+    case BlockFormat::BC7:
+        encodeBC7(blockPixels, out);
+        break;
+    }
+}
+
+void encodeImage(BlockFormat format, const uint8_t* pixels, int width, int height, uint8_t* out) {
+    size_t stride = blockBytes(format);
+    uint8_t block[16 * 4];
+    for (int by = 0; by < height; by += 4) {
+        for (int bx = 0; bx < width; bx += 4) {
+            for (int y = 0; y < 4; y++) {
+                int sy = std::min(by + y, height - 1);
+                for (int x = 0; x < 4; x++) {
+                    int sx = std::min(bx + x, width - 1);
+                    std::memcpy(block + (y * 4 + x) * 4, pixels + ((size_t)sy * width + sx) * 4, 4);
+                }
+            }
+            encodeBlock(format, block, out);
+            out += stride;
+        }
+    }
+}
+
+void compressTexture(const std::vector<ImageLevel>& levels, BlockFormat format, CompressedTexture& out) {
+    out.format = format;
+    out.width = levels.empty() ? 0 : levels[0].width;
+    out.height = levels.empty() ? 0 : levels[0].height;
+    out.mips.clear();
+
+    size_t total = 0;
+    for (const auto& level : levels) {
+        CompressedMip mip;
+        mip.width = level.width;
+        mip.height = level.height;
+        mip.offset = total;
+        mip.size = compressedSize(format, level.width, level.height);
+        total += mip.size;
+        out.mips.push_back(mip);
+    }
+    out.storage.assign(total, 0);
+    for (size_t i = 0; i < levels.size(); i++) {
+        encodeImage(format, levels[i].pixels.data(), levels[i].width, levels[i].height,
+                    out.storage.data() + out.mips[i].offset);
+    }
+    out.data = out.storage.data();
+    out.dataSize = out.storage.size();
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "ImageResize.h"
+#include "MappedFile.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//formate comprimate pe blocuri de 4x4 pixeli
+//BC1: RGB opac, 8 bytes/bloc; BC3: BC1 + alfa BC4, 16 bytes; BC5: doua canale BC4 (normale XY), 16 bytes
+//BC7: RGBA, 16 bytes (encoderul foloseste doar modul 6, un singur subset)
+enum class BlockFormat {
+    BC1,
+    BC3,
+    BC5,
+    BC7
+};
+
+//cum e folosita textura; de aici se alege formatul
+enum class TextureUsage {
+    Color,
+    Normal,
+    Material    //ca Color, dar patrata, cu latura putere a lui 2 (clasa de rezolutie din MaterialArrays)
+};
+
+struct CompressedMip {
+    int width = 0;
+    int height = 0;
+    size_t offset = 0;  //in bytes, fata de data
+    size_t size = 0;
+};
+
+//lantul complet de mip-uri, fie construit acum (storage), fie mapat dintr-un fisier (file)
+struct CompressedTexture {
+    BlockFormat format = BlockFormat::BC1;
+    int width = 0;
+    int height = 0;
+    //imaginea din care s-a gatit, inainte de limitarea rezolutiei (pastrata in cache)
+    int sourceWidth = 0;
+    int sourceHeight = 0;
+    std::vector<CompressedMip> mips;
+    const uint8_t* data = nullptr;
+    size_t dataSize = 0;
+
+    std::vector<uint8_t> storage;
+    MappedFile file;
+};
+
+size_t blockBytes(BlockFormat format);
+size_t compressedSize(BlockFormat format, int width, int height);
+
+//pixels e RGBA8 (width*height*4); alfa conteaza doar daca vreun pixel nu e opac
+BlockFormat chooseBlockFormat(const uint8_t* pixels, int width, int height,
+                              TextureUsage usage, bool allowBc7);
+
+//codeaza un bloc de 16 pixeli RGBA8 (randurile blocului unul dupa altul)
+void encodeBlock(BlockFormat format, const uint8_t* blockPixels, uint8_t* out);
+//codeaza o imagine intreaga; marginile care nu umplu un bloc repeta ultimul pixel
+void encodeImage(BlockFormat format, const uint8_t* pixels, int width, int height, uint8_t* out);
+
+//comprima un lant de mip-uri deja generat (buildMipChain) in out.storage
+void compressTexture(const std::vector<ImageLevel>& levels, BlockFormat format, CompressedTexture& out);
@@ -0,0 +1,117 @@
+#include "TextureCook.h"
+#include "TextureCache.h"
+
+#include <stb_image.h>
+
+#include <algorithm>
+#include <iostream>
+
+bool decodeTextureFile(const std::string& path, TextureData& out) {
+    //flip-ul global din stb_image nu e sigur intre thread-uri, il setam doar pe thread-ul curent
+    stbi_set_flip_vertically_on_load_thread(true);
+    int width, height, channels;
+    unsigned char* data = stbi_load(path.c_str(), &width, &height, &channels, 0);
+    if (!data) {
+        std::cerr << "Failed to load texture: " << path << "\n";
+        return false;
+    }
+    out.width = width;
+    out.height = height;
+    out.channels = channels;
+    out.pixels.assign(data, data + (size_t)width * height * channels);
+    stbi_image_free(data);
+    return true;
+}
+
+namespace {
+
+//clasa de rezolutie a texturilor de material: patrat cu latura puterea lui 2 cea mai apropiata de latura mare,
+//fara sa treaca de maxDimension; UV-urile sunt normalizate, deci doar densitatea texelilor se schimba
+int materialClassSize(int width, int height, int maxDimension) {
+    int largest = std::max(width, height);
+    int side = 1;
+    while (side * 2 <= largest) side *= 2;
+    if (largest - side > side * 2 - largest && (maxDimension <= 0 || side * 2 <= maxDimension)) side *= 2;
+    return side;
+}
+
+//acelasi rezultat ca upload-ul GL_RED/GL_RG/GL_RGB: canalele lipsa devin 0, alfa 255
+void expandToRgba(const TextureData& data, std::vector<uint8_t>& rgba) {
+    size_t count = (size_t)data.width * data.height;
+    rgba.resize(count * 4);
+    const unsigned char* src = data.pixels.data();
+    for (size_t i = 0; i < count; i++) {
+        uint8_t* dst = rgba.data() + i * 4;
+        dst[0] = src[0];
+        dst[1] = data.channels >= 2 ? src[1] : 0;
+        dst[2] = data.channels >= 3 ? src[2] : 0;
+        dst[3] = data.channels == 4 ? src[3] : 255;
+        src += data.channels;
+    }
+}
+
+const char* blockFormatName(BlockFormat format) {
+    switch (format) {
+    case BlockFormat::BC1: return "BC1";
+    case BlockFormat::BC3: return "BC3";
+    case BlockFormat::BC5: return "BC5";
+    case BlockFormat::BC7: return "BC7";
+    }
+    return "?";
+}
+
+} // namespace
+
+bool prepareTexture(const std::string& path, TextureUsage usage, const TextureLoadOptions& options,
+                    PreparedTexture& out) {
+    if (options.compress && openTextureCache(path, usage, options.maxDimension, options.allowBc7, out.blocks)) {
+        out.compressed = true;
+        out.sourceWidth = out.blocks.sourceWidth;
+        out.sourceHeight = out.blocks.sourceHeight;
+        return true;
+    }
+    TextureData image;
+    if (!decodeTextureFile(path, image)) return false;
+    out.sourceWidth = image.width;
+    out.sourceHeight = image.height;
+
+    //imaginile prea mari se micsoreaza o data, pe CPU, inainte de mip-uri si compresie
+    ImageLevel base;
+    expandToRgba(image, base.pixels);
+    base.width = image.width;
+    base.height = image.height;
+    image = TextureData();
+    int width, height;
+    fitToMaxDimension(base.width, base.height, options.maxDimension, width, height);
+    if (usage == TextureUsage::Material) width = height = materialClassSize(width, height, options.maxDimension);
+    if (width != base.width || height != base.height) {
+        std::vector<uint8_t> resized;
+        resizeImage(base.pixels.data(), base.width, base.height, width, height, resized);
+        base.pixels.swap(resized);
+        base.width = width;
+        base.height = height;
+    }
+    buildMipChain(std::move(base), out.levels);
+    if (!options.compress) return true;
+
+    const ImageLevel& top = out.levels[0];
+    BlockFormat format = chooseBlockFormat(top.pixels.data(), top.width, top.height, usage, options.allowBc7);
+    compressTexture(out.levels, format, out.blocks);
+    out.blocks.sourceWidth = out.sourceWidth;
+    out.blocks.sourceHeight = out.sourceHeight;
+    std::cout << "Cooked texture: " << path << " -> " << blockFormatName(format) << " "
+              << top.width << "x" << top.height << " (" << out.blocks.mips.size() << " mips, "
+              << out.blocks.dataSize / 1024 << " KB)\n";
+    if (writeTextureCache(path, usage, options.maxDimension, out.blocks)) {
+        //citim inapoi din fisierul mapat, ca lantul sa nu mai ocupe memorie pe heap
+        CompressedTexture mapped;
+        if (openTextureCache(path, usage, options.maxDimension, options.allowBc7, mapped)) {
+            out.blocks = std::move(mapped);
+        }
+    } else {
+        std::cerr << "Texture cache not written for: " << path << "\n";
+    }
+    out.compressed = true;
+    out.levels.clear();
+    return true;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "TextureCompression.h"
+
+#include <string>
+#include <vector>
+
+//partea de CPU a texturilor (decodare, micsorare, mip-uri, compresie, cache), fara OpenGL,
+//folosita si de loader si de asset_cooker
+
+//imagine decodata pe CPU, gata de urcat; nu atinge OpenGL,
+//deci poate fi produsa pe orice thread
+struct TextureData {
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+    std::vector<unsigned char> pixels;
+};
+
+//decodeaza cu stb_image, intoarsa pe verticala ca pentru OpenGL
+bool decodeTextureFile(const std::string& path, TextureData& out);
+
+//ce stie GPU-ul (queryTextureLoadOptions in Texture.h) si limita de rezolutie ceruta
+struct TextureLoadOptions {
+    bool compress = false;          //BC1/BC3/BC5 (S3TC + RGTC)
+    bool allowBc7 = false;          //BPTC, pentru texturile cu alfa
+    bool immutableStorage = false;  //glTexStorage2D (4.2 / ARB_texture_storage)
+    int maxDimension = 0;           //latura maxima dupa incarcare; 0 = fara limita
+};
+
+//aceeasi imagine cu alta folosire sau alta limita e alta textura in registru
+inline int textureVariant(TextureUsage usage, int maxDimension) {
+    return (int)usage | (maxDimension > 0 ? maxDimension : 0) << 2;
+}
+
+//o textura gata de urcat: fie lantul comprimat (din cache sau comprimat acum),
+//fie lantul de mip-uri RGBA8 generat pe CPU
+struct PreparedTexture {
+    bool compressed = false;
+    CompressedTexture blocks;
+    std::vector<ImageLevel> levels;
+    int sourceWidth = 0;
+    int sourceHeight = 0;
+
+    int width() const { return compressed ? blocks.width : levels[0].width; }
+    int height() const { return compressed ? blocks.height : levels[0].height; }
+    int levelCount() const { return compressed ? (int)blocks.mips.size() : (int)levels.size(); }
+};
+
+//partea de CPU, fara OpenGL: foloseste cache-ul comprimat daca e valid, altfel decodeaza,
+//micsoreaza la maxDimension (Material: la clasa de rezolutie), genereaza mip-urile, comprima si scrie cache-ul
+bool prepareTexture(const std::string& path, TextureUsage usage, const TextureLoadOptions& options,
+                    PreparedTexture& out);
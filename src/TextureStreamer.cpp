@@ -0,0 +1,175 @@
+#include "TextureStreamer.h"
+#include "AssetLoader.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+TextureStreamer::TextureStreamer(AssetLoader& loader, size_t budgetBytes)
+    : loader(loader), budget(budgetBytes) {
+}
+
+size_t TextureStreamer::residentBytes() const {
+    size_t total = 0;
+    for (const auto& record : records) {
+        if (auto texture = record.texture.lock()) total += texture->gpuBytes;
+    }
+    return total;
+}
+
+TextureStreamer::Record* TextureStreamer::find(const TextureAsset* texture) {
+    for (auto& record : records) {
+        if (record.texture.lock().get() == texture) return &record;
+    }
+    return nullptr;
+}
+
+bool TextureStreamer::adopt(const TextureHandle& texture, const std::shared_ptr<PreparedTexture>& source,
+                            GLuint pbo) {
+    if (!source->compressed) return false;
+    const std::vector<CompressedMip>& mips = source->blocks.mips;
+    int tail = 0;
+    while (tail + 1 < (int)mips.size() && std::max(mips[tail].width, mips[tail].height) > kResidentTailSize) {
+        tail++;
+    }
+    if (tail == 0) return false;
+
+    //stocare mutabila, ca nivelurile scoase sa poata fi eliberate
+    texture->id = uploadCompressedLevels(source->blocks, tail, false, pbo);
+    texture->width = source->width();
+    texture->height = source->height();
+    texture->levelCount = source->levelCount();
+    texture->baseLevel = tail;
+    texture->gpuBytes = source->blocks.dataSize - mips[tail].offset;
+
+    Record record;
+    record.texture = texture;
+    record.source = source;
+    record.tailLevel = tail;
+    record.wantedLevel = tail;
+    records.push_back(record);
+    return true;
+}
+
+void TextureStreamer::request(const TextureHandle& texture, float uvPerPixel, float priority) {
+    if (!texture || texture->state != AssetState::Ready) return;
+    Record* record = find(texture.get());
+    if (!record) return;
+
+    //nivelul la care un texel acopera cam un pixel
+    int level = 0;
+    float texelsPerPixel = uvPerPixel * (float)std::max(texture->width, texture->height);
+    if (texelsPerPixel > 1.0f) level = (int)std::floor(std::log2(texelsPerPixel));
+    level = std::clamp(level, 0, record->tailLevel);
+
+    if (record->lastRequest != frame) {
+        record->wantedLevel = level;
+        record->priority = priority;
+        record->lastRequest = frame;
+    } else {
+        record->wantedLevel = std::min(record->wantedLevel, level);
+        record->priority = std::max(record->priority, priority);
+    }
+}
+
+int TextureStreamer::targetLevel(const Record& record) const {
+    //ce nu s-a cerut in cadrul asta se poate intoarce la coada
+    return record.lastRequest == frame ? record.wantedLevel : record.tailLevel;
+}
+
+bool TextureStreamer::evictOne(const Record* keep, float belowPriority, size_t& resident) {
+    //doar niveluri peste ce se cere; intai texturile necerute (cele vechi primele), apoi prioritatea mica
+    Record* victim = nullptr;
+    TextureHandle victimTexture;
+    for (auto& record : records) {
+        if (&record == keep || record.inFlight) continue;
+        TextureHandle texture = record.texture.lock();
+        if (!texture || texture->baseLevel >= targetLevel(record)) continue;
+        bool requested = record.lastRequest == frame;
+        if (requested && record.priority >= belowPriority) continue;
+        if (victim) {
+            bool victimRequested = victim->lastRequest == frame;
+            if (requested && !victimRequested) continue;
+            if (requested == victimRequested) {
+                if (!requested && record.lastRequest >= victim->lastRequest) continue;
+                if (requested && record.priority >= victim->priority) continue;
+            }
+        }
+        victim = &record;
+        victimTexture = texture;
+    }
+    if (!victim) return false;
+
+    int level = victimTexture->baseLevel;
+    size_t size = victim->source->blocks.mips[level].size;
+    releaseCompressedLevel(victimTexture->id, victim->source->blocks, level);
+    victimTexture->baseLevel = level + 1;
+    victimTexture->gpuBytes -= size;
+    resident -= size;
+    return true;
+}
+
+void TextureStreamer::streamIn(Record& record) {
+    TextureHandle texture = record.texture.lock();
+    int level = texture->baseLevel - 1;
+    record.inFlight = true;
+    inFlight++;
+
+    std::shared_ptr<const PreparedTexture> source = record.source;
+    std::weak_ptr<TextureAsset> weak = record.texture;
+    loader.submit([this, source, weak, level]() -> AssetLoader::UploadTask {
+        //copia citeste paginile din fisierul mapat aici, pe worker, nu pe thread-ul GL
+        const CompressedMip& mip = source->blocks.mips[level];
+        const uint8_t* begin = source->blocks.data + mip.offset;
+        auto bytes = std::make_shared<std::vector<uint8_t>>(begin, begin + mip.size);
+        return [this, weak, level, bytes] { finishStreamIn(weak, level, *bytes); };
+    });
+}
+
+void TextureStreamer::finishStreamIn(const std::weak_ptr<TextureAsset>& weak, int level,
+                                     const std::vector<uint8_t>& bytes) {
+    inFlight--;
+    TextureHandle texture = weak.lock();
+    if (!texture) return;
+    Record* record = find(texture.get());
+    if (!record) return;
+    record->inFlight = false;
+    //nivelurile se adauga doar lipite de cele rezidente
+    if (level != texture->baseLevel - 1) return;
+
+    uploadCompressedLevel(texture->id, record->source->blocks, level, bytes.data());
+    texture->baseLevel = level;
+    texture->gpuBytes += bytes.size();
+}
+
+void TextureStreamer::update() {
+    records.erase(std::remove_if(records.begin(), records.end(),
+                                 [](const Record& r) { return r.texture.expired(); }),
+                  records.end());
+
+    size_t resident = residentBytes();
+    while (resident > budget && evictOne(nullptr, std::numeric_limits<float>::max(), resident)) {
+    }
+
+    std::vector<Record*> wanting;
+    for (auto& record : records) {
+        if (record.inFlight || record.lastRequest != frame) continue;
+        TextureHandle texture = record.texture.lock();
+        if (texture && texture->baseLevel > record.wantedLevel) wanting.push_back(&record);
+    }
+    std::sort(wanting.begin(), wanting.end(),
+              [](const Record* a, const Record* b) { return a->priority > b->priority; });
+
+    //cate un nivel odata, ca texturile vizibile sa se imbunatateasca toate treptat
+    for (Record* record : wanting) {
+        if (inFlight >= kMaxInFlight) break;
+        TextureHandle texture = record->texture.lock();
+        size_t size = record->source->blocks.mips[texture->baseLevel - 1].size;
+        while (resident + size > budget && evictOne(record, record->priority, resident)) {
+        }
+        if (resident + size > budget) continue;
+        resident += size;
+        streamIn(*record);
+    }
+    frame++;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "AssetTypes.h"
+#include "Texture.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class AssetLoader;
+
+//texturile comprimate mari pornesc doar cu nivelurile mici (coada rezidenta); nivelurile mari
+//se citesc pe worker-i si se urca pe rand, in ordinea prioritatii cerute in cadrul curent,
+//iar peste buget se scot din nou. Ce e pe GPU e limitat prin GL_TEXTURE_BASE_LEVEL
+//(MAX_LEVEL ramane ultimul nivel), iar nivelurile scoase sunt redefinite ca 0x0.
+class TextureStreamer {
+public:
+    //latura maxima a celui mai mare nivel din coada rezidenta
+    static constexpr int kResidentTailSize = 128;
+    //cate niveluri pot fi in citire in acelasi timp
+    static constexpr int kMaxInFlight = 2;
+
+    //streamer-ul trebuie sa existe pana la loader.shutdown()
+    TextureStreamer(AssetLoader& loader, size_t budgetBytes);
+
+    TextureStreamer(const TextureStreamer&) = delete;
+    TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+    void setBudget(size_t budgetBytes) { budget = budgetBytes; }
+    size_t budgetBytes() const { return budget; }
+    size_t residentBytes() const;
+
+    //apelat de loader pe thread-ul GL; urca doar coada si pastreaza sursa pentru restul nivelurilor
+    //intoarce false daca textura nu se preteaza (necomprimata sau deja mica)
+    bool adopt(const TextureHandle& texture, const std::shared_ptr<PreparedTexture>& source, GLuint pbo);
+
+    //cererile cadrului curent: uvPerPixel = cate unitati UV acopera un pixel pe ecran (0 = nivelul 0),
+    //priority = cat de mare apare pe ecran ce foloseste textura
+    void request(const TextureHandle& texture, float uvPerPixel, float priority);
+
+    //o data pe cadru, pe thread-ul GL, dupa ce s-au facut cererile
+    void update();
+
+private:
+    struct Record {
+        std::weak_ptr<TextureAsset> texture;
+        std::shared_ptr<const PreparedTexture> source;
+        int tailLevel = 0;
+        int wantedLevel = 0;
+        float priority = 0.0f;
+        uint64_t lastRequest = 0;
+        bool inFlight = false;
+    };
+
+    Record* find(const TextureAsset* texture);
+    int targetLevel(const Record& record) const;
+    bool evictOne(const Record* keep, float belowPriority, size_t& resident);
+    void streamIn(Record& record);
+    void finishStreamIn(const std::weak_ptr<TextureAsset>& texture, int level, const std::vector<uint8_t>& bytes);
+
+    AssetLoader& loader;
+    size_t budget;
+    uint64_t frame = 1;
+    int inFlight = 0;
+    std::vector<Record> records;
+};
@@ -0,0 +1,128 @@
+#include "UniformRing.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+size_t alignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+bool UniformRing::init(size_t bytesPerFrame, size_t pushesPerFrame) {
+    GLint offsetAlignment = 0;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &offsetAlignment);
+    //cel putin un texel, pentru vederile texture buffer
+    alignment = std::max<size_t>(offsetAlignment > 0 ? (size_t)offsetAlignment : 256, 16);
+    segmentSize = alignUp(bytesPerFrame, alignment) + pushesPerFrame * alignment;
+    size_t total = segmentSize * kFrames;
+    GLint maxTexels = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, &maxTexels);
+    if (total / 16 > (size_t)maxTexels) {
+        std::cerr << "Uniform ring of " << total << " bytes exceeds the texture buffer limit of "
+                  << maxTexels << " texels\n";
+        return false;
+    }
+
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+    bool created = true;
+    if (GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage) {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_UNIFORM_BUFFER, (GLsizeiptr)total, nullptr, flags);
+        mapped = (uint8_t*)glMapBufferRange(GL_UNIFORM_BUFFER, 0, (GLsizeiptr)total, flags);
+        created = mapped != nullptr;
+    } else {
+        glBufferData(GL_UNIFORM_BUFFER, (GLsizeiptr)total, nullptr, GL_STREAM_DRAW);
+    }
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    if (!created) {
+        std::cerr << "Cannot create uniform ring of " << total << " bytes\n";
+        release();
+        return false;
+    }
+    GLuint* textures[] = { &floatTexture, &uintTexture };
+    const GLenum formats[] = { GL_RGBA32F, GL_RGBA32UI };
+    for (int i = 0; i < 2; i++) {
+        glGenTextures(1, textures[i]);
+        glBindTexture(GL_TEXTURE_BUFFER, *textures[i]);
+        glTexBuffer(GL_TEXTURE_BUFFER, formats[i], buffer);
+    }
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+    segment = kFrames - 1;
+    head = segment * segmentSize;
+    return true;
+}
+
+void UniformRing::release() {
+    if (floatTexture) glDeleteTextures(1, &floatTexture);
+    if (uintTexture) glDeleteTextures(1, &uintTexture);
+    floatTexture = uintTexture = 0;
+    for (GLsync& fence : fences) {
+        if (fence) glDeleteSync(fence);
+        fence = nullptr;
+    }
+    if (buffer) {
+        if (mapped) {
+            glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+            glUnmapBuffer(GL_UNIFORM_BUFFER);
+            glBindBuffer(GL_UNIFORM_BUFFER, 0);
+        }
+        glDeleteBuffers(1, &buffer);
+    }
+    buffer = 0;
+    mapped = nullptr;
+}
+
+void UniformRing::beginFrame() {
+    segment = (segment + 1) % kFrames;
+    head = segment * segmentSize;
+    GLsync& fence = fences[segment];
+    if (!fence) return;
+    //in mod normal GPU-ul e deja cu kFrames - 1 cadre in urma si fence-ul e semnalat
+    GLenum status = glClientWaitSync(fence, 0, 0);
+    if (status == GL_TIMEOUT_EXPIRED) {
+        stallCount++;
+        do {
+            status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+        } while (status == GL_TIMEOUT_EXPIRED);
+    }
+    glDeleteSync(fence);
+    fence = nullptr;
+}
+
+void UniformRing::endFrame() {
+    fences[segment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+uint32_t UniformRing::push(const void* data, size_t size) {
+    size_t segmentStart = segment * segmentSize;
+    if (head + size > segmentStart + segmentSize) {
+        //nu ar trebui sa se intample, capacitatea vine din numarul de instante; desenarea va fi gresita
+        if (!overflowReported) {
+            std::cerr << "Uniform ring segment of " << segmentSize << " bytes is full\n";
+            overflowReported = true;
+        }
+        head = segmentStart;
+    }
+    size_t offset = head;
+    head = alignUp(head + size, alignment);
+    if (size == 0) return (uint32_t)offset;
+    if (mapped) {
+        std::memcpy(mapped + offset, data, size);
+    } else {
+        //fence-ul garanteaza ca GPU-ul nu mai citeste zona, deci map-ul poate fi nesincronizat
+        glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT;
+        void* target = glMapBufferRange(GL_UNIFORM_BUFFER, (GLintptr)offset, (GLsizeiptr)size, flags);
+        if (target) {
+            std::memcpy(target, data, size);
+            glUnmapBuffer(GL_UNIFORM_BUFFER);
+        }
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    }
+    return (uint32_t)offset;
+}
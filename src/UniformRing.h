@@ -0,0 +1,108 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+//punctul de legare al blocului comun din shadere (basic, depth, skybox)
+enum UniformBlockBinding : GLuint {
+    kFrameBlockBinding = 0
+};
+
+//unitatile de textura ale celor doua vederi texelFetch peste ring (datele instantelor si ale desenarilor)
+constexpr GLuint kInstanceDataUnit = 2;
+constexpr GLuint kDrawRecordUnit = 3;
+
+//std140: doar mat4 si vec4, ca structurile sa aiba exact layout-ul din GLSL fara padding ascuns
+//trebuie sa ramana identic cu blocul FrameConstants din resources/shaders
+struct FrameConstants {
+    glm::mat4 projection;
+    glm::mat4 view;
+    glm::mat4 lightSpaceMatrix;
+    glm::vec4 viewPos;
+    glm::vec4 dirLightDir;
+    glm::vec4 dirLightColor;
+    glm::vec4 pointLightPos;
+    glm::vec4 pointLightColor;
+    glm::vec4 fogColor;         //w = densitatea
+    glm::vec4 fogParams;        //x = 1 daca ceata e pornita
+    glm::ivec4 drawParams;      //x = primul texel InstanceData al cadrului, y = primul texel DrawRecord
+};
+
+//o instanta, citita cu texelFetch din vederea RGBA32F (kInstanceTexels texeli)
+//normalMatrix e inversa transpusa a lui model, calculata o data pe CPU
+struct InstanceData {
+    glm::mat4 model;
+    glm::mat4 normalMatrix;
+    glm::vec4 quantScale;       //pos = aPos * scale + offset; w = 1 cand normala e octaedrica
+    glm::vec4 quantOffset;
+};
+constexpr int kInstanceTexels = sizeof(InstanceData) / 16;
+
+//o desenare, din vederea RGBA32UI; atributul kDrawIndexAttribute alege inregistrarea
+struct DrawRecord {
+    uint32_t instance;
+    uint32_t materialLayer;     //stratul din array-ul de materiale sau kNoMaterialLayer
+    uint32_t reserved[2];
+};
+//shaderele esantioneaza textura 2D de pe unitatea 0 in locul array-ului (in GLSL int(record.y) < 0)
+constexpr uint32_t kNoMaterialLayer = 0xFFFFFFFFu;
+
+static_assert(sizeof(FrameConstants) == 3 * 64 + 8 * 16, "FrameConstants trebuie sa respecte std140");
+static_assert(sizeof(InstanceData) == 10 * 16, "InstanceData trebuie sa fie din texeli intregi");
+static_assert(sizeof(DrawRecord) == 16, "DrawRecord e un singur texel");
+
+//un singur uniform buffer impartit in kFrames segmente, cate unul pentru fiecare cadru in zbor
+//push() copiaza datele la urmatorul offset aliniat din segmentul curent; desenarea leaga doar offset-ul
+//acelasi buffer e vazut si ca texture buffer (RGBA32F si RGBA32UI) si ca GL_DRAW_INDIRECT_BUFFER
+//inainte de a rescrie un segment se asteapta fence-ul pus la sfarsitul cadrului care l-a folosit
+//cu GL_ARB_buffer_storage buffer-ul ramane mapat permanent; altfel fiecare push e un map nesincronizat
+class UniformRing {
+public:
+    static constexpr int kFrames = 3;
+
+    UniformRing() = default;
+    UniformRing(const UniformRing&) = delete;
+    UniformRing& operator=(const UniformRing&) = delete;
+
+    //segmentul unui cadru tine bytesPerFrame bytes impartiti in cel mult pushesPerFrame push-uri
+    bool init(size_t bytesPerFrame, size_t pushesPerFrame);
+    //inainte sa dispara contextul GL
+    void release();
+
+    void beginFrame();
+    void endFrame();
+
+    uint32_t push(const void* data, size_t size);
+    template <typename T>
+    uint32_t push(const T& value) { return push(&value, sizeof(T)); }
+
+    template <typename T>
+    void bind(GLuint binding, uint32_t offset) const {
+        glBindBufferRange(GL_UNIFORM_BUFFER, binding, buffer, offset, sizeof(T));
+    }
+
+    GLuint id() const { return buffer; }
+    //offset-urile intoarse de push sunt multipli de 16, deci offset / 16 e indexul texelului
+    GLuint floatTexels() const { return floatTexture; }
+    GLuint uintTexels() const { return uintTexture; }
+
+    bool persistent() const { return mapped != nullptr; }
+    //de cate ori a trebuit asteptat GPU-ul pentru un segment
+    uint64_t stalls() const { return stallCount; }
+
+private:
+    GLuint buffer = 0;
+    GLuint floatTexture = 0;
+    GLuint uintTexture = 0;
+    uint8_t* mapped = nullptr;
+    size_t alignment = 256;
+    size_t segmentSize = 0;
+    int segment = 0;
+    size_t head = 0;
+    bool overflowReported = false;
+    GLsync fences[kFrames] = {};
+    uint64_t stallCount = 0;
+};
@@ -0,0 +1,74 @@
+#include "VertexPacking.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+float signNotZero(float v) {
+    return v >= 0.0f ? 1.0f : -1.0f;
+}
+
+uint16_t quantizeUnorm16(float v) {
+    return (uint16_t)std::lround(std::clamp(v, 0.0f, 1.0f) * 65535.0f);
+}
+
+} // namespace
+
+QuantizationBounds computeQuantizationBounds(const ObjVertex* vertices, size_t count) {
+    QuantizationBounds bounds;
+    if (count == 0) return bounds;
+
+    glm::vec3 minPos = vertices[0].pos;
+    glm::vec3 maxPos = vertices[0].pos;
+    for (size_t i = 1; i < count; i++) {
+        minPos = glm::min(minPos, vertices[i].pos);
+        maxPos = glm::max(maxPos, vertices[i].pos);
+    }
+    bounds.offset = minPos;
+    bounds.scale = maxPos - minPos;
+    return bounds;
+}
+
+glm::vec2 octEncode(glm::vec3 n) {
+    float l1 = std::abs(n.x) + std::abs(n.y) + std::abs(n.z);
+    if (l1 == 0.0f) return glm::vec2(0.0f);
+    glm::vec2 p = glm::vec2(n.x, n.y) / l1;
+    //emisfera de jos se pliaza peste colturile patratului
+    if (n.z < 0.0f) {
+        p = glm::vec2((1.0f - std::abs(p.y)) * signNotZero(p.x),
+                      (1.0f - std::abs(p.x)) * signNotZero(p.y));
+    }
+    return p;
+}
+
+glm::vec3 octDecode(glm::vec2 e) {
+    glm::vec3 n(e.x, e.y, 1.0f - std::abs(e.x) - std::abs(e.y));
+    if (n.z < 0.0f) {
+        n.x = (1.0f - std::abs(e.y)) * signNotZero(e.x);
+        n.y = (1.0f - std::abs(e.x)) * signNotZero(e.y);
+    }
+    return glm::normalize(n);
+}
+
+void packVertices(const ObjVertex* vertices, size_t count, const QuantizationBounds& bounds,
+                  std::vector<PackedVertex>& out) {
+    //o axa plata (ex. podeaua) are scale 0 si toate varfurile ajung pe offset
+    glm::vec3 invScale(0.0f);
+    for (int a = 0; a < 3; a++) {
+        if (bounds.scale[a] > 0.0f) invScale[a] = 1.0f / bounds.scale[a];
+    }
+
+    out.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        const ObjVertex& v = vertices[i];
+        PackedVertex& p = out[i];
+        glm::vec3 unit = (v.pos - bounds.offset) * invScale;
+        p.pos[0] = quantizeUnorm16(unit.x);
+        p.pos[1] = quantizeUnorm16(unit.y);
+        p.pos[2] = quantizeUnorm16(unit.z);
+        p.pos[3] = 0;
+        p.normal = glm::packSnorm2x16(octEncode(v.normal));
+        p.uv = glm::packHalf2x16(v.uv);
+    }
+}
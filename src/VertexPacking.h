@@ -0,0 +1,36 @@
+#pragma once
+
+#include "MeshData.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//formatul varfurilor urcate pe GPU, ales pentru fiecare model
+//Float = ObjVertex (32 bytes), Packed = PackedVertex (16 bytes)
+enum class VertexFormat {
+    Float,
+    Packed
+};
+
+//pozitie unorm16 relativa la cutia mesh-ului, normala octaedrica snorm16, uv half
+struct PackedVertex {
+    uint16_t pos[4];    //al patrulea e doar padding
+    uint32_t normal;    //2 x snorm16
+    uint32_t uv;        //2 x half
+};
+static_assert(sizeof(PackedVertex) == 16, "PackedVertex trebuie sa aiba 16 bytes");
+
+//pos = unorm * scale + offset; shaderele primesc valorile ca atribute constante
+struct QuantizationBounds {
+    glm::vec3 scale = glm::vec3(1.0f);
+    glm::vec3 offset = glm::vec3(0.0f);
+};
+
+QuantizationBounds computeQuantizationBounds(const ObjVertex* vertices, size_t count);
+void packVertices(const ObjVertex* vertices, size_t count, const QuantizationBounds& bounds,
+                  std::vector<PackedVertex>& out);
+
+//codare octaedrica a unei normale unitare in [-1, 1]^2
+glm::vec2 octEncode(glm::vec3 n);
+glm::vec3 octDecode(glm::vec2 e);
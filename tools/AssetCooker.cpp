@@ -0,0 +1,265 @@
+//gateste tot ce e in resources/ intr-un singur pack (resources.pack), pe care lab2 il monteaza daca exista:
+//meshcache-urile OBJ-urilor (cu tabela de materiale din MTL), texturile comprimate DDS (si varianta
+//TextureUsage::Material a celor numite in MTL-uri), scenele compilate si shaderele
+//la rulari repetate, intrarile a caror sursa si setari au acelasi hash se copiaza din pack-ul vechi
+//rulare din radacina proiectului:
+//asset_cooker [--root resources] [--out resources.pack] [--max-texture-dimension 2048] [--no-bc7] [--no-lz]
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+#include <tiny_obj_loader.h>
+
+#include "AssetPack.h"
+#include "Hash.h"
+#include "MappedFile.h"
+#include "MeshCache.h"
+#include "MeshCook.h"
+#include "SceneCompiler.h"
+#include "TextureCache.h"
+#include "TextureCook.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+enum class SourceKind {
+    Mesh,
+    Texture,
+    MaterialTexture,
+    Scene,
+    Shader
+};
+
+struct Source {
+    std::string path;
+    SourceKind kind;
+};
+
+struct CookOptions {
+    std::string root = "resources";
+    std::string out = "resources.pack";
+    //trebuie sa fie aceeasi ca maxTextureDimension din main.cpp, altfel numele intrarilor nu se potrivesc
+    int maxTextureDimension = 2048;
+    bool allowBc7 = true;
+    bool lz = true;
+};
+
+static bool parseArgs(int argc, char** argv, CookOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--root" && hasValue) options.root = argv[++i];
+        else if (arg == "--out" && hasValue) options.out = argv[++i];
+        else if (arg == "--max-texture-dimension" && hasValue) options.maxTextureDimension = std::atoi(argv[++i]);
+        else if (arg == "--no-bc7") options.allowBc7 = false;
+        else if (arg == "--no-lz") options.lz = false;
+        else {
+            std::cerr << "Unknown argument: " << arg << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+static std::string lowerExtension(const fs::path& path) {
+    std::string ext = path.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+    return ext;
+}
+
+//texturile difuze din MTL-urile unui OBJ, cu aceleasi cai ca in ObjModel::loadMaterialTexture
+static void collectMaterialTextures(const std::string& objPath, std::vector<std::string>& textures) {
+    std::vector<std::string> files = meshSourceFiles(objPath);
+    std::string baseDir = fs::path(objPath).parent_path().generic_string() + "/";
+    std::error_code ec;
+    for (size_t i = 1; i < files.size(); i++) {
+        std::ifstream in(files[i]);
+        std::map<std::string, int> names;
+        std::vector<tinyobj::material_t> materials;
+        std::string warning, err;
+        tinyobj::LoadMtl(&names, &materials, &in, &warning, &err);
+        for (const auto& material : materials) {
+            if (material.diffuse_texname.empty()) continue;
+            std::string path = packEntryName(baseDir + material.diffuse_texname);
+            if (fs::is_regular_file(path, ec)) textures.push_back(path);
+        }
+    }
+}
+
+static std::vector<Source> collectSources(const std::string& root) {
+    std::vector<Source> sources;
+    std::error_code ec;
+    for (auto it = fs::recursive_directory_iterator(root, ec); !ec && it != fs::recursive_directory_iterator();
+         it.increment(ec)) {
+        if (!it->is_regular_file()) continue;
+        std::string ext = lowerExtension(it->path());
+        std::string path = packEntryName(it->path().generic_string());
+        if (ext == ".obj") sources.push_back({ path, SourceKind::Mesh });
+        else if (ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".tga" || ext == ".bmp")
+            sources.push_back({ path, SourceKind::Texture });
+        else if (ext == ".scene") sources.push_back({ path, SourceKind::Scene });
+        else if (ext == ".vert" || ext == ".frag" || ext == ".geom" || ext == ".glsl")
+            sources.push_back({ path, SourceKind::Shader });
+    }
+    if (ec) std::cerr << "Cannot list " << root << ": " << ec.message() << "\n";
+
+    std::vector<std::string> materialTextures;
+    for (const Source& source : sources) {
+        if (source.kind == SourceKind::Mesh) collectMaterialTextures(source.path, materialTextures);
+    }
+    std::sort(materialTextures.begin(), materialTextures.end());
+    materialTextures.erase(std::unique(materialTextures.begin(), materialTextures.end()), materialTextures.end());
+    for (auto& path : materialTextures) sources.push_back({ std::move(path), SourceKind::MaterialTexture });
+    std::sort(sources.begin(), sources.end(), [](const Source& a, const Source& b) { return a.path < b.path; });
+    return sources;
+}
+
+static std::string entryName(const Source& source, const CookOptions& options) {
+    switch (source.kind) {
+    case SourceKind::Mesh: return meshCachePath(source.path);
+    case SourceKind::Texture: return textureCachePath(source.path, options.maxTextureDimension);
+    case SourceKind::MaterialTexture:
+        return textureCachePath(source.path, options.maxTextureDimension, TextureUsage::Material);
+    case SourceKind::Scene: return sceneCachePath(source.path);
+    case SourceKind::Shader: return source.path;
+    }
+    return source.path;
+}
+
+static bool hashFile(const std::string& path, uint64_t& hash) {
+    MappedFile file;
+    if (!file.open(path)) return false;
+    hash = hashBytes(file.data(), file.size(), hash);
+    return true;
+}
+
+//fisierele citite la gatire; aceleasi liste folosesc si openMeshCache/openTextureCache/readFile la rulare
+static std::vector<std::string> sourceFiles(const Source& source) {
+    //numele texturilor vin din MTL-urile din liniile mtllib, deci intra si ele
+    if (source.kind == SourceKind::Mesh) return meshSourceFiles(source.path);
+    return { source.path };
+}
+
+//hash-ul sursei, pornit din setarile care schimba rezultatul gatirii
+static bool sourceHash(const Source& source, const CookOptions& options, uint64_t& hash) {
+    switch (source.kind) {
+    case SourceKind::Mesh: {
+        hash = hashString("mesh " + std::to_string(kMeshCacheVersion));
+        std::vector<std::string> files = sourceFiles(source);
+        if (files.empty()) return false;
+        for (const auto& file : files) {
+            if (!hashFile(file, hash)) return false;
+        }
+        return true;
+    }
+    case SourceKind::Texture:
+    case SourceKind::MaterialTexture:
+        hash = hashString(std::string(source.kind == SourceKind::Texture ? "texture " : "material texture ") +
+                          std::to_string(kTextureCacheVersion) + " " + std::to_string(options.maxTextureDimension) +
+                          (options.allowBc7 ? " bc7" : ""));
+        return hashFile(source.path, hash);
+    case SourceKind::Scene:
+        hash = hashString("scene " + std::to_string(kSceneCacheVersion));
+        return hashFile(source.path, hash);
+    case SourceKind::Shader:
+        hash = hashString("shader");
+        return hashFile(source.path, hash);
+    }
+    return false;
+}
+
+//rezultatul gatirii e exact fisierul de cache de langa sursa, mapat in file
+static bool cookSource(const Source& source, const CookOptions& options, MappedFile& file) {
+    switch (source.kind) {
+    case SourceKind::Mesh: {
+        //gatim mereu din sursa; meshcache-ul de langa ea se rescrie pe drum
+        std::string baseDir = packEntryName(fs::path(source.path).parent_path().generic_string()) + "/";
+        MeshData mesh;
+        MeshCookStats stats;
+        if (!cookMesh(source.path, baseDir, mesh, stats)) return false;
+        return file.open(meshCachePath(source.path));
+    }
+    case SourceKind::Texture:
+    case SourceKind::MaterialTexture: {
+        TextureUsage usage = source.kind == SourceKind::Texture ? TextureUsage::Color : TextureUsage::Material;
+        TextureLoadOptions textureOptions;
+        textureOptions.compress = true;
+        textureOptions.allowBc7 = options.allowBc7;
+        textureOptions.maxDimension = options.maxTextureDimension;
+        PreparedTexture prepared;
+        if (!prepareTexture(source.path, usage, textureOptions, prepared)) return false;
+        return file.open(textureCachePath(source.path, options.maxTextureDimension, usage));
+    }
+    case SourceKind::Scene:
+        if (!cookScene(source.path)) return false;
+        return file.open(sceneCachePath(source.path));
+    case SourceKind::Shader:
+        return file.open(source.path);
+    }
+    return false;
+}
+
+int main(int argc, char** argv) {
+    CookOptions options;
+    if (!parseArgs(argc, argv, options)) return 1;
+
+    std::vector<Source> sources = collectSources(options.root);
+    if (sources.empty()) {
+        std::cerr << "No sources under " << options.root << "\n";
+        return 1;
+    }
+
+    AssetPack previous;
+    previous.open(options.out);
+    AssetPackWriter writer;
+    if (!writer.begin(options.out)) return 1;
+
+    size_t reused = 0, cooked = 0, failed = 0;
+    uint64_t rawBytes = 0;
+    for (const Source& source : sources) {
+        std::string name = entryName(source, options);
+        uint64_t hash = 0;
+        SourceStamp stamp;
+        if (!sourceHash(source, options, hash) || !stampSources(sourceFiles(source), stamp)) {
+            std::cerr << "Cannot read source: " << source.path << "\n";
+            failed++;
+            continue;
+        }
+
+        const PackEntry* old = previous.isOpen() ? previous.find(name) : nullptr;
+        if (old && old->sourceHash == hash) {
+            if (!writer.addStored(*old, previous.storedData(*old), stamp)) return 1;
+            rawBytes += old->rawSize;
+            reused++;
+            continue;
+        }
+
+        MappedFile file;
+        if (!cookSource(source, options, file)) {
+            std::cerr << "Cannot cook: " << source.path << "\n";
+            failed++;
+            continue;
+        }
+        if (!writer.add(name, file.data(), file.size(), hash, stamp, options.lz)) return 1;
+        std::cout << "Cooked " << name << "\n";
+        rawBytes += file.size();
+        cooked++;
+    }
+    //pe Windows fisierul mapat nu poate fi inlocuit
+    previous.close();
+    if (!writer.finish()) return 1;
+
+    std::error_code ec;
+    uint64_t storedBytes = fs::file_size(options.out, ec);
+    std::cout << options.out << ": " << (reused + cooked) << " entries (" << cooked << " cooked, "
+              << reused << " reused, " << failed << " failed), " << rawBytes / 1024 << " KB -> "
+              << storedBytes / 1024 << " KB\n";
+    return failed ? 1 : 0;
+}